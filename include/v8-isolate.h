@@ -855,6 +855,16 @@ class V8_EXPORT Isolate {
    */
   bool GetHeapCodeAndMetadataStatistics(HeapCodeStatistics* object_statistics);
 
+  /**
+   * Get histograms of garbage collection pause times per collection type and
+   * phase. Recording the histograms does not require tracing, so this is
+   * cheap enough to poll regularly, e.g. for exporting percentiles to a
+   * monitoring system.
+   *
+   * \param gc_statistics The GCStatisticsSnapshot object to fill in.
+   */
+  void GetGCStatistics(GCStatisticsSnapshot* gc_statistics);
+
   /**
    * This API is experimental and may change significantly.
    *
@@ -5,15 +5,26 @@
 #ifndef INCLUDE_V8_JSON_H_
 #define INCLUDE_V8_JSON_H_
 
+#include <stddef.h>
+
+#include <memory>
+
 #include "v8-local-handle.h"  // NOLINT(build/include_directory)
+#include "v8-maybe.h"         // NOLINT(build/include_directory)
 #include "v8config.h"         // NOLINT(build/include_directory)
 
 namespace v8 {
 
 class Context;
+class Isolate;
+class OutputStream;
 class Value;
 class String;
 
+namespace internal {
+class JsonStreamingParser;
+}  // namespace internal
+
 /**
  * A JSON Parser and Stringifier.
  */
@@ -40,6 +51,71 @@ class V8_EXPORT JSON {
   static V8_WARN_UNUSED_RESULT MaybeLocal<String> Stringify(
       Local<Context> context, Local<Value> json_object,
       Local<String> gap = Local<String>());
+
+  /**
+   * Like Stringify(), but writes the result as UTF-8 to |stream| instead of
+   * creating a string, which avoids materializing large results on the heap.
+   * The output is written in chunks of at most stream->GetChunkSize() bytes
+   * while serialization is still in progress, and EndOfStream() is called
+   * once it completed.
+   *
+   * \param json_object The JSON-serializable object to stringify.
+   * \param stream The stream that receives the UTF-8 encoded result.
+   * \return True if the complete result was written. False if |json_object|
+   * is not serializable (Stringify() would return undefined) or the stream
+   * aborted. Nothing if an exception was thrown, in which case some of the
+   * output may already have been written.
+   */
+  static V8_WARN_UNUSED_RESULT Maybe<bool> StringifyToStream(
+      Local<Context> context, Local<Value> json_object, OutputStream* stream,
+      Local<String> gap = Local<String>());
+
+  /**
+   * Parses JSON text that is received in chunks, e.g. from the network,
+   * without requiring the embedder to concatenate the chunks into a single
+   * string first.
+   *
+   * If the top-level value is an array, each element is parsed as soon as it
+   * is complete and its source text is released, so only the text of the
+   * element that is currently incomplete is held in memory. Other top-level
+   * values are buffered until Finish() is called.
+   *
+   * The parser must be used and destroyed on the thread that owns |isolate|.
+   * After Feed() or Finish() failed, or after Finish() succeeded, the parser
+   * must not be used anymore.
+   */
+  class V8_EXPORT StreamingParser final {
+   public:
+    explicit StreamingParser(Isolate* isolate);
+    ~StreamingParser();
+
+    // Prevent copying.
+    StreamingParser(const StreamingParser&) = delete;
+    StreamingParser& operator=(const StreamingParser&) = delete;
+
+    /**
+     * Feeds the next |length| bytes of UTF-8 encoded JSON text. Chunks may be
+     * split at arbitrary byte positions, including inside of tokens and
+     * multi-byte characters.
+     *
+     * \return Nothing if a syntax error was detected, in which case the
+     * SyntaxError is thrown in |context|. Positions in the error message are
+     * relative to the array element that failed to parse.
+     */
+    V8_WARN_UNUSED_RESULT Maybe<void> Feed(Local<Context> context,
+                                           const char* data, size_t length);
+
+    /**
+     * Signals the end of the input.
+     *
+     * \return The parsed value, or an empty handle if the input was not valid
+     * JSON.
+     */
+    V8_WARN_UNUSED_RESULT MaybeLocal<Value> Finish(Local<Context> context);
+
+   private:
+    std::unique_ptr<internal::JsonStreamingParser> impl_;
+  };
 };
 
 }  // namespace v8
@@ -631,7 +631,8 @@ class V8_EXPORT HeapGraphNode {
 class V8_EXPORT HeapSnapshot {
  public:
   enum SerializationFormat {
-    kJSON = 0  // See format description near 'Serialize' method.
+    kJSON = 0,   // See format description near 'Serialize' method.
+    kBinary = 1  // See format description near 'Serialize' method.
   };
 
   /** Returns the root node of the heap graph. */
@@ -681,6 +682,27 @@ class V8_EXPORT HeapSnapshot {
    *
    * Nodes reference strings, other nodes, and edges by their indexes
    * in corresponding arrays.
+   *
+   * The binary format is a more compact encoding of the same data, which
+   * is written without building any strings of its own. It starts with the
+   * bytes "V8HS" and a version byte (currently 1), followed by unsigned
+   * LEB128 varints:
+   *
+   *    node_count, edge_count, sample_count, location_count,
+   *    node_count x (type, name, id_delta, self_size, edge_count,
+   *                  trace_node_id, detachedness),
+   *    edge_count x (type, name_or_index, to_node),
+   *    sample_count x (timestamp_us, last_assigned_id),
+   *    location_count x (node, script_id, line, column),
+   *    string_count, string_count x (byte_length, UTF-8 bytes)
+   *
+   * Fields have the same meaning as in the JSON format, except that nodes
+   * are referenced by their index rather than by their offset in the nodes
+   * array, and id_delta is the zigzag-encoded difference between the node's
+   * id and the previous node's id (or 0 for the first node). Strings are
+   * numbered from 1. Allocation traces are not included.
+   * tools/heap-snapshot-binary-to-json.py converts the binary format to the
+   * JSON format. Chunks written to the stream may contain zero bytes.
    */
   void Serialize(OutputStream* stream,
                  SerializationFormat format = kJSON) const;
@@ -233,6 +233,85 @@ class V8_EXPORT HeapCodeStatistics {
   friend class Isolate;
 };
 
+/**
+ * HDR-style latency histogram of garbage collection pauses. Pauses are
+ * recorded in microseconds. Pauses below 8us get a bucket each; every larger
+ * power-of-two range is split into 8 linear buckets, so the bucket a pause is
+ * counted in is within 12.5% of the pause itself.
+ */
+class V8_EXPORT GCPauseHistogram {
+ public:
+  static constexpr size_t kBucketCount = 256;
+
+  GCPauseHistogram();
+
+  /** Number of recorded pauses. */
+  uint64_t count() const { return count_; }
+  /** Sum of all recorded pauses in microseconds. */
+  int64_t total_microseconds() const { return total_microseconds_; }
+  /** Longest recorded pause in microseconds. */
+  int64_t max_microseconds() const { return max_microseconds_; }
+
+  /** Number of pauses counted in the bucket `index`. */
+  uint64_t bucket_count(size_t index) const { return buckets_[index]; }
+
+  /**
+   * Returns the shortest pause in microseconds that is counted in the bucket
+   * `index`.
+   */
+  static int64_t BucketLowerBoundMicroseconds(size_t index);
+
+  /**
+   * Returns an upper bound in microseconds for the given percentile in
+   * [0, 100], e.g. 99 for the p99 pause. Returns 0 if no pauses were recorded.
+   */
+  int64_t PercentileMicroseconds(double percentile) const;
+
+ private:
+  uint64_t buckets_[kBucketCount];
+  uint64_t count_;
+  int64_t total_microseconds_;
+  int64_t max_microseconds_;
+
+  friend class Isolate;
+};
+
+/**
+ * Pause histograms per garbage collection type and phase, accumulated since
+ * the isolate was created.
+ *
+ * Instances of this class can be passed to v8::Isolate::GetGCStatistics.
+ */
+class V8_EXPORT GCStatisticsSnapshot {
+ public:
+  enum class Phase : uint8_t {
+    /** Scavenger pauses. */
+    kScavenge,
+    /** Minor mark-sweep pauses. */
+    kMinorMarkSweep,
+    /** Atomic pauses of full (mark-compact) garbage collections. */
+    kMarkCompact,
+    /** Marking part of full garbage collection atomic pauses. */
+    kMark,
+    /** Sweeping part of full garbage collection atomic pauses. */
+    kSweep,
+    /** Evacuation part of full garbage collection atomic pauses. */
+    kEvacuate,
+    /** Individual incremental marking steps for full garbage collections. */
+    kIncrementalMarkingStep,
+  };
+  static constexpr size_t kPhaseCount = 7;
+
+  const GCPauseHistogram& histogram(Phase phase) const {
+    return histograms_[static_cast<size_t>(phase)];
+  }
+
+ private:
+  GCPauseHistogram histograms_[kPhaseCount];
+
+  friend class Isolate;
+};
+
 }  // namespace v8
 
 #endif  // INCLUDE_V8_STATISTICS_H_
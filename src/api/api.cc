@@ -66,6 +66,7 @@
 #include "src/handles/persistent-handles.h"
 #include "src/handles/shared-object-conveyor-handles.h"
 #include "src/handles/traced-handles-inl.h"
+#include "src/heap/gc-tracer.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/heap-write-barrier.h"
 #include "src/heap/safepoint.h"
@@ -74,6 +75,7 @@
 #include "src/init/startup-data-util.h"
 #include "src/init/v8.h"
 #include "src/json/json-parser.h"
+#include "src/json/json-streaming-parser.h"
 #include "src/json/json-stringifier.h"
 #include "src/logging/counters-scopes.h"
 #include "src/logging/metrics.h"
@@ -132,6 +134,7 @@
 #include "src/strings/char-predicates-inl.h"
 #include "src/strings/string-hasher.h"
 #include "src/strings/unicode-inl.h"
+#include "src/strings/unicode-simd.h"
 #include "src/tracing/trace-event.h"
 #include "src/utils/detachable-vector.h"
 #include "src/utils/identity-map.h"
@@ -3384,6 +3387,53 @@ MaybeLocal<String> JSON::Stringify(Local<Context> context,
   RETURN_ESCAPED(result);
 }
 
+Maybe<bool> JSON::StringifyToStream(Local<Context> context,
+                                    Local<Value> json_object,
+                                    OutputStream* stream, Local<String> gap) {
+  Utils::ApiCheck(stream != nullptr, "v8::JSON::StringifyToStream",
+                  "Invalid output stream");
+  auto i_isolate = reinterpret_cast<i::Isolate*>(context->GetIsolate());
+  ENTER_V8(i_isolate, context, JSON, StringifyToStream, i::HandleScope);
+  auto object = Utils::OpenHandle(*json_object);
+  i::Handle<i::Object> replacer = i_isolate->factory()->undefined_value();
+  i::Handle<i::String> gap_string = gap.IsEmpty()
+                                        ? i_isolate->factory()->empty_string()
+                                        : Utils::OpenHandle(*gap);
+  Maybe<bool> result = i::JsonStringifyToStream(i_isolate, object, replacer,
+                                                gap_string, stream);
+  has_exception = result.IsNothing();
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(bool);
+  return result;
+}
+
+JSON::StreamingParser::StreamingParser(Isolate* isolate)
+    : impl_(new i::JsonStreamingParser(
+          reinterpret_cast<i::Isolate*>(isolate))) {}
+
+JSON::StreamingParser::~StreamingParser() = default;
+
+Maybe<void> JSON::StreamingParser::Feed(Local<Context> context,
+                                        const char* data, size_t length) {
+  Utils::ApiCheck(impl_->is_active(), "v8::JSON::StreamingParser::Feed",
+                  "Parser has already finished or failed");
+  auto i_isolate = reinterpret_cast<i::Isolate*>(context->GetIsolate());
+  ENTER_V8_NO_SCRIPT(i_isolate, context, JSON_StreamingParser, Feed,
+                     i::HandleScope);
+  has_exception = !impl_->Feed(base::Vector<const char>(data, length));
+  RETURN_ON_FAILED_EXECUTION_PRIMITIVE(void);
+  return JustVoid();
+}
+
+MaybeLocal<Value> JSON::StreamingParser::Finish(Local<Context> context) {
+  Utils::ApiCheck(impl_->is_active(), "v8::JSON::StreamingParser::Finish",
+                  "Parser has already finished or failed");
+  PREPARE_FOR_EXECUTION(context, JSON_StreamingParser, Finish);
+  Local<Value> result;
+  has_exception = !ToLocal<Value>(impl_->Finish(), &result);
+  RETURN_ON_FAILED_EXECUTION(Value);
+  RETURN_ESCAPED(result);
+}
+
 // --- V a l u e   S e r i a l i z a t i o n ---
 
 SharedValueConveyor::SharedValueConveyor(SharedValueConveyor&& other) noexcept
@@ -5901,11 +5951,7 @@ int String::Utf8Length(Isolate* v8_isolate) const {
     }
     utf8_length += length;
   } else {
-    int last_character = unibrow::Utf16::kNoPreviousCharacter;
-    for (uint16_t c : flat.ToUC16Vector()) {
-      utf8_length += unibrow::Utf8::Length(c, last_character);
-      last_character = c;
-    }
+    utf8_length = static_cast<int>(i::Utf8Length(flat.ToUC16Vector()));
   }
   return utf8_length;
 }
@@ -5946,34 +5992,13 @@ static int WriteUtf8Impl(base::Vector<const Char> string, char* write_start,
       if (writable_length <= 0) break;
       up_to = std::min(up_to, read_index + writable_length);
     }
-    // Write the characters to the stream.
-    if (sizeof(Char) == 1) {
-      // Simply memcpy if we only have ASCII characters.
-      uint8_t char_mask = 0;
-      for (int i = read_index; i < up_to; i++) char_mask |= read_start[i];
-      if ((char_mask & 0x80) == 0) {
-        int copy_length = up_to - read_index;
-        memcpy(current_write, read_start + read_index, copy_length);
-        current_write += copy_length;
-        read_index = up_to;
-      } else {
-        for (; read_index < up_to; read_index++) {
-          current_write += unibrow::Utf8::EncodeOneByte(
-              current_write, static_cast<uint8_t>(read_start[read_index]));
-          DCHECK(write_capacity == -1 ||
-                 (current_write - write_start) <= write_capacity);
-        }
-      }
-    } else {
-      for (; read_index < up_to; read_index++) {
-        uint16_t character = read_start[read_index];
-        current_write += unibrow::Utf8::Encode(current_write, character,
-                                               prev_char, replace_invalid_utf8);
-        prev_char = character;
-        DCHECK(write_capacity == -1 ||
-               (current_write - write_start) <= write_capacity);
-      }
-    }
+    // Write the characters to the stream, copying ASCII runs in bulk.
+    current_write = i::EncodeUtf8(
+        base::Vector<const Char>(read_start + read_index, up_to - read_index),
+        current_write, replace_invalid_utf8, &prev_char);
+    read_index = up_to;
+    DCHECK(write_capacity == -1 ||
+           (current_write - write_start) <= write_capacity);
   }
   if (read_index < read_length) {
     DCHECK_NE(-1, write_capacity);
@@ -6623,6 +6648,34 @@ HeapCodeStatistics::HeapCodeStatistics()
       external_script_source_size_(0),
       cpu_profiler_metadata_size_(0) {}
 
+GCPauseHistogram::GCPauseHistogram()
+    : buckets_(), count_(0), total_microseconds_(0), max_microseconds_(0) {}
+
+// static
+int64_t GCPauseHistogram::BucketLowerBoundMicroseconds(size_t index) {
+  Utils::ApiCheck(index < kBucketCount,
+                  "v8::GCPauseHistogram::BucketLowerBoundMicroseconds",
+                  "Bucket index out of range");
+  return i::GCTracer::PauseHistograms::BucketLowerBound(index);
+}
+
+int64_t GCPauseHistogram::PercentileMicroseconds(double percentile) const {
+  if (count_ == 0) return 0;
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  const uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(
+             std::ceil(percentile / 100.0 * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kBucketCount - 1; i++) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return std::min(BucketLowerBoundMicroseconds(i + 1) - 1,
+                      max_microseconds_);
+    }
+  }
+  return max_microseconds_;
+}
+
 bool v8::V8::InitializeICU(const char* icu_data_file) {
   return i::InitializeICU(icu_data_file);
 }
@@ -10239,6 +10292,26 @@ bool Isolate::GetHeapCodeAndMetadataStatistics(
   return true;
 }
 
+void Isolate::GetGCStatistics(GCStatisticsSnapshot* gc_statistics) {
+  i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
+  const i::GCTracer::PauseHistograms& histograms =
+      i_isolate->heap()->tracer()->pause_histograms();
+  for (size_t phase_index = 0; phase_index < GCStatisticsSnapshot::kPhaseCount;
+       phase_index++) {
+    const auto phase = static_cast<GCStatisticsSnapshot::Phase>(phase_index);
+    GCPauseHistogram& histogram = gc_statistics->histograms_[phase_index];
+    // The histograms may be updated concurrently. Derive the count from the
+    // copied buckets so that the snapshot is self-consistent.
+    histogram.count_ = 0;
+    for (size_t i = 0; i < GCPauseHistogram::kBucketCount; i++) {
+      histogram.buckets_[i] = histograms.bucket(phase, i);
+      histogram.count_ += histogram.buckets_[i];
+    }
+    histogram.total_microseconds_ = histograms.total_microseconds(phase);
+    histogram.max_microseconds_ = histograms.max_microseconds(phase);
+  }
+}
+
 bool Isolate::MeasureMemory(std::unique_ptr<MeasureMemoryDelegate> delegate,
                             MeasureMemoryExecution execution) {
   i::Isolate* i_isolate = reinterpret_cast<i::Isolate*>(this);
@@ -11516,10 +11589,16 @@ SnapshotObjectId HeapSnapshot::GetMaxSnapshotJSObjectId() const {
 
 void HeapSnapshot::Serialize(OutputStream* stream,
                              HeapSnapshot::SerializationFormat format) const {
-  Utils::ApiCheck(format == kJSON, "v8::HeapSnapshot::Serialize",
+  Utils::ApiCheck(format == kJSON || format == kBinary,
+                  "v8::HeapSnapshot::Serialize",
                   "Unknown serialization format");
   Utils::ApiCheck(stream->GetChunkSize() > 0, "v8::HeapSnapshot::Serialize",
                   "Invalid stream chunk size");
+  if (format == kBinary) {
+    i::HeapSnapshotBinarySerializer serializer(ToInternal(this));
+    serializer.Serialize(stream);
+    return;
+  }
   i::HeapSnapshotJSONSerializer serializer(ToInternal(this));
   serializer.Serialize(stream);
 }
@@ -207,6 +207,22 @@ bool OS::DiscardSystemPages(void* address, size_t size) {
 // static
 bool OS::SealPages(void* address, size_t size) { return false; }
 
+// static
+OS::HugePageBacking OS::RequestHugePages(void* address, size_t size,
+                                         bool use_explicit_huge_pages) {
+  return HugePageBacking::kNone;
+}
+
+// static
+bool OS::MovePages(void* address, size_t size, void* new_address) {
+  return false;
+}
+
+// static
+bool OS::DiscardSystemPagesLazily(void* address, size_t size) {
+  return false;
+}
+
 // static
 bool OS::HasLazyCommits() {
   // TODO(alph): implement for the platform.
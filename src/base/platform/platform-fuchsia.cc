@@ -323,6 +323,22 @@ bool OS::DecommitPages(void* address, size_t size) {
 // static
 bool OS::SealPages(void* address, size_t size) { return false; }
 
+// static
+OS::HugePageBacking OS::RequestHugePages(void* address, size_t size,
+                                         bool use_explicit_huge_pages) {
+  return HugePageBacking::kNone;
+}
+
+// static
+bool OS::MovePages(void* address, size_t size, void* new_address) {
+  return false;
+}
+
+// static
+bool OS::DiscardSystemPagesLazily(void* address, size_t size) {
+  return false;
+}
+
 // static
 bool OS::CanReserveAddressSpace() { return true; }
 
@@ -635,6 +635,76 @@ bool OS::SealPages(void* address, size_t size) {
 #endif
 }
 
+// static
+OS::HugePageBacking OS::RequestHugePages(void* address, size_t size,
+                                         bool use_explicit_huge_pages) {
+#if V8_OS_LINUX
+#if defined(MAP_HUGETLB)
+  if (use_explicit_huge_pages) {
+    void* result =
+        mmap(address, size, PROT_READ | PROT_WRITE,
+             MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, kMmapFd,
+             kMmapFdOffset);
+    if (result != MAP_FAILED) {
+      CHECK_EQ(result, address);
+      return HugePageBacking::kExplicit;
+    }
+    // A failed MAP_FIXED mapping may already have removed the previous one,
+    // so map regular memory again.
+    result = mmap(address, size, PROT_READ | PROT_WRITE,
+                  MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, kMmapFd,
+                  kMmapFdOffset);
+    CHECK_EQ(result, address);
+  }
+#endif  // defined(MAP_HUGETLB)
+#if defined(MADV_HUGEPAGE)
+  // This is advisory; the kernel backs the range with huge pages as they
+  // become available.
+  if (madvise(address, size, MADV_HUGEPAGE) == 0) {
+    return HugePageBacking::kTransparent;
+  }
+#endif  // defined(MADV_HUGEPAGE)
+#endif  // V8_OS_LINUX
+  return HugePageBacking::kNone;
+}
+
+// static
+bool OS::MovePages(void* address, size_t size, void* new_address) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(new_address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+#if V8_OS_LINUX && defined(MREMAP_DONTUNMAP)
+  // MREMAP_DONTUNMAP (Linux 5.7+) leaves the source range mapped, so no hole
+  // opens up in a surrounding address space reservation.
+  void* result =
+      mremap(address, size, size,
+             MREMAP_MAYMOVE | MREMAP_FIXED | MREMAP_DONTUNMAP, new_address);
+  if (result != MAP_FAILED) {
+    CHECK_EQ(result, new_address);
+    return true;
+  }
+  // mremap() may already have unmapped the target range, so map fresh memory
+  // there.
+  result = mmap(new_address, size, PROT_READ | PROT_WRITE,
+                MAP_FIXED | MAP_PRIVATE | MAP_ANONYMOUS, kMmapFd,
+                kMmapFdOffset);
+  CHECK_EQ(result, new_address);
+#endif  // V8_OS_LINUX && defined(MREMAP_DONTUNMAP)
+  return false;
+}
+
+// static
+bool OS::DiscardSystemPagesLazily(void* address, size_t size) {
+  DCHECK_EQ(0, reinterpret_cast<uintptr_t>(address) % CommitPageSize());
+  DCHECK_EQ(0, size % CommitPageSize());
+#if V8_OS_LINUX
+  // MADV_FREE needs Linux 4.5 or later, older kernels reject it.
+  return madvise(address, size, MADV_FREE) == 0;
+#else
+  return false;
+#endif  // V8_OS_LINUX
+}
+
 // static
 bool OS::CanReserveAddressSpace() { return true; }
 
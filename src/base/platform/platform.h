@@ -358,6 +358,36 @@ class V8_BASE_EXPORT OS {
   // Make part of the process's data memory read-only.
   static void SetDataReadOnly(void* address, size_t size);
 
+  enum class HugePageBacking { kNone, kTransparent, kExplicit };
+
+  // Asks for the committed, read-writable memory in [address, address + size)
+  // to be backed by huge pages. Both |address| and |size| must be aligned to
+  // the huge page size (2 MB). With |use_explicit_huge_pages|, the range is
+  // first replaced with a hugetlbfs mapping, which loses its contents, and
+  // transparent huge pages are requested if no such pages are available.
+  // Returns which kind of huge pages back the range, if any.
+  static HugePageBacking RequestHugePages(void* address, size_t size,
+                                          bool use_explicit_huge_pages);
+
+  // Moves the committed, read-writable pages in [address, address + size) to
+  // |new_address| without copying their contents, replacing the pages that
+  // are mapped there. The source range stays mapped and reads as zeros
+  // afterwards. All arguments must be aligned to the commit page size.
+  // Returns false if the pages could not be moved, in which case the target
+  // range is left read-writable (but not necessarily with its old contents)
+  // and the caller needs to copy the memory instead.
+  V8_WARN_UNUSED_RESULT static bool MovePages(void* address, size_t size,
+                                              void* new_address);
+
+  // Tells the OS that the committed, read-writable pages in
+  // [address, address + size) are unused, like DiscardSystemPages(), but lets
+  // it reclaim them lazily under memory pressure. Until then the pages keep
+  // their contents, and writing to a page cancels the hint for it. Both
+  // arguments must be aligned to the commit page size. Returns false if the
+  // OS does not support lazy discarding, in which case nothing happens.
+  V8_WARN_UNUSED_RESULT static bool DiscardSystemPagesLazily(void* address,
+                                                             size_t size);
+
  private:
   // These classes use the private memory management API below.
   friend class AddressSpaceReservation;
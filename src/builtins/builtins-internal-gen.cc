@@ -13,6 +13,7 @@
 #include "src/codegen/macro-assembler-inl.h"
 #include "src/common/globals.h"
 #include "src/execution/frame-constants.h"
+#include "src/heap/card-table.h"
 #include "src/heap/mutable-page-metadata.h"
 #include "src/ic/accessor-assembler.h"
 #include "src/ic/keyed-store-generic.h"
@@ -153,10 +154,24 @@ class WriteBarrierCodeStubAssembler : public CodeStubAssembler {
     Label slow_path(this), next(this);
     TNode<IntPtrT> chunk = MemoryChunkFromAddress(object);
     TNode<IntPtrT> page = PageMetadataFromMemoryChunk(chunk);
+    TNode<IntPtrT> slot_offset = IntPtrSub(slot, chunk);
+
+    // Pages with a card table (see --old-to-new-card-marking) record the slot
+    // by marking its card.
+    Label no_card_table(this);
+    TNode<IntPtrT> card_table = UncheckedCast<IntPtrT>(
+        Load(MachineType::Pointer(), page,
+             IntPtrConstant(MutablePageMetadata::kCardTableOffset)));
+    GotoIf(WordEqual(card_table, IntPtrConstant(0)), &no_card_table);
+    StoreNoWriteBarrier(MachineRepresentation::kWord8, card_table,
+                        WordShr(slot_offset, CardTable::kCardSizeLog2),
+                        Int32Constant(CardTable::kDirty));
+    Goto(&next);
+
+    BIND(&no_card_table);
 
     // Load address of SlotSet
     TNode<IntPtrT> slot_set = LoadSlotSet(page, &slow_path);
-    TNode<IntPtrT> slot_offset = IntPtrSub(slot, chunk);
 
     // Load bucket
     TNode<IntPtrT> bucket = LoadBucket(slot_set, slot_offset, &slow_path);
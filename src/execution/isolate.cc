@@ -3938,7 +3938,9 @@ class TracingAccountingAllocator : public AccountingAllocator {
     }
     out << "\"allocated\": " << total_segment_bytes_allocated << ", "
         << "\"used\": " << total_zone_allocation_size << ", "
-        << "\"freed\": " << total_zone_freed_size << "}";
+        << "\"freed\": " << total_zone_freed_size << ", "
+        << "\"segment_cache_hits\": " << GetSegmentCacheHits() << ", "
+        << "\"segment_cache_misses\": " << GetSegmentCacheMisses() << "}";
   }
 
   Isolate* const isolate_;
@@ -793,6 +793,11 @@ DEFINE_NEG_NEG_IMPLICATION(allocation_site_tracking,
 // Flags for experimental implementation features.
 DEFINE_BOOL(allocation_site_pretenuring, true,
             "pretenure with allocation sites")
+DEFINE_BOOL(cache_pretenuring_decisions, false,
+            "store tenured literal allocation sites in the code cache and "
+            "tenure them from the start when the cache is consumed")
+DEFINE_NEG_NEG_IMPLICATION(allocation_site_pretenuring,
+                           cache_pretenuring_decisions)
 DEFINE_BOOL(page_promotion, true, "promote pages based on utilization")
 DEFINE_INT(page_promotion_threshold, 70,
            "min percentage of live bytes on a page to enable fast evacuation "
@@ -1990,6 +1995,10 @@ DEFINE_BOOL(incremental_marking_bailout_when_ahead_of_schedule, true,
 DEFINE_BOOL(incremental_marking_task, true, "use tasks for incremental marking")
 DEFINE_BOOL(incremental_marking_start_user_visible, false,
             "Starts incremental marking with kUserVisible priority.")
+DEFINE_BOOL(incremental_client_marking, false,
+            "let client isolates pre-mark shared objects reachable from "
+            "their remembered sets during shared incremental marking; the "
+            "atomic pause still stops all clients")
 DEFINE_INT(incremental_marking_soft_trigger, 0,
            "threshold for starting incremental marking via a task in percent "
            "of available space: limit - size")
@@ -2004,6 +2013,9 @@ DEFINE_UINT(minor_gc_task_trigger, 80,
 DEFINE_BOOL(scavenge_separate_stack_scanning, false,
             "use a separate phase for stack scanning in scavenge")
 DEFINE_BOOL(trace_parallel_scavenge, false, "trace parallel scavenge")
+DEFINE_BOOL(old_to_new_card_marking, false,
+            "record old-to-new slots of large arrays in a card table with "
+            "512 byte cards instead of the slot set")
 DEFINE_EXPERIMENTAL_FEATURE(
     cppgc_young_generation,
     "run young generation garbage collections in Oilpan")
@@ -2025,9 +2037,22 @@ DEFINE_INT(
     "max worker number of concurrent marking, 0 for NumberOfWorkerThreads")
 DEFINE_BOOL(concurrent_array_buffer_sweeping, true,
             "concurrently sweep array buffers")
+DEFINE_BOOL(pool_array_buffer_backing_stores, false,
+            "allocate 64 KB to 1 MB ArrayBuffer backing stores from a "
+            "process-wide pool of zeroed pages instead of the embedder's "
+            "ArrayBuffer::Allocator")
+DEFINE_SIZE_T(array_buffer_pool_resident_size, 16 * MB,
+              "bytes of pooled ArrayBuffer backing stores that stay resident, "
+              "older ones are discarded (lazily with MADV_FREE on Linux)")
+DEFINE_SIZE_T(array_buffer_pool_max_size, 64 * MB,
+              "maximum bytes of freed ArrayBuffer backing stores kept in the "
+              "pool")
 DEFINE_BOOL(stress_concurrent_allocation, false,
             "start background threads that allocate memory")
 DEFINE_BOOL(parallel_marking, true, "use parallel marking in atomic pause")
+DEFINE_INT(marking_prefetch_distance, 0,
+           "number of popped objects that full GC markers prefetch ahead of "
+           "visiting them (0 disables prefetching, at most 32)")
 DEFINE_INT(ephemeron_fixpoint_iterations, 10,
            "number of fixpoint iterations it takes to switch to linear "
            "ephemeron algorithm")
@@ -2063,6 +2088,8 @@ DEFINE_GENERIC_IMPLICATION(
     trace_zone_type_stats,
     TracingFlags::zone_stats.store(
         v8::tracing::TracingCategoryObserver::ENABLED_BY_NATIVE))
+DEFINE_BOOL(zone_segment_cache, true,
+            "cache zone segments per thread for reuse by other zones")
 DEFINE_DEBUG_BOOL(trace_backing_store, false, "trace backing store events")
 DEFINE_INT(gc_stats, 0, "Used by tracing internally to enable gc statistics")
 DEFINE_IMPLICATION(trace_gc_object_stats, track_gc_object_stats)
@@ -2102,11 +2129,24 @@ DEFINE_INT(memory_reducer_gc_count, 2,
 DEFINE_INT(heap_growing_percent, 0,
            "specifies heap growing factor as (1 + heap_growing_percent/100)")
 DEFINE_INT(v8_os_page_size, 0, "override OS page size (in KBytes)")
+DEFINE_BOOL(huge_page_groups, false,
+            "allocate regular heap pages from 2 MB groups that are backed by "
+            "transparent huge pages")
+DEFINE_BOOL(huge_page_groups_hugetlbfs, false,
+            "back huge page groups with hugetlbfs pages if available, and "
+            "fall back to transparent huge pages otherwise")
+DEFINE_IMPLICATION(huge_page_groups_hugetlbfs, huge_page_groups)
 DEFINE_BOOL(allocation_buffer_parking, true, "allocation buffer parking")
 DEFINE_BOOL(compact, true,
             "Perform compaction on full GCs based on V8's default heuristics")
 DEFINE_BOOL(compact_code_space, true,
             "Perform code space compaction on full collections.")
+DEFINE_BOOL(compact_large_objects, false,
+            "Move large objects to lower addresses on full collections, "
+            "remapping their pages instead of copying them where possible")
+DEFINE_BOOL(segregate_small_old_objects, false,
+            "Promote and evacuate small old space objects into separate, "
+            "4 KB bounded linear allocation areas per size class")
 DEFINE_BOOL(compact_on_every_full_gc, false,
             "Perform compaction on every full GC")
 DEFINE_BOOL(compact_with_stack, true,
@@ -2477,6 +2517,8 @@ DEFINE_BOOL(heap_snapshot_on_oom, false,
             "Write a heap snapshot to disk on last-resort GCs")
 DEFINE_INT(heap_snapshot_on_gc, -1,
            "Write a heap snapshot to disk on a certain GC invocation")
+DEFINE_BOOL(heap_snapshot_binary, false,
+            "write heap snapshots to disk in the binary format")
 DEFINE_INT(heap_snapshot_string_limit, 1024,
            "truncate strings to this length in the heap snapshot")
 DEFINE_BOOL(heap_profiler_show_hidden_objects, false,
@@ -2654,6 +2696,11 @@ DEFINE_BOOL(rcs_cpu_time, false,
             "report runtime times in cpu time (the default is wall time)")
 DEFINE_IMPLICATION(rcs_cpu_time, rcs)
 
+// runtime-typedarray.cc
+DEFINE_BOOL(parallel_typed_array_sort, false,
+            "split the sorting of very large typed arrays without a "
+            "comparator over worker threads")
+
 // snapshot-common.cc
 DEFINE_BOOL(verify_snapshot_checksum, DEBUG_BOOL,
             "Verify snapshot checksums when deserializing snapshots. Enable "
@@ -2664,6 +2711,10 @@ DEFINE_BOOL(profile_deserialization, false,
 DEFINE_BOOL(trace_deserialization, false, "Trace the snapshot deserialization.")
 DEFINE_BOOL(serialization_statistics, false,
             "Collect statistics on serialized objects.")
+DEFINE_BOOL(map_read_only_space_from_snapshot, false,
+            "Map the read-only space from the snapshot file instead of "
+            "copying it, if the snapshot was created with "
+            "--page-aligned-read-only-snapshot.")
 // Regexp
 DEFINE_BOOL(regexp_optimization, true, "generate optimized regexp code")
 DEFINE_BOOL(regexp_interpret_all, false, "interpret all regexp code")
@@ -2835,6 +2886,10 @@ DEFINE_STRING(startup_src, nullptr,
               "Write V8 startup as C++ src. (mksnapshot only)")
 DEFINE_STRING(startup_blob, nullptr,
               "Write V8 startup blob file. (mksnapshot only)")
+DEFINE_BOOL(page_aligned_read_only_snapshot, false,
+            "Lay out the read-only space in the startup blob such that it can "
+            "be mapped directly from the file. Requires static roots and an "
+            "uncompressed snapshot. (mksnapshot only)")
 DEFINE_STRING(target_arch, nullptr,
               "The mksnapshot target arch. (mksnapshot only)")
 DEFINE_STRING(target_os, nullptr, "The mksnapshot target os. (mksnapshot only)")
@@ -3236,6 +3291,7 @@ DEFINE_IMPLICATION(single_threaded, single_threaded_gc)
 DEFINE_NEG_IMPLICATION(single_threaded, concurrent_recompilation)
 DEFINE_NEG_IMPLICATION(single_threaded, stress_concurrent_inlining)
 DEFINE_NEG_IMPLICATION(single_threaded, lazy_compile_dispatcher)
+DEFINE_NEG_IMPLICATION(single_threaded, parallel_typed_array_sort)
 DEFINE_NEG_IMPLICATION(single_threaded,
                        parallel_compile_tasks_for_eager_toplevel)
 DEFINE_NEG_IMPLICATION(single_threaded, parallel_compile_tasks_for_lazy)
@@ -0,0 +1,106 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_CARD_TABLE_H_
+#define V8_HEAP_CARD_TABLE_H_
+
+#include <cstdint>
+#include <cstring>
+
+#include "src/base/logging.h"
+#include "src/base/platform/memory.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+// A card table records old-to-new slots with a granularity of kCardSize
+// bytes: the write barrier marks the card of a slot with a single byte store,
+// independent of how often the card was marked before. Cards only tell which
+// ranges of a page need to be rescanned, so they are only used for pages whose
+// object consists of tagged slots only, i.e. for large arrays (see
+// Heap::OldToNewCardTableFor()). The dirty cards are turned into regular
+// OLD_TO_NEW slots at the start of a GC.
+//
+// The card table pointer points directly to the array of cards, such that
+// generated code can mark a card without further indirection.
+class CardTable final {
+ public:
+  static constexpr int kCardSizeLog2 = 9;
+  static constexpr size_t kCardSize = size_t{1} << kCardSizeLog2;
+
+  static constexpr uint8_t kClean = 0;
+  static constexpr uint8_t kDirty = 1;
+
+  static constexpr size_t CardsForSize(size_t size) {
+    return (size + kCardSize - 1) >> kCardSizeLog2;
+  }
+
+  // Allocates a clean card table for a chunk of |size| bytes.
+  static CardTable* Allocate(size_t size) {
+    size_t cards = RoundUp(CardsForSize(size), sizeof(uint64_t));
+    void* allocation = v8::base::AlignedAlloc(cards, sizeof(uint64_t));
+    CHECK(allocation);
+    memset(allocation, kClean, cards);
+    return reinterpret_cast<CardTable*>(allocation);
+  }
+
+  static void Delete(CardTable* card_table) {
+    if (card_table == nullptr) return;
+    v8::base::AlignedFree(card_table);
+  }
+
+  // Marks the card of the slot at |slot_offset| from the chunk start.
+  void Mark(size_t slot_offset) {
+    cards()[slot_offset >> kCardSizeLog2] = kDirty;
+  }
+
+  bool IsDirty(size_t slot_offset) const {
+    return cards()[slot_offset >> kCardSizeLog2] != kClean;
+  }
+
+  // Calls |callback| with the start and end offset of every dirty card of a
+  // chunk of |size| bytes and cleans the card. Clean cards are skipped eight
+  // at a time.
+  template <typename Callback>
+  void IterateAndClear(size_t size, Callback callback) {
+    const size_t cards_count = CardsForSize(size);
+    uint8_t* cards = this->cards();
+    for (size_t i = 0; i < cards_count;) {
+      if (i % sizeof(uint64_t) == 0 && i + sizeof(uint64_t) <= cards_count) {
+        uint64_t word;
+        memcpy(&word, cards + i, sizeof(word));
+        if (word == 0) {
+          i += sizeof(uint64_t);
+          continue;
+        }
+      }
+      if (cards[i] != kClean) {
+        cards[i] = kClean;
+        callback(i << kCardSizeLog2, (i + 1) << kCardSizeLog2);
+      }
+      i++;
+    }
+  }
+
+  bool IsClean(size_t size) const {
+    const size_t cards_count = CardsForSize(size);
+    const uint8_t* cards = this->cards();
+    for (size_t i = 0; i < cards_count; i++) {
+      if (cards[i] != kClean) return false;
+    }
+    return true;
+  }
+
+ private:
+  uint8_t* cards() { return reinterpret_cast<uint8_t*>(this); }
+  const uint8_t* cards() const {
+    return reinterpret_cast<const uint8_t*>(this);
+  }
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_CARD_TABLE_H_
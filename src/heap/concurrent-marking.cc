@@ -304,6 +304,11 @@ void ConcurrentMarking::RunMajor(JobDelegate* delegate,
     }
     PtrComprCageBase cage_base(isolate);
     bool is_per_context_mode = local_marking_worklists.IsPerContextMode();
+    MarkingPrefetchQueue prefetch_queue(
+        is_per_context_mode ? 0 : v8_flags.marking_prefetch_distance);
+    auto pop = [&local_marking_worklists](Tagged<HeapObject>* object) {
+      return local_marking_worklists.Pop(object);
+    };
     bool done = false;
     while (!done) {
       size_t current_marked_bytes = 0;
@@ -311,7 +316,7 @@ void ConcurrentMarking::RunMajor(JobDelegate* delegate,
       while (current_marked_bytes < kBytesUntilInterruptCheck &&
              objects_processed < kObjectsUntilInterruptCheck) {
         Tagged<HeapObject> object;
-        if (!local_marking_worklists.Pop(&object)) {
+        if (!prefetch_queue.Pop(&object, pop)) {
           done = true;
           break;
         }
@@ -370,6 +375,12 @@ void ConcurrentMarking::RunMajor(JobDelegate* delegate,
         break;
       }
     }
+    prefetch_queue.Flush(
+        [&local_marking_worklists](Tagged<HeapObject> object) {
+          local_marking_worklists.Push(object);
+        });
+    heap_->tracer()->AddMarkingPrefetchedObjects(
+        prefetch_queue.prefetched_objects());
 
     if (done) {
       Ephemeron ephemeron;
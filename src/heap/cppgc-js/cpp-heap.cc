@@ -646,14 +646,23 @@ constexpr size_t kIncrementalMarkingCheckInterval = 128 * KB;
 }  // namespace
 
 CppHeap::MarkingType CppHeap::SelectMarkingType() const {
-  // For now, force atomic marking for minor collections.
-  if (*collection_type_ == CollectionType::kMinor) return MarkingType::kAtomic;
-
   if (IsForceGC(current_gc_flags_) && !force_incremental_marking_for_testing_)
     return MarkingType::kAtomic;
 
   const MarkingType marking_type = marking_support();
 
+  if (*collection_type_ == CollectionType::kMinor) {
+    // Minor collections are driven by MinorMS which does not perform
+    // incremental marking steps. Marking thus either runs concurrently
+    // alongside the MinorMS cycle or atomically in its final pause.
+    if (marking_type == MarkingType::kIncrementalAndConcurrent && heap_ &&
+        v8_flags.concurrent_minor_ms_marking &&
+        heap_->minor_mark_sweep_collector()->UseBackgroundThreadsInCycle()) {
+      return MarkingType::kIncrementalAndConcurrent;
+    }
+    return MarkingType::kAtomic;
+  }
+
   // CollectionType is major at this point. Check the surrounding
   // MarkCompactCollector for whether we should rely on background threads in
   // this GC cycle.
@@ -854,10 +863,10 @@ void CppHeap::ReEnableConcurrentMarking() {
 }
 
 void CppHeap::WriteBarrier(void* object) {
-  isolate()
-      ->heap()
-      ->mark_compact_collector()
-      ->local_marking_worklists()
+  // MinorMS only traces through the CppHeap if it supports generational GC, in
+  // which case marking was initialized for the minor collection.
+  if (!collection_type_) return;
+  GetV8MarkingWorklists(isolate_, *collection_type_)
       ->cpp_marking_state()
       ->MarkAndPush(object);
 }
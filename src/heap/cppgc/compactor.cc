@@ -4,12 +4,15 @@
 
 #include "src/heap/cppgc/compactor.h"
 
-#include <map>
+#include <algorithm>
+#include <atomic>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
-#include "include/cppgc/macros.h"
+#include "include/cppgc/platform.h"
 #include "src/heap/cppgc/compaction-worklists.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap-base.h"
@@ -28,10 +31,20 @@ namespace {
 // should be considered.
 static constexpr size_t kFreeListSizeThreshold = 512 * kKB;
 
-// The real worker behind heap compaction, recording references to movable
-// objects ("slots".) When the objects end up being compacted and moved,
-// relocate() will adjust the slots to point to the new location of the
-// object along with handling references for interior pointers.
+// Every compaction task slides objects into its own set of pages. The pages
+// of a space are thus only split up across tasks if each task gets at least
+// this many pages.
+static constexpr size_t kMinPagesPerCompactionTask = 8;
+static constexpr size_t kMaxCompactionTasksPerSpace = 8;
+
+// Compaction speed that is assumed for the pause budget as long as no
+// compaction has been measured.
+static constexpr double kInitialCompactionSpeedInBytesPerMs = 512.0 * kKB;
+
+// Keeps track of references to movable objects ("slots") that are recorded
+// during marking. Compaction tasks only record the new locations of objects
+// that are referenced by slots or that contain slots themselves. The slots
+// are updated on the mutator thread after all objects have been moved.
 //
 // The MovableReferences object is created and maintained for the lifetime
 // of one heap compaction-enhanced GC.
@@ -39,23 +52,32 @@ class MovableReferences final {
   using MovableReference = CompactionWorklists::MovableReference;
 
  public:
-  explicit MovableReferences(HeapBase& heap)
-      : heap_(heap), heap_has_move_listeners_(heap.HasMoveListeners()) {}
+  explicit MovableReferences(HeapBase& heap) : heap_(heap) {}
 
   // Adds a slot for compaction. Filters slots in dead objects.
   void AddOrFilter(MovableReference*);
 
-  // Relocates a backing store |from| -> |to|.
-  void Relocate(Address from, Address to, size_t size_including_header);
+  // Returns whether the new location of |object| must be recorded when it is
+  // moved. Does not modify any state and is safe to call from compaction
+  // tasks.
+  bool NeedsForwarding(MovableReference object) const {
+    return movable_references_.count(object) || slot_holders_.count(object);
+  }
 
-  // Relocates interior slots in a backing store that is moved |from| -> |to|.
-  void RelocateInteriorReferences(Address from, Address to, size_t size);
+  // Records that |object| has been moved to |new_location|.
+  void AddForwarding(MovableReference object, Address new_location) {
+    forwarding_.emplace(object, new_location);
+  }
 
-  // Updates the collection of callbacks from the item pushed the worklist by
-  // marking visitors.
-  void UpdateCallbacks();
+  // Updates slots to point to the new locations of moved objects.
+  void UpdateReferences();
 
  private:
+  Address Forward(Address object) const {
+    auto it = forwarding_.find(object);
+    return it == forwarding_.end() ? object : it->second;
+  }
+
   HeapBase& heap_;
 
   // Map from movable reference (value) to its slot. Upon moving an object its
@@ -63,23 +85,15 @@ class MovableReferences final {
   // have only a single movable reference to them registered.
   std::unordered_map<MovableReference, MovableReference*> movable_references_;
 
-  // Map of interior slots to their final location. Needs to be an ordered map
-  // as it is used to walk through slots starting at a given memory address.
-  // Requires log(n) lookup to make the early bailout reasonably fast.
-  //
-  // - The initial value for a given key is nullptr.
-  // - Upon moving an object this value is adjusted accordingly.
-  std::map<MovableReference*, Address> interior_movable_references_;
-
-  const bool heap_has_move_listeners_;
-
-#if DEBUG
-  // The following two collections are used to allow refer back from a slot to
-  // an already moved object.
-  std::unordered_set<const void*> moved_objects_;
-  std::unordered_map<MovableReference*, MovableReference>
-      interior_slot_to_object_;
-#endif  // DEBUG
+  // Map from slots that reside on compactable pages to the objects containing
+  // them. Such slots move along with the objects containing them.
+  std::unordered_map<MovableReference*, Address> interior_movable_references_;
+  // Objects containing at least one slot of |interior_movable_references_|.
+  std::unordered_set<MovableReference> slot_holders_;
+
+  // Map from moved objects to their new locations. Only contains objects for
+  // which NeedsForwarding() holds.
+  std::unordered_map<MovableReference, Address> forwarding_;
 };
 
 void MovableReferences::AddOrFilter(MovableReference* slot) {
@@ -131,118 +145,191 @@ void MovableReferences::AddOrFilter(MovableReference* slot) {
 
   CHECK_EQ(interior_movable_references_.end(),
            interior_movable_references_.find(slot));
-  interior_movable_references_.emplace(slot, nullptr);
-#if DEBUG
-  interior_slot_to_object_.emplace(slot, slot_header.ObjectStart());
-#endif  // DEBUG
+  interior_movable_references_.emplace(slot, slot_header.ObjectStart());
+  slot_holders_.insert(slot_header.ObjectStart());
 }
 
-void MovableReferences::Relocate(Address from, Address to,
-                                 size_t size_including_header) {
-#if DEBUG
-  moved_objects_.insert(from);
-#endif  // DEBUG
-
-  if (V8_UNLIKELY(heap_has_move_listeners_)) {
-    heap_.CallMoveListeners(from - sizeof(HeapObjectHeader),
-                            to - sizeof(HeapObjectHeader),
-                            size_including_header);
-  }
-
-  // Interior slots always need to be processed for moved objects.
-  // Consider an object A with slot A.x pointing to value B where A is
-  // allocated on a movable page itself. When B is finally moved, it needs to
-  // find the corresponding slot A.x. Object A may be moved already and the
-  // memory may have been freed, which would result in a crash.
-  if (!interior_movable_references_.empty()) {
-    const HeapObjectHeader& header = HeapObjectHeader::FromObject(to);
-    const size_t size = header.ObjectSize();
-    RelocateInteriorReferences(from, to, size);
+void MovableReferences::UpdateReferences() {
+  if (forwarding_.empty()) return;
+
+  // Slots in moved objects have been moved along with them. If such a slot
+  // points into the object containing it, it does not point to a valid
+  // HeapObjectHeader and needs to be fixed up directly.
+  for (const auto& [slot, holder] : interior_movable_references_) {
+    const Address new_holder = Forward(holder);
+    if (new_holder == holder) continue;
+    const size_t size = HeapObjectHeader::FromObject(new_holder).ObjectSize();
+    Address& contents = *reinterpret_cast<Address*>(
+        new_holder + (reinterpret_cast<Address>(slot) - holder));
+    if (contents > holder && contents < (holder + size)) {
+      contents = contents - holder + new_holder;
+    }
   }
 
-  auto it = movable_references_.find(from);
-  // This means that there is no corresponding slot for a live object.
-  // This may happen because a mutator may change the slot to point to a
-  // different object because e.g. incremental marking marked an object
-  // as live that was later on replaced.
-  if (it == movable_references_.end()) {
-    return;
-  }
+  for (const auto& [value, slot] : movable_references_) {
+    auto forwarding_it = forwarding_.find(value);
+    if (forwarding_it == forwarding_.end()) continue;
 
-  // If the object is referenced by a slot that is contained on a compacted
-  // area itself, check whether it can be updated already.
-  MovableReference* slot = it->second;
-  auto interior_it = interior_movable_references_.find(slot);
-  if (interior_it != interior_movable_references_.end()) {
-    MovableReference* slot_location =
-        reinterpret_cast<MovableReference*>(interior_it->second);
-    if (!slot_location) {
-      interior_it->second = to;
-#if DEBUG
-      // Check that the containing object has not been moved yet.
-      auto reverse_it = interior_slot_to_object_.find(slot);
-      DCHECK_NE(interior_slot_to_object_.end(), reverse_it);
-      DCHECK_EQ(moved_objects_.end(), moved_objects_.find(reverse_it->second));
-#endif  // DEBUG
-    } else {
-      slot = slot_location;
+    MovableReference* current_slot = slot;
+    auto interior_it = interior_movable_references_.find(slot);
+    if (interior_it != interior_movable_references_.end()) {
+      const Address holder = interior_it->second;
+      current_slot = reinterpret_cast<MovableReference*>(
+          Forward(holder) + (reinterpret_cast<Address>(slot) - holder));
     }
-  }
 
-  // Compaction is atomic so slot should not be updated during compaction.
-  DCHECK_EQ(from, *slot);
+    // Compaction is atomic so slot should not be updated during compaction.
+    DCHECK_EQ(value, *current_slot);
 
-  // Update the slots new value.
-  *slot = to;
+    // Update the slots new value.
+    *current_slot = forwarding_it->second;
+  }
 }
 
-void MovableReferences::RelocateInteriorReferences(Address from, Address to,
-                                                   size_t size) {
-  // |from| is a valid address for a slot.
-  auto interior_it = interior_movable_references_.lower_bound(
-      reinterpret_cast<MovableReference*>(from));
-  if (interior_it == interior_movable_references_.end()) return;
-  DCHECK_GE(reinterpret_cast<Address>(interior_it->first), from);
-
-  size_t offset = reinterpret_cast<Address>(interior_it->first) - from;
-  while (offset < size) {
-    if (!interior_it->second) {
-      // Update the interior reference value, so that when the object the slot
-      // is pointing to is moved, it can re-use this value.
-      Address reference = to + offset;
-      interior_it->second = reference;
-
-      // If the |slot|'s content is pointing into the region [from, from +
-      // size) we are dealing with an interior pointer that does not point to
-      // a valid HeapObjectHeader. Such references need to be fixed up
-      // immediately.
-      Address& reference_contents = *reinterpret_cast<Address*>(reference);
-      if (reference_contents > from && reference_contents < (from + size)) {
-        reference_contents = reference_contents - from + to;
-      }
-    }
+// Finalizes all dead objects on |page|. Finalizers must run on the mutator
+// thread and before any object is moved, as live objects may be moved over
+// dead ones. Headers of dead objects are kept intact so that compaction tasks
+// can still iterate the page.
+void FinalizeDeadObjects(NormalPage* page) {
+  for (Address header_address = page->PayloadStart();
+       header_address < page->PayloadEnd();) {
+    HeapObjectHeader* header =
+        reinterpret_cast<HeapObjectHeader*>(header_address);
+    const size_t size = header->AllocatedSize();
+    DCHECK_GT(size, 0u);
+    DCHECK_LT(size, kPageSize);
 
-    interior_it++;
-    if (interior_it == interior_movable_references_.end()) return;
-    offset = reinterpret_cast<Address>(interior_it->first) - from;
+    if (!header->IsFree() && !header->IsMarked()) {
+      header->Finalize();
+      // As compaction is under way, leave the freed memory accessible
+      // while compacting the rest of the page. We just zap the payload
+      // to catch out other finalizers trying to access it.
+#if DEBUG || defined(V8_USE_MEMORY_SANITIZER) || \
+    defined(V8_USE_ADDRESS_SANITIZER)
+      ZapMemory(header->ObjectStart(), size - sizeof(HeapObjectHeader));
+#endif
+    }
+    header_address += size;
   }
 }
 
+// Compacts a set of pages of a single space. Compaction is performed in-place,
+// sliding live objects down over unused holes of the pages in the order the
+// pages were added. Objects never leave the set of pages, so that several
+// CompactionStates can be processed in parallel by compaction tasks. Updates
+// of the space, its free list, and the page backend are deferred to Finish()
+// which runs on the mutator thread.
+//
+// Live objects stay marked. The sweeper processes compacted pages like all
+// other pages, which allows for compacting only a subset of a space's pages.
 class CompactionState final {
-  CPPGC_STACK_ALLOCATED();
   using Pages = std::vector<NormalPage*>;
 
  public:
-  CompactionState(NormalPageSpace* space, MovableReferences& movable_references)
-      : space_(space), movable_references_(movable_references) {}
+  CompactionState(NormalPageSpace* space,
+                  const MovableReferences& movable_references,
+                  bool record_all_moves)
+      : space_(space),
+        movable_references_(movable_references),
+        record_all_moves_(record_all_moves) {}
 
   void AddPage(NormalPage* page) {
     DCHECK_EQ(space_, &page->space());
+    pages_.push_back(page);
+  }
+
+  // Moves all live objects. May be called from a compaction task.
+  void Compact() {
+    for (NormalPage* page : pages_) {
+      CompactPage(page);
+    }
+    // If the current page hasn't been allocated into, add it to the available
+    // list, for subsequent release in Finish().
+    if (used_bytes_in_current_page_ == 0) {
+      available_pages_.push_back(current_page_);
+    } else {
+      CloseCurrentPage();
+    }
+  }
+
+  // Returns pages to the space and the backend and reports moved objects.
+  // Must be called on the mutator thread after Compact().
+  void Finish(HeapBase& heap, MovableReferences& movable_references) {
+    for (const auto& [page, used_bytes] : compacted_pages_) {
+      space_->AddPage(page);
+      page->ResetMarkedBytes(used_bytes);
+      if (used_bytes != page->PayloadSize()) {
+        // Put the remainder of the page onto the free list.
+        space_->free_list().Add({page->PayloadStart() + used_bytes,
+                                 page->PayloadSize() - used_bytes});
+      }
+    }
+
+    for (const Move& move : moves_) {
+      if (V8_UNLIKELY(record_all_moves_)) {
+        heap.CallMoveListeners(move.from, move.to, move.size);
+      }
+      const Address object = move.from + sizeof(HeapObjectHeader);
+      if (movable_references.NeedsForwarding(object)) {
+        movable_references.AddForwarding(object,
+                                         move.to + sizeof(HeapObjectHeader));
+      }
+    }
+
+    // Return remaining available pages back to the backend.
+    for (NormalPage* page : available_pages_) {
+      SetMemoryInaccessible(page->PayloadStart(), page->PayloadSize());
+      NormalPage::Destroy(page, FreeMemoryHandling::kDiscardWherePossible);
+    }
+  }
+
+ private:
+  // Object that was moved, referring to its header.
+  struct Move {
+    Address from;
+    Address to;
+    size_t size;
+  };
+
+  void CompactPage(NormalPage* page) {
     // If not the first page, add |page| onto the available pages chain.
     if (!current_page_)
       current_page_ = page;
     else
       available_pages_.push_back(page);
+
+    page->object_start_bitmap().Clear();
+
+    for (Address header_address = page->PayloadStart();
+         header_address < page->PayloadEnd();) {
+      HeapObjectHeader* header =
+          reinterpret_cast<HeapObjectHeader*>(header_address);
+      const size_t size = header->AllocatedSize();
+      DCHECK_GT(size, 0u);
+      DCHECK_LT(size, kPageSize);
+
+      if (header->IsFree()) {
+        // Unpoison the freelist entry so that we can compact into it as
+        // wanted.
+        ASAN_UNPOISON_MEMORY_REGION(header_address, size);
+        header_address += size;
+        continue;
+      }
+
+      // Dead objects have already been finalized by FinalizeDeadObjects().
+      if (!header->IsMarked()) {
+        header_address += size;
+        continue;
+      }
+
+      // Potentially unpoison the live object as well as it is the source of
+      // the copy.
+      ASAN_UNPOISON_MEMORY_REGION(header->ObjectStart(), header->ObjectSize());
+      RelocateObject(page, header_address, size);
+      header_address += size;
+    }
+
+    FinishCompactingPage(page);
   }
 
   void RelocateObject(const NormalPage* page, const Address header,
@@ -251,9 +338,9 @@ class CompactionState final {
     Address compact_frontier =
         current_page_->PayloadStart() + used_bytes_in_current_page_;
     if (compact_frontier + size > current_page_->PayloadEnd()) {
-      // Can't fit on current page. Add remaining onto the freelist and advance
-      // to next available page.
-      ReturnCurrentPageToSpace();
+      // Can't fit on current page. Close it and advance to the next available
+      // page.
+      CloseCurrentPage();
 
       current_page_ = available_pages_.back();
       available_pages_.pop_back();
@@ -266,31 +353,17 @@ class CompactionState final {
         memmove(compact_frontier, header, size);
       else
         memcpy(compact_frontier, header, size);
-      movable_references_.Relocate(header + sizeof(HeapObjectHeader),
-                                   compact_frontier + sizeof(HeapObjectHeader),
-                                   size);
+      if (V8_UNLIKELY(record_all_moves_) ||
+          movable_references_.NeedsForwarding(header +
+                                              sizeof(HeapObjectHeader))) {
+        moves_.push_back({header, compact_frontier, size});
+      }
     }
     current_page_->object_start_bitmap().SetBit(compact_frontier);
     used_bytes_in_current_page_ += size;
     DCHECK_LE(used_bytes_in_current_page_, current_page_->PayloadSize());
   }
 
-  void FinishCompactingSpace() {
-    // If the current page hasn't been allocated into, add it to the available
-    // list, for subsequent release below.
-    if (used_bytes_in_current_page_ == 0) {
-      available_pages_.push_back(current_page_);
-    } else {
-      ReturnCurrentPageToSpace();
-    }
-
-    // Return remaining available pages back to the backend.
-    for (NormalPage* page : available_pages_) {
-      SetMemoryInaccessible(page->PayloadStart(), page->PayloadSize());
-      NormalPage::Destroy(page, FreeMemoryHandling::kDiscardWherePossible);
-    }
-  }
-
   void FinishCompactingPage(NormalPage* page) {
 #if DEBUG || defined(V8_USE_MEMORY_SANITIZER) || \
     defined(V8_USE_ADDRESS_SANITIZER)
@@ -305,138 +378,103 @@ class CompactionState final {
     page->object_start_bitmap().MarkAsFullyPopulated();
   }
 
- private:
-  void ReturnCurrentPageToSpace() {
-    DCHECK_EQ(space_, &current_page_->space());
-    space_->AddPage(current_page_);
+  void CloseCurrentPage() {
+    compacted_pages_.emplace_back(current_page_, used_bytes_in_current_page_);
     if (used_bytes_in_current_page_ != current_page_->PayloadSize()) {
-      // Put the remainder of the page onto the free list.
-      size_t freed_size =
-          current_page_->PayloadSize() - used_bytes_in_current_page_;
-      Address payload = current_page_->PayloadStart();
-      Address free_start = payload + used_bytes_in_current_page_;
-      SetMemoryInaccessible(free_start, freed_size);
-      space_->free_list().Add({free_start, freed_size});
+      // The remainder of the page is put onto the free list in Finish().
+      Address free_start =
+          current_page_->PayloadStart() + used_bytes_in_current_page_;
+      SetMemoryInaccessible(free_start, current_page_->PayloadSize() -
+                                            used_bytes_in_current_page_);
       current_page_->object_start_bitmap().SetBit(free_start);
     }
   }
 
   NormalPageSpace* space_;
-  MovableReferences& movable_references_;
+  const MovableReferences& movable_references_;
+  const bool record_all_moves_;
+  // Pages to compact.
+  Pages pages_;
   // Page into which compacted object will be written to.
   NormalPage* current_page_ = nullptr;
   // Offset into |current_page_| to the next free address.
   size_t used_bytes_in_current_page_ = 0;
-  // Additional pages in the current space that can be used as compaction
-  // targets. Pages that remain available at the compaction can be released.
+  // Additional pages that can be used as compaction targets. Pages that
+  // remain available at the end of compaction can be released.
   Pages available_pages_;
+  // Pages that have been compacted into, along with their used bytes.
+  std::vector<std::pair<NormalPage*, size_t>> compacted_pages_;
+  // Moved objects that need to be reported in Finish().
+  std::vector<Move> moves_;
 };
 
-void CompactPage(NormalPage* page, CompactionState& compaction_state,
-                 StickyBits sticky_bits) {
-  compaction_state.AddPage(page);
+class CompactionJobTask final : public cppgc::JobTask {
+ public:
+  CompactionJobTask(HeapBase& heap, std::vector<CompactionState>& states)
+      : heap_(heap), states_(states) {}
+
+  void Run(cppgc::JobDelegate*) final {
+    StatsCollector::EnabledConcurrentScope stats_scope(
+        heap_.stats_collector(), StatsCollector::kConcurrentCompact);
+    for (size_t index = next_state_.fetch_add(1, std::memory_order_relaxed);
+         index < states_.size();
+         index = next_state_.fetch_add(1, std::memory_order_relaxed)) {
+      states_[index].Compact();
+    }
+  }
 
-  page->object_start_bitmap().Clear();
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    const size_t next_state = next_state_.load(std::memory_order_relaxed);
+    const size_t remaining_states =
+        next_state < states_.size() ? states_.size() - next_state : 0;
+    return std::min(states_.size(), remaining_states + worker_count);
+  }
 
-  for (Address header_address = page->PayloadStart();
-       header_address < page->PayloadEnd();) {
-    HeapObjectHeader* header =
-        reinterpret_cast<HeapObjectHeader*>(header_address);
-    size_t size = header->AllocatedSize();
-    DCHECK_GT(size, 0u);
-    DCHECK_LT(size, kPageSize);
+ private:
+  HeapBase& heap_;
+  std::vector<CompactionState>& states_;
+  std::atomic<size_t> next_state_{0};
+};
 
-    if (header->IsFree()) {
-      // Unpoison the freelist entry so that we can compact into it as wanted.
-      ASAN_UNPOISON_MEMORY_REGION(header_address, size);
-      header_address += size;
-      continue;
+// Removes the most fragmented pages, i.e., the pages with the fewest live
+// bytes, from |spaces| such that their live bytes do not exceed
+// |budget_in_bytes|. Pages without live objects are always removed. Returns
+// the live bytes on the removed pages.
+size_t RemovePagesForCompaction(
+    const std::vector<NormalPageSpace*>& spaces, double budget_in_bytes,
+    std::vector<std::vector<NormalPage*>>& pages_per_space) {
+  std::vector<std::pair<NormalPage*, size_t>> candidates;
+  for (size_t i = 0; i < spaces.size(); ++i) {
+    for (BasePage* page : *spaces[i]) {
+      candidates.emplace_back(NormalPage::From(page), i);
     }
-
-    if (!header->IsMarked()) {
-      // Compaction is currently launched only from AtomicPhaseEpilogue, so it's
-      // guaranteed to be on the mutator thread - no need to postpone
-      // finalization.
-      header->Finalize();
-
-      // As compaction is under way, leave the freed memory accessible
-      // while compacting the rest of the page. We just zap the payload
-      // to catch out other finalizers trying to access it.
-#if DEBUG || defined(V8_USE_MEMORY_SANITIZER) || \
-    defined(V8_USE_ADDRESS_SANITIZER)
-      ZapMemory(header, size);
-#endif
-      header_address += size;
-      continue;
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const auto& a, const auto& b) {
+                     return a.first->marked_bytes() < b.first->marked_bytes();
+                   });
+
+  pages_per_space.resize(spaces.size());
+  std::unordered_set<const BasePage*> selected_pages;
+  size_t live_bytes = 0;
+  for (const auto& [page, space_index] : candidates) {
+    const size_t page_live_bytes = page->marked_bytes();
+    if (page_live_bytes &&
+        static_cast<double>(live_bytes + page_live_bytes) > budget_in_bytes) {
+      break;
     }
-
-    // Object is marked.
-#if defined(CPPGC_YOUNG_GENERATION)
-    if (sticky_bits == StickyBits::kDisabled) header->Unmark();
-#else   // !defined(CPPGC_YOUNG_GENERATION)
-    header->Unmark();
-#endif  // !defined(CPPGC_YOUNG_GENERATION)
-
-    // Potentially unpoison the live object as well as it is the source of
-    // the copy.
-    ASAN_UNPOISON_MEMORY_REGION(header->ObjectStart(), header->ObjectSize());
-    compaction_state.RelocateObject(page, header_address, size);
-    header_address += size;
+    live_bytes += page_live_bytes;
+    pages_per_space[space_index].push_back(page);
+    selected_pages.insert(page);
   }
 
-  compaction_state.FinishCompactingPage(page);
-}
-
-void CompactSpace(NormalPageSpace* space, MovableReferences& movable_references,
-                  StickyBits sticky_bits) {
-  using Pages = NormalPageSpace::Pages;
-
-#ifdef V8_USE_ADDRESS_SANITIZER
-  UnmarkedObjectsPoisoner().Traverse(*space);
-#endif  // V8_USE_ADDRESS_SANITIZER
-
-  DCHECK(space->is_compactable());
-
-  space->free_list().Clear();
-
-  // Compaction generally follows Jonker's algorithm for fast garbage
-  // compaction. Compaction is performed in-place, sliding objects down over
-  // unused holes for a smaller heap page footprint and improved locality. A
-  // "compaction pointer" is consequently kept, pointing to the next available
-  // address to move objects down to. It will belong to one of the already
-  // compacted pages for this space, but as compaction proceeds, it will not
-  // belong to the same page as the one being currently compacted.
-  //
-  // The compaction pointer is represented by the
-  // |(current_page_, used_bytes_in_current_page_)| pair, with
-  // |used_bytes_in_current_page_| being the offset into |current_page_|, making
-  // up the next available location. When the compaction of an arena page causes
-  // the compaction pointer to exhaust the current page it is compacting into,
-  // page compaction will advance the current page of the compaction
-  // pointer, as well as the allocation point.
-  //
-  // By construction, the page compaction can be performed without having
-  // to allocate any new pages. So to arrange for the page compaction's
-  // supply of freed, available pages, we chain them together after each
-  // has been "compacted from". The page compaction will then reuse those
-  // as needed, and once finished, the chained, available pages can be
-  // released back to the OS.
-  //
-  // To ease the passing of the compaction state when iterating over an
-  // arena's pages, package it up into a |CompactionState|.
-
-  Pages pages = space->RemoveAllPages();
-  if (pages.empty()) return;
-
-  CompactionState compaction_state(space, movable_references);
-  for (BasePage* page : pages) {
-    page->ResetMarkedBytes();
-    // Large objects do not belong to this arena.
-    CompactPage(NormalPage::From(page), compaction_state, sticky_bits);
+  for (size_t i = 0; i < spaces.size(); ++i) {
+    if (pages_per_space[i].empty()) continue;
+    for (BasePage* page : spaces[i]->RemoveAllPages()) {
+      if (!selected_pages.count(page)) spaces[i]->AddPage(page);
+    }
   }
-
-  compaction_state.FinishCompactingSpace();
-  // Sweeping will verify object start bitmap of compacted space.
+  return live_bytes;
 }
 
 size_t UpdateHeapResidency(const std::vector<NormalPageSpace*>& spaces) {
@@ -508,7 +546,8 @@ Compactor::CompactableSpaceHandling Compactor::CompactSpacesIfEnabled() {
   StatsCollector::EnabledScope stats_scope(heap_.heap()->stats_collector(),
                                            StatsCollector::kAtomicCompact);
 
-  MovableReferences movable_references(*heap_.heap());
+  HeapBase& heap = *heap_.heap();
+  MovableReferences movable_references(heap);
 
   CompactionWorklists::MovableReferencesWorklist::Local local(
       *compaction_worklists_->movable_slots_worklist());
@@ -518,15 +557,78 @@ Compactor::CompactableSpaceHandling Compactor::CompactSpacesIfEnabled() {
   }
   compaction_worklists_.reset();
 
-  const StickyBits sticky_bits = heap_.heap()->sticky_bits();
-
+#ifdef V8_USE_ADDRESS_SANITIZER
   for (NormalPageSpace* space : compactable_spaces_) {
-    CompactSpace(space, movable_references, sticky_bits);
+    UnmarkedObjectsPoisoner().Traverse(*space);
+  }
+#endif  // V8_USE_ADDRESS_SANITIZER
+
+  const double compaction_speed_in_bytes_per_ms =
+      compaction_speed_in_bytes_per_ms_ ? compaction_speed_in_bytes_per_ms_
+                                        : kInitialCompactionSpeedInBytesPerMs;
+  std::vector<std::vector<NormalPage*>> pages_per_space;
+  const size_t compacted_bytes = RemovePagesForCompaction(
+      compactable_spaces_,
+      pause_budget_.InMillisecondsF() * compaction_speed_in_bytes_per_ms,
+      pages_per_space);
+
+  // Pages of a space are distributed round-robin across the space's
+  // compaction states. As pages are sorted by live bytes, each state starts
+  // compacting into its emptiest page.
+  std::vector<CompactionState> states;
+  const bool record_all_moves = heap.HasMoveListeners();
+  for (size_t i = 0; i < compactable_spaces_.size(); ++i) {
+    const std::vector<NormalPage*>& pages = pages_per_space[i];
+    if (pages.empty()) continue;
+    const size_t num_states =
+        std::clamp(pages.size() / kMinPagesPerCompactionTask, size_t{1},
+                   kMaxCompactionTasksPerSpace);
+    const size_t first_state = states.size();
+    for (size_t j = 0; j < num_states; ++j) {
+      states.emplace_back(compactable_spaces_[i], movable_references,
+                          record_all_moves);
+    }
+    for (size_t j = 0; j < pages.size(); ++j) {
+      NormalPage* page = pages[j];
+      FinalizeDeadObjects(page);
+      states[first_state + j % num_states].AddPage(page);
+    }
+  }
+
+  // Only moving objects is timed, as slot filtering above and reference
+  // updates below don't depend on the number of compacted bytes.
+  const v8::base::TimeTicks start = v8::base::TimeTicks::Now();
+  std::unique_ptr<cppgc::JobHandle> job_handle;
+  if (states.size() > 1 &&
+      heap.marking_support() ==
+          cppgc::Heap::MarkingType::kIncrementalAndConcurrent) {
+    job_handle = heap.platform()->PostJob(
+        cppgc::TaskPriority::kUserBlocking,
+        std::make_unique<CompactionJobTask>(heap, states));
+  }
+  if (job_handle) {
+    job_handle->Join();
+  } else {
+    for (CompactionState& state : states) {
+      state.Compact();
+    }
+  }
+  const double elapsed_ms =
+      (v8::base::TimeTicks::Now() - start).InMillisecondsF();
+  if (compacted_bytes && elapsed_ms > 0) {
+    compaction_speed_in_bytes_per_ms_ = compacted_bytes / elapsed_ms;
+  }
+
+  for (CompactionState& state : states) {
+    state.Finish(heap, movable_references);
   }
+  movable_references.UpdateReferences();
 
   enable_for_next_gc_for_testing_ = false;
   is_enabled_ = false;
-  return CompactableSpaceHandling::kIgnore;
+  // Compacted objects remain marked, so that compacted pages and pages that
+  // were not selected for compaction are both processed by the sweeper.
+  return CompactableSpaceHandling::kSweep;
 }
 
 void Compactor::EnableForNextGCForTesting() {
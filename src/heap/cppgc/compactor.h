@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_CPPGC_COMPACTOR_H_
 #define V8_HEAP_CPPGC_COMPACTOR_H_
 
+#include "src/base/platform/time.h"
 #include "src/heap/cppgc/compaction-worklists.h"
 #include "src/heap/cppgc/garbage-collector.h"
 #include "src/heap/cppgc/raw-heap.h"
@@ -18,6 +19,10 @@ class V8_EXPORT_PRIVATE Compactor final {
   using CompactableSpaceHandling = SweepingConfig::CompactableSpaceHandling;
 
  public:
+  // Default upper bound for the time spent compacting in the atomic pause.
+  static constexpr v8::base::TimeDelta kDefaultPauseBudget =
+      v8::base::TimeDelta::FromMilliseconds(5);
+
   explicit Compactor(RawHeap&);
   ~Compactor() { DCHECK(!is_enabled_); }
 
@@ -26,10 +31,19 @@ class V8_EXPORT_PRIVATE Compactor final {
 
   void InitializeIfShouldCompact(GCConfig::MarkingType, StackState);
   void CancelIfShouldNotCompact(GCConfig::MarkingType, StackState);
-  // Returns whether spaces need to be processed by the Sweeper after
-  // compaction.
+  // Compacts the most fragmented pages of all compactable spaces, in parallel
+  // if the platform supports jobs. Returns whether spaces need to be
+  // processed by the Sweeper after compaction.
   CompactableSpaceHandling CompactSpacesIfEnabled();
 
+  // Only pages whose live bytes are estimated to be movable within |budget|,
+  // based on the speed of previous compactions, are compacted. Pages without
+  // live objects are always compacted. The budget only covers moving objects;
+  // filtering recorded slots and updating references to moved objects take
+  // additional time that depends on the number of slots.
+  void set_pause_budget(v8::base::TimeDelta budget) { pause_budget_ = budget; }
+  v8::base::TimeDelta pause_budget() const { return pause_budget_; }
+
   CompactionWorklists* compaction_worklists() {
     return compaction_worklists_.get();
   }
@@ -46,6 +60,11 @@ class V8_EXPORT_PRIVATE Compactor final {
 
   std::unique_ptr<CompactionWorklists> compaction_worklists_;
 
+  v8::base::TimeDelta pause_budget_ = kDefaultPauseBudget;
+  // Speed at which the last compaction moved objects, or 0 if no pages were
+  // compacted yet.
+  double compaction_speed_in_bytes_per_ms_ = 0;
+
   bool is_enabled_ = false;
   bool is_cancelled_ = false;
   bool enable_for_next_gc_for_testing_ = false;
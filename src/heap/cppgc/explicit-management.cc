@@ -34,6 +34,10 @@ void ExplicitManagementImpl::FreeUnreferencedObject(HeapHandle& heap_handle,
     return;
   }
 
+  // Free lists may be shared with thread-local allocators.
+  MutatorSafepoint::AllocationMutexGuard guard(
+      HeapBase::From(heap_handle).mutator_safepoint());
+
   auto& header = HeapObjectHeader::FromObject(object);
   header.Finalize();
 
@@ -174,6 +178,10 @@ bool ExplicitManagementImpl::Resize(void* object, size_t new_object_size) {
     return false;
   }
 
+  // Free lists may be shared with thread-local allocators.
+  MutatorSafepoint::AllocationMutexGuard guard(
+      base_page->heap().mutator_safepoint());
+
   const size_t new_size = RoundUp<kAllocationGranularity>(
       sizeof(HeapObjectHeader) + new_object_size);
   auto& header = HeapObjectHeader::FromObject(object);
@@ -4,6 +4,7 @@
 
 #include "src/heap/cppgc/heap-base.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "include/cppgc/heap-consistency.h"
@@ -96,6 +97,93 @@ class AgeTableResetter final : protected HeapVisitor<AgeTableResetter> {
 
 }  // namespace
 
+MutatorSafepoint::Scope::Scope(HeapBase& heap)
+    : safepoint_(heap.mutator_safepoint()) {
+  safepoint_.Enter();
+}
+
+MutatorSafepoint::Scope::~Scope() { safepoint_.Leave(); }
+
+MutatorSafepoint::~MutatorSafepoint() {
+  DCHECK(allocators_.empty());
+  DCHECK_EQ(0u, running_);
+}
+
+void MutatorSafepoint::Register(ThreadLocalAllocator* allocator) {
+  v8::base::MutexGuard guard(&mutex_);
+  allocators_.push_back(allocator);
+  has_thread_local_allocators_.store(true, std::memory_order_relaxed);
+}
+
+void MutatorSafepoint::Unregister(ThreadLocalAllocator* allocator) {
+  v8::base::MutexGuard guard(&mutex_);
+  auto it = std::find(allocators_.begin(), allocators_.end(), allocator);
+  DCHECK_NE(allocators_.end(), it);
+  allocators_.erase(it);
+  has_thread_local_allocators_.store(!allocators_.empty(),
+                                     std::memory_order_relaxed);
+}
+
+void MutatorSafepoint::Park() {
+  v8::base::MutexGuard guard(&mutex_);
+  DCHECK_LT(0u, running_);
+  running_--;
+  if (requested_.load(std::memory_order_relaxed)) cv_.NotifyAll();
+}
+
+void MutatorSafepoint::Unpark() {
+  v8::base::MutexGuard guard(&mutex_);
+  while (requested_.load(std::memory_order_relaxed)) cv_.Wait(&mutex_);
+  running_++;
+}
+
+void MutatorSafepoint::Safepoint() {
+  if (V8_LIKELY(!requested_.load(std::memory_order_relaxed))) return;
+  Park();
+  Unpark();
+}
+
+void MutatorSafepoint::LockAllocationMutexForThreadLocalAllocator() {
+  // The heap's thread may hold the allocation mutex while it enters a
+  // safepoint, e.g., when its own allocation triggers a garbage collection.
+  Park();
+  while (true) {
+    allocation_mutex_.Lock();
+    {
+      v8::base::MutexGuard guard(&mutex_);
+      if (!requested_.load(std::memory_order_relaxed)) {
+        running_++;
+        return;
+      }
+    }
+    // Don't hold the mutex while the safepoint is active, as the heap's thread
+    // may need it, e.g., for allocating in pre-finalizers.
+    allocation_mutex_.Unlock();
+    v8::base::MutexGuard guard(&mutex_);
+    while (requested_.load(std::memory_order_relaxed)) cv_.Wait(&mutex_);
+  }
+}
+
+void MutatorSafepoint::Enter() {
+  if (active_scopes_++ > 0) return;
+  v8::base::MutexGuard guard(&mutex_);
+  requested_.store(true, std::memory_order_relaxed);
+  while (running_ > 0) cv_.Wait(&mutex_);
+  // All thread-local allocators are parked. Return their buffers so that the
+  // heap can be iterated.
+  for (ThreadLocalAllocator* allocator : allocators_) {
+    allocator->ResetLinearAllocationBuffers();
+  }
+}
+
+void MutatorSafepoint::Leave() {
+  DCHECK_LT(0u, active_scopes_);
+  if (--active_scopes_ > 0) return;
+  v8::base::MutexGuard guard(&mutex_);
+  requested_.store(false, std::memory_order_relaxed);
+  cv_.NotifyAll();
+}
+
 HeapBase::HeapBase(
     std::shared_ptr<cppgc::Platform> platform,
     const std::vector<std::unique_ptr<CustomSpaceBase>>& custom_spaces,
@@ -223,6 +311,7 @@ void HeapBase::ResetRememberedSet() {
 
 void HeapBase::Terminate() {
   CHECK(!IsMarking());
+  CHECK(!mutator_safepoint_.HasThreadLocalAllocators());
   CHECK(!IsGCForbidden());
   // Cannot use IsGCAllowed() as `Terminate()` will be invoked after detaching
   // which implies GC is prohibited at this point.
@@ -314,6 +403,7 @@ HeapStatistics HeapBase::CollectStatistics(
             {}};
   }
 
+  MutatorSafepoint::Scope safepoint_scope(*this);
   sweeper_.FinishIfRunning();
   object_allocator_.ResetLinearAllocationBuffers();
   return HeapStatisticsCollector().CollectDetailedStatistics(this);
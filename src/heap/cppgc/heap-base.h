@@ -5,8 +5,10 @@
 #ifndef V8_HEAP_CPPGC_HEAP_BASE_H_
 #define V8_HEAP_CPPGC_HEAP_BASE_H_
 
+#include <atomic>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "include/cppgc/heap-handle.h"
 #include "include/cppgc/heap-statistics.h"
@@ -14,6 +16,8 @@
 #include "include/cppgc/internal/persistent-node.h"
 #include "include/cppgc/macros.h"
 #include "src/base/macros.h"
+#include "src/base/platform/condition-variable.h"
+#include "src/base/platform/mutex.h"
 #include "src/heap/cppgc/compactor.h"
 #include "src/heap/cppgc/heap-object-header.h"
 #include "src/heap/cppgc/marker.h"
@@ -60,8 +64,10 @@ namespace internal {
 class FatalOutOfMemoryHandler;
 class GarbageCollector;
 class PageBackend;
+class HeapBase;
 class PreFinalizerHandler;
 class StatsCollector;
+class ThreadLocalAllocator;
 
 enum class HeapObjectNameForUnnamedObject : uint8_t;
 enum class StickyBits : uint8_t {
@@ -78,6 +84,93 @@ class MoveListener {
                       size_t size_including_header) = 0;
 };
 
+// Coordinates the mutator threads allocating through a ThreadLocalAllocator
+// with the thread owning the heap. Such threads are either running or parked.
+// A `Scope`, entered on the heap's thread, waits until all of them are parked
+// and keeps them parked until it is left. Running threads park on their
+// allocation slow path and in `ThreadLocalAllocator::Safepoint()`.
+//
+// Allocator state that is shared between threads, i.e., free lists, page lists
+// and allocation counters, is only modified while holding the allocation mutex
+// or within a `Scope`.
+class V8_EXPORT_PRIVATE MutatorSafepoint final {
+ public:
+  class V8_NODISCARD Scope final {
+   public:
+    explicit Scope(HeapBase& heap);
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    MutatorSafepoint& safepoint_;
+  };
+
+  // Holds the allocation mutex, but only while thread-local allocators exist,
+  // so that heaps with a single mutator thread don't pay for locking.
+  // Thread-local allocators are only created and destroyed on the heap's
+  // thread, so this can't change while the heap's thread uses the guard.
+  class V8_NODISCARD AllocationMutexGuard final {
+   public:
+    explicit AllocationMutexGuard(MutatorSafepoint& safepoint)
+        : mutex_(safepoint.HasThreadLocalAllocators()
+                     ? &safepoint.allocation_mutex_
+                     : nullptr) {
+      if (mutex_) mutex_->Lock();
+    }
+    ~AllocationMutexGuard() {
+      if (mutex_) mutex_->Unlock();
+    }
+
+    AllocationMutexGuard(const AllocationMutexGuard&) = delete;
+    AllocationMutexGuard& operator=(const AllocationMutexGuard&) = delete;
+
+   private:
+    v8::base::RecursiveMutex* const mutex_;
+  };
+
+  MutatorSafepoint() = default;
+  ~MutatorSafepoint();
+
+  MutatorSafepoint(const MutatorSafepoint&) = delete;
+  MutatorSafepoint& operator=(const MutatorSafepoint&) = delete;
+
+  bool HasThreadLocalAllocators() const {
+    return has_thread_local_allocators_.load(std::memory_order_relaxed);
+  }
+
+  v8::base::RecursiveMutex& allocation_mutex() { return allocation_mutex_; }
+
+ private:
+  void Register(ThreadLocalAllocator*);
+  void Unregister(ThreadLocalAllocator*);
+
+  void Park();
+  void Unpark();
+  void Safepoint();
+
+  // Acquires the allocation mutex on behalf of a running thread-local
+  // allocator. The thread is parked while waiting for the mutex.
+  void LockAllocationMutexForThreadLocalAllocator();
+
+  void Enter();
+  void Leave();
+
+  mutable v8::base::Mutex mutex_;
+  v8::base::ConditionVariable cv_;
+  std::vector<ThreadLocalAllocator*> allocators_;
+  size_t running_ = 0;
+  size_t active_scopes_ = 0;
+  std::atomic<bool> requested_{false};
+  // Whether `allocators_` is non-empty. Only changes on the heap's thread.
+  std::atomic<bool> has_thread_local_allocators_{false};
+  v8::base::RecursiveMutex allocation_mutex_;
+
+  friend class ObjectAllocator;
+  friend class ThreadLocalAllocator;
+};
+
 // Base class for heap implementations.
 class V8_EXPORT_PRIVATE HeapBase : public cppgc::HeapHandle {
  public:
@@ -135,6 +228,11 @@ class V8_EXPORT_PRIVATE HeapBase : public cppgc::HeapHandle {
   ObjectAllocator& object_allocator() { return object_allocator_; }
   const ObjectAllocator& object_allocator() const { return object_allocator_; }
 
+  MutatorSafepoint& mutator_safepoint() { return mutator_safepoint_; }
+  const MutatorSafepoint& mutator_safepoint() const {
+    return mutator_safepoint_;
+  }
+
   Sweeper& sweeper() { return sweeper_; }
   const Sweeper& sweeper() const { return sweeper_; }
 
@@ -307,6 +405,7 @@ class V8_EXPORT_PRIVATE HeapBase : public cppgc::HeapHandle {
 
   Compactor compactor_;
   ObjectAllocator object_allocator_;
+  MutatorSafepoint mutator_safepoint_;
   Sweeper sweeper_;
 
   PersistentRegion strong_persistent_region_;
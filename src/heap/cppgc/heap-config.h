@@ -97,6 +97,11 @@ struct GCConfig {
             MarkingType::kAtomic, SweepingType::kAtomic};
   }
 
+  static constexpr GCConfig MinorPreciseConcurrentConfig() {
+    return {CollectionType::kMinor, StackState::kNoHeapPointers,
+            MarkingType::kIncrementalAndConcurrent, SweepingType::kAtomic};
+  }
+
   CollectionType collection_type = CollectionType::kMajor;
   StackState stack_state = StackState::kMayContainHeapPointers;
   MarkingType marking_type = MarkingType::kAtomic;
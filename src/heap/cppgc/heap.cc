@@ -109,6 +109,14 @@ void Heap::CollectGarbage(GCConfig config) {
     return;
   }
 
+  // Stops all threads allocating through thread-local allocators for the
+  // whole garbage collection.
+  MutatorSafepoint::Scope safepoint_scope(*this);
+  if (mutator_safepoint().HasThreadLocalAllocators()) {
+    // Sweeping must be finished before the other threads resume.
+    config.sweeping_type = GCConfig::SweepingType::kAtomic;
+  }
+
   config_ = config;
 
   if (!IsMarking()) {
@@ -125,6 +133,10 @@ void Heap::StartIncrementalGarbageCollection(GCConfig config) {
 
   if (IsMarking() || in_no_gc_scope()) return;
 
+  // Threads using thread-local allocators don't emit write barriers. Garbage
+  // collections are instead performed atomically in a safepoint.
+  if (mutator_safepoint().HasThreadLocalAllocators()) return;
+
   config_ = config;
 
   StartGarbageCollection(config);
@@ -59,10 +59,9 @@ void AddToFreeList(NormalPageSpace& space, Address start, size_t size) {
       .SetBit<AccessMode::kAtomic>(start);
 }
 
-void ReplaceLinearAllocationBuffer(NormalPageSpace& space,
-                                   StatsCollector& stats_collector,
-                                   Address new_buffer, size_t new_size) {
-  auto& lab = space.linear_allocation_buffer();
+void ReplaceLinearAllocationBuffer(
+    NormalPageSpace& space, NormalPageSpace::LinearAllocationBuffer& lab,
+    StatsCollector& stats_collector, Address new_buffer, size_t new_size) {
   if (lab.size()) {
     AddToFreeList(space, lab.start(), lab.size());
     stats_collector.NotifyExplicitFree(lab.size());
@@ -113,13 +112,32 @@ ObjectAllocator::ObjectAllocator(RawHeap& heap, PageBackend& page_backend,
       oom_handler_(oom_handler),
       garbage_collector_(garbage_collector) {}
 
+ObjectAllocator::ObjectAllocator(const ObjectAllocator& main_thread_allocator,
+                                 ThreadLocalTag)
+    : raw_heap_(main_thread_allocator.raw_heap_),
+      page_backend_(main_thread_allocator.page_backend_),
+      stats_collector_(main_thread_allocator.stats_collector_),
+      prefinalizer_handler_(main_thread_allocator.prefinalizer_handler_),
+      oom_handler_(main_thread_allocator.oom_handler_),
+      garbage_collector_(main_thread_allocator.garbage_collector_),
+      local_labs_(std::make_unique<NormalPageSpace::LinearAllocationBuffer[]>(
+          raw_heap_.size())) {}
+
 void ObjectAllocator::OutOfLineAllocateGCSafePoint(NormalPageSpace& space,
                                                    size_t size,
                                                    AlignVal alignment,
                                                    GCInfoIndex gcinfo,
                                                    void** object) {
+  if (V8_UNLIKELY(is_thread_local())) {
+    *object = ThreadLocalOutOfLineAllocateImpl(space, size, alignment, gcinfo);
+    return;
+  }
   *object = OutOfLineAllocateImpl(space, size, alignment, gcinfo);
-  stats_collector_.NotifySafePointForConservativeCollection();
+  {
+    MutatorSafepoint::AllocationMutexGuard guard(
+        raw_heap_.heap()->mutator_safepoint());
+    stats_collector_.NotifySafePointForConservativeCollection();
+  }
   if (prefinalizer_handler_.IsInvokingPreFinalizers()) {
     // Objects allocated during pre finalizers should be allocated as black
     // since marking is already done. Atomics are not needed because there is
@@ -127,7 +145,8 @@ void ObjectAllocator::OutOfLineAllocateGCSafePoint(NormalPageSpace& space,
     HeapObjectHeader::FromObject(*object).MarkNonAtomic();
     // Resetting the allocation buffer forces all further allocations in pre
     // finalizers to go through this slow path.
-    ReplaceLinearAllocationBuffer(space, stats_collector_, nullptr, 0);
+    ReplaceLinearAllocationBuffer(space, GetLinearAllocationBuffer(space),
+                                  stats_collector_, nullptr, 0);
     prefinalizer_handler_.NotifyAllocationInPrefinalizer(size);
   }
 }
@@ -144,17 +163,25 @@ void* ObjectAllocator::OutOfLineAllocateImpl(NormalPageSpace& space,
   if (size >= kLargeObjectSizeThreshold) {
     auto& large_space = LargePageSpace::From(
         *raw_heap_.Space(RawHeap::RegularSpaceType::kLarge));
+    MutatorSafepoint& safepoint = raw_heap_.heap()->mutator_safepoint();
     // LargePage has a natural alignment that already satisfies
     // `kMaxSupportedAlignment`.
-    void* result = TryAllocateLargeObject(page_backend_, large_space,
-                                          stats_collector_, size, gcinfo);
+    void* result;
+    {
+      MutatorSafepoint::AllocationMutexGuard guard(safepoint);
+      result = TryAllocateLargeObject(page_backend_, large_space,
+                                      stats_collector_, size, gcinfo);
+    }
     if (!result) {
       auto config = GCConfig::ConservativeAtomicConfig();
       config.free_memory_handling =
           GCConfig::FreeMemoryHandling::kDiscardWherePossible;
       garbage_collector_.CollectGarbage(config);
-      result = TryAllocateLargeObject(page_backend_, large_space,
-                                      stats_collector_, size, gcinfo);
+      {
+        MutatorSafepoint::AllocationMutexGuard guard(safepoint);
+        result = TryAllocateLargeObject(page_backend_, large_space,
+                                        stats_collector_, size, gcinfo);
+      }
       if (!result) {
 #if defined(CPPGC_CAGED_HEAP)
         const auto last_alloc_status =
@@ -206,6 +233,51 @@ void* ObjectAllocator::OutOfLineAllocateImpl(NormalPageSpace& space,
   return result;
 }
 
+void* ObjectAllocator::ThreadLocalOutOfLineAllocateImpl(NormalPageSpace& space,
+                                                        size_t size,
+                                                        AlignVal alignment,
+                                                        GCInfoIndex gcinfo) {
+  DCHECK(is_thread_local());
+  DCHECK_EQ(0, size & kAllocationMask);
+  DCHECK_LE(kFreeListEntrySize, size);
+
+  MutatorSafepoint& safepoint = raw_heap_.heap()->mutator_safepoint();
+
+  if (size >= kLargeObjectSizeThreshold) {
+    auto& large_space = LargePageSpace::From(
+        *raw_heap_.Space(RawHeap::RegularSpaceType::kLarge));
+    safepoint.LockAllocationMutexForThreadLocalAllocator();
+    void* result = TryAllocateLargeObject(page_backend_, large_space,
+                                          stats_collector_, size, gcinfo);
+    safepoint.allocation_mutex().Unlock();
+    if (!result) oom_handler_("Oilpan: Thread-local large allocation.");
+    return result;
+  }
+
+  size_t request_size = size;
+  const size_t dynamic_alignment = static_cast<size_t>(alignment);
+  if (dynamic_alignment != kAllocationGranularity) {
+    CHECK_EQ(2 * sizeof(HeapObjectHeader), dynamic_alignment);
+    request_size += kAllocationGranularity;
+  }
+
+  // Sweeping never runs concurrently to thread-local allocators, so refilling
+  // is limited to the free list and expanding the heap.
+  safepoint.LockAllocationMutexForThreadLocalAllocator();
+  const bool refilled =
+      TryRefillLinearAllocationBufferFromFreeList(space, request_size) ||
+      TryExpandAndRefillLinearAllocationBuffer(space);
+  safepoint.allocation_mutex().Unlock();
+  if (!refilled) oom_handler_("Oilpan: Thread-local normal allocation.");
+
+  // The buffer is owned by this thread and is used without the lock.
+  void* result = (dynamic_alignment == kAllocationGranularity)
+                     ? AllocateObjectOnSpace(space, size, gcinfo)
+                     : AllocateObjectOnSpace(space, size, alignment, gcinfo);
+  CHECK(result);
+  return result;
+}
+
 bool ObjectAllocator::TryExpandAndRefillLinearAllocationBuffer(
     NormalPageSpace& space) {
   auto* const new_page = NormalPage::TryCreate(page_backend_, space);
@@ -213,14 +285,19 @@ bool ObjectAllocator::TryExpandAndRefillLinearAllocationBuffer(
 
   space.AddPage(new_page);
   // Set linear allocation buffer to new page.
-  ReplaceLinearAllocationBuffer(space, stats_collector_,
-                                new_page->PayloadStart(),
+  ReplaceLinearAllocationBuffer(space, GetLinearAllocationBuffer(space),
+                                stats_collector_, new_page->PayloadStart(),
                                 new_page->PayloadSize());
   return true;
 }
 
 bool ObjectAllocator::TryRefillLinearAllocationBuffer(NormalPageSpace& space,
                                                       size_t size) {
+  DCHECK(!is_thread_local());
+  // Also covers lazy sweeping below, which adds to the free lists.
+  MutatorSafepoint::AllocationMutexGuard guard(
+      raw_heap_.heap()->mutator_safepoint());
+
   // Try to allocate from the freelist.
   if (TryRefillLinearAllocationBufferFromFreeList(space, size)) return true;
 
@@ -278,26 +355,30 @@ bool ObjectAllocator::TryRefillLinearAllocationBufferFromFreeList(
     page.ResetDiscardedMemory();
   }
 
-  ReplaceLinearAllocationBuffer(
-      space, stats_collector_, static_cast<Address>(entry.address), entry.size);
+  ReplaceLinearAllocationBuffer(space, GetLinearAllocationBuffer(space),
+                                stats_collector_,
+                                static_cast<Address>(entry.address),
+                                entry.size);
   return true;
 }
 
 void ObjectAllocator::ResetLinearAllocationBuffers() {
   class Resetter : public HeapVisitor<Resetter> {
    public:
-    explicit Resetter(StatsCollector& stats) : stats_collector_(stats) {}
+    explicit Resetter(ObjectAllocator& allocator) : allocator_(allocator) {}
 
     bool VisitLargePageSpace(LargePageSpace&) { return true; }
 
     bool VisitNormalPageSpace(NormalPageSpace& space) {
-      ReplaceLinearAllocationBuffer(space, stats_collector_, nullptr, 0);
+      ReplaceLinearAllocationBuffer(
+          space, allocator_.GetLinearAllocationBuffer(space),
+          allocator_.stats_collector_, nullptr, 0);
       return true;
     }
 
    private:
-    StatsCollector& stats_collector_;
-  } visitor(stats_collector_);
+    ObjectAllocator& allocator_;
+  } visitor(*this);
 
   visitor.Traverse(raw_heap_);
 }
@@ -323,6 +404,9 @@ void ObjectAllocator::MarkAllPagesAsYoung() {
 }
 
 bool ObjectAllocator::in_disallow_gc_scope() const {
+  // Thread-local allocators never trigger garbage collections and must not
+  // access the heap's GC state.
+  if (is_thread_local()) return false;
   return raw_heap_.heap()->IsGCForbidden();
 }
 
@@ -343,5 +427,53 @@ void ObjectAllocator::TriggerGCOnAllocationTimeoutIfNeeded() {
 }
 #endif  // V8_ENABLE_ALLOCATION_TIMEOUT
 
+ThreadLocalAllocator::ThreadLocalAllocator(Heap& heap)
+    : heap_(heap),
+      allocator_(heap.object_allocator(), ObjectAllocator::ThreadLocalTag{}) {
+  DCHECK_EQ(heap_.GetCreationThreadId(), v8::base::OS::GetCurrentThreadId());
+  // Thread-local allocators don't emit write barriers, see
+  // `Heap::StartIncrementalGarbageCollection()`.
+  CHECK_NULL(heap_.marker());
+  CHECK(!heap_.generational_gc_supported());
+  heap_.sweeper().FinishIfRunning();
+  heap_.mutator_safepoint().Register(this);
+}
+
+ThreadLocalAllocator::~ThreadLocalAllocator() {
+  DCHECK_EQ(heap_.GetCreationThreadId(), v8::base::OS::GetCurrentThreadId());
+  DCHECK(!is_running_);
+  {
+    v8::base::RecursiveMutexGuard guard(
+        &heap_.mutator_safepoint().allocation_mutex());
+    ResetLinearAllocationBuffers();
+  }
+  heap_.mutator_safepoint().Unregister(this);
+}
+
+void ThreadLocalAllocator::Park() {
+  DCHECK(is_running_);
+#ifdef DEBUG
+  is_running_ = false;
+#endif  // DEBUG
+  heap_.mutator_safepoint().Park();
+}
+
+void ThreadLocalAllocator::Unpark() {
+  DCHECK(!is_running_);
+  heap_.mutator_safepoint().Unpark();
+#ifdef DEBUG
+  is_running_ = true;
+#endif  // DEBUG
+}
+
+void ThreadLocalAllocator::Safepoint() {
+  DCHECK(is_running_);
+  heap_.mutator_safepoint().Safepoint();
+}
+
+void ThreadLocalAllocator::ResetLinearAllocationBuffers() {
+  allocator_.ResetLinearAllocationBuffers();
+}
+
 }  // namespace internal
 }  // namespace cppgc
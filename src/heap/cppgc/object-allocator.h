@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_CPPGC_OBJECT_ALLOCATOR_H_
 #define V8_HEAP_CPPGC_OBJECT_ALLOCATOR_H_
 
+#include <memory>
 #include <optional>
 
 #include "include/cppgc/allocation.h"
@@ -37,13 +38,19 @@ namespace internal {
 class StatsCollector;
 class PageBackend;
 class GarbageCollector;
+class Heap;
 
 class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
  public:
   static constexpr size_t kSmallestSpaceSize = 32;
 
+  // Tag for creating an allocator that owns its linear allocation buffers
+  // instead of using the ones of the spaces. See ThreadLocalAllocator.
+  struct ThreadLocalTag {};
+
   ObjectAllocator(RawHeap&, PageBackend&, StatsCollector&, PreFinalizerHandler&,
                   FatalOutOfMemoryHandler&, GarbageCollector&);
+  ObjectAllocator(const ObjectAllocator& main_thread_allocator, ThreadLocalTag);
 
   inline void* AllocateObject(size_t size, GCInfoIndex gcinfo);
   inline void* AllocateObject(size_t size, AlignVal alignment,
@@ -56,6 +63,8 @@ class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
   void ResetLinearAllocationBuffers();
   void MarkAllPagesAsYoung();
 
+  bool is_thread_local() const { return static_cast<bool>(local_labs_); }
+
 #ifdef V8_ENABLE_ALLOCATION_TIMEOUT
   void UpdateAllocationTimeout();
   int get_allocation_timeout_for_testing() const {
@@ -71,6 +80,9 @@ class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
   inline static RawHeap::RegularSpaceType GetInitialSpaceIndexForSize(
       size_t size);
 
+  inline NormalPageSpace::LinearAllocationBuffer& GetLinearAllocationBuffer(
+      NormalPageSpace&);
+
   inline void* AllocateObjectOnSpace(NormalPageSpace&, size_t, GCInfoIndex);
   inline void* AllocateObjectOnSpace(NormalPageSpace&, size_t, AlignVal,
                                      GCInfoIndex);
@@ -87,6 +99,9 @@ class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
                                                      void**);
   // Raw allocation, does not emit safepoint for conservative GC.
   void* OutOfLineAllocateImpl(NormalPageSpace&, size_t, AlignVal, GCInfoIndex);
+  // Slow path of thread-local allocators. Never triggers a garbage collection.
+  void* ThreadLocalOutOfLineAllocateImpl(NormalPageSpace&, size_t, AlignVal,
+                                         GCInfoIndex);
 
   bool TryRefillLinearAllocationBuffer(NormalPageSpace&, size_t);
   bool TryRefillLinearAllocationBufferFromFreeList(NormalPageSpace&, size_t);
@@ -102,6 +117,9 @@ class V8_EXPORT_PRIVATE ObjectAllocator final : public cppgc::AllocationHandle {
   PreFinalizerHandler& prefinalizer_handler_;
   FatalOutOfMemoryHandler& oom_handler_;
   GarbageCollector& garbage_collector_;
+  // Linear allocation buffers indexed by space for thread-local allocators.
+  // Empty for the heap's own allocator which uses the spaces' buffers.
+  std::unique_ptr<NormalPageSpace::LinearAllocationBuffer[]> local_labs_;
 #ifdef V8_ENABLE_ALLOCATION_TIMEOUT
   // Specifies how many allocations should be performed until triggering a
   // garbage collection.
@@ -163,6 +181,13 @@ void* ObjectAllocator::AllocateObject(size_t size, AlignVal alignment,
       allocation_size, alignment, gcinfo);
 }
 
+NormalPageSpace::LinearAllocationBuffer&
+ObjectAllocator::GetLinearAllocationBuffer(NormalPageSpace& space) {
+  if (V8_LIKELY(!local_labs_)) return space.linear_allocation_buffer();
+  DCHECK_LT(space.index(), raw_heap_.size());
+  return local_labs_[space.index()];
+}
+
 // static
 RawHeap::RegularSpaceType ObjectAllocator::GetInitialSpaceIndexForSize(
     size_t size) {
@@ -203,7 +228,7 @@ void* ObjectAllocator::AllocateObjectOnSpace(NormalPageSpace& space,
   constexpr size_t kPaddingSize = kAlignment - sizeof(HeapObjectHeader);
 
   NormalPageSpace::LinearAllocationBuffer& current_lab =
-      space.linear_allocation_buffer();
+      GetLinearAllocationBuffer(space);
   const size_t current_lab_size = current_lab.size();
   // Case 1: The LAB fits the request and the LAB start is already properly
   // aligned.
@@ -237,7 +262,7 @@ void* ObjectAllocator::AllocateObjectOnSpace(NormalPageSpace& space,
   DCHECK_LT(0u, gcinfo);
 
   NormalPageSpace::LinearAllocationBuffer& current_lab =
-      space.linear_allocation_buffer();
+      GetLinearAllocationBuffer(space);
   if (V8_UNLIKELY(current_lab.size() < size)) {
     return OutOfLineAllocate(
         space, size, static_cast<AlignVal>(kAllocationGranularity), gcinfo);
@@ -262,6 +287,70 @@ void* ObjectAllocator::AllocateObjectOnSpace(NormalPageSpace& space,
   return header->ObjectStart();
 }
 
+// Allocation handle for an additional mutator thread of a standalone heap.
+// The allocator owns linear allocation buffers for all normal page spaces, so
+// that its fast path doesn't need any synchronization. Refilling the buffers
+// synchronizes with the other threads through the heap's MutatorSafepoint.
+//
+// Instances are created and destroyed on the heap's thread and start out
+// parked. The using thread unparks before allocating and must park, or
+// regularly call `Safepoint()`, while it doesn't allocate, as garbage
+// collections wait for all running threads. They also must not run write
+// barriers, which is why garbage collections are atomic while thread-local
+// allocators exist. Thread-local allocators never trigger garbage collections
+// themselves.
+//
+// Stacks of such threads are not scanned. Every allocation that leaves the
+// fast path may park the thread and let a garbage collection run, so an object
+// that is only referenced from the thread's stack, including one that was just
+// allocated, must be made reachable, e.g., through a cross-thread persistent
+// handle, before the thread allocates again or calls `Safepoint()`.
+//
+// This is groundwork for multi-mutator heaps: there is no public API in
+// include/cppgc yet, so only V8-internal code can create these allocators.
+class V8_EXPORT_PRIVATE ThreadLocalAllocator final {
+ public:
+  class V8_NODISCARD UnparkedScope final {
+   public:
+    explicit UnparkedScope(ThreadLocalAllocator& allocator)
+        : allocator_(allocator) {
+      allocator_.Unpark();
+    }
+    ~UnparkedScope() { allocator_.Park(); }
+
+    UnparkedScope(const UnparkedScope&) = delete;
+    UnparkedScope& operator=(const UnparkedScope&) = delete;
+
+   private:
+    ThreadLocalAllocator& allocator_;
+  };
+
+  explicit ThreadLocalAllocator(Heap& heap);
+  ~ThreadLocalAllocator();
+
+  ThreadLocalAllocator(const ThreadLocalAllocator&) = delete;
+  ThreadLocalAllocator& operator=(const ThreadLocalAllocator&) = delete;
+
+  // Only usable while unparked.
+  AllocationHandle& GetAllocationHandle() { return allocator_; }
+
+  void Park();
+  void Unpark();
+  // Parks the thread if the heap's thread is waiting for a safepoint.
+  void Safepoint();
+
+ private:
+  void ResetLinearAllocationBuffers();
+
+  Heap& heap_;
+  ObjectAllocator allocator_;
+#ifdef DEBUG
+  bool is_running_ = false;
+#endif  // DEBUG
+
+  friend class MutatorSafepoint;
+};
+
 }  // namespace internal
 }  // namespace cppgc
 
@@ -70,7 +70,9 @@ namespace internal {
   V(ConcurrentWeakCallback)                          \
   V(ConcurrentWeakPersistent)
 
-#define CPPGC_FOR_ALL_CONCURRENT_SCOPES(V) V(ConcurrentMarkProcessEphemerons)
+#define CPPGC_FOR_ALL_CONCURRENT_SCOPES(V) \
+  V(ConcurrentMarkProcessEphemerons)       \
+  V(ConcurrentCompact)
 
 // Sink for various time and memory statistics.
 class V8_EXPORT_PRIVATE StatsCollector final {
@@ -22,8 +22,8 @@ AllocationResult EvacuationAllocator::Allocate(AllocationSpace space,
       return new_space_allocator()->AllocateRaw(object_size, alignment,
                                                 AllocationOrigin::kGC);
     case OLD_SPACE:
-      return old_space_allocator()->AllocateRaw(object_size, alignment,
-                                                AllocationOrigin::kGC);
+      return old_space_allocator(object_size)
+          ->AllocateRaw(object_size, alignment, AllocationOrigin::kGC);
     case CODE_SPACE:
       return code_space_allocator()->AllocateRaw(object_size, alignment,
                                                  AllocationOrigin::kGC);
@@ -13,7 +13,8 @@ EvacuationAllocator::EvacuationAllocator(
     Heap* heap, CompactionSpaceKind compaction_space_kind)
     : heap_(heap),
       new_space_(heap->new_space()),
-      compaction_spaces_(heap, compaction_space_kind) {
+      compaction_spaces_(heap, compaction_space_kind),
+      segregate_small_old_objects_(v8_flags.segregate_small_old_objects) {
   if (new_space_) {
     DCHECK(!heap_->allocator()->new_space_allocator()->IsLabValid());
     new_space_allocator_.emplace(heap, new_space_, MainAllocator::kInGC);
@@ -21,6 +22,15 @@ EvacuationAllocator::EvacuationAllocator(
 
   old_space_allocator_.emplace(heap, compaction_spaces_.Get(OLD_SPACE),
                                MainAllocator::kInGC);
+  if (segregate_small_old_objects_) {
+    // All size classes share the compaction space and its free list. The LABs
+    // are bounded so that the size classes don't each hold on to a whole
+    // free page.
+    for (auto& allocator : old_size_class_allocators_) {
+      allocator.emplace(heap, compaction_spaces_.Get(OLD_SPACE),
+                        MainAllocator::kInGC, kSizeClassLabSize);
+    }
+  }
   code_space_allocator_.emplace(heap, compaction_spaces_.Get(CODE_SPACE),
                                 MainAllocator::kInGC);
   if (heap_->isolate()->has_shared_space()) {
@@ -40,7 +50,8 @@ void EvacuationAllocator::FreeLast(AllocationSpace space,
       FreeLastInMainAllocator(new_space_allocator(), object, object_size);
       return;
     case OLD_SPACE:
-      FreeLastInMainAllocator(old_space_allocator(), object, object_size);
+      FreeLastInMainAllocator(old_space_allocator(object_size), object,
+                              object_size);
       return;
     case SHARED_SPACE:
       FreeLastInMainAllocator(shared_space_allocator(), object, object_size);
@@ -66,6 +77,9 @@ void EvacuationAllocator::Finalize() {
   }
 
   old_space_allocator()->FreeLinearAllocationArea();
+  for (auto& allocator : old_size_class_allocators_) {
+    if (allocator) allocator->FreeLinearAllocationArea();
+  }
   heap_->old_space()->MergeCompactionSpace(compaction_spaces_.Get(OLD_SPACE));
 
   code_space_allocator()->FreeLinearAllocationArea();
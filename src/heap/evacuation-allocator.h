@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_EVACUATION_ALLOCATOR_H_
 #define V8_HEAP_EVACUATION_ALLOCATOR_H_
 
+#include <array>
 #include <optional>
 
 #include "src/common/globals.h"
@@ -31,12 +32,32 @@ class EvacuationAllocator {
   void FreeLast(AllocationSpace space, Tagged<HeapObject> object,
                 int object_size);
 
+  // Old space objects up to this size are segregated by size class when
+  // --segregate-small-old-objects is enabled. Each size class bump-allocates
+  // from its own LAB of at most kSizeClassLabSize bytes, which is taken from
+  // the free list of the compaction space like any other LAB. Whether this
+  // reduces fragmentation is not measured.
+  static constexpr int kMaxSizeClassObjectSize = 16 * kTaggedSize;
+  static constexpr int kNumberOfSizeClasses =
+      kMaxSizeClassObjectSize / kTaggedSize;
+  static constexpr size_t kSizeClassLabSize = 4 * KB;
+
  private:
   void FreeLastInMainAllocator(MainAllocator* allocator,
                                Tagged<HeapObject> object, int object_size);
 
   MainAllocator* new_space_allocator() { return &new_space_allocator_.value(); }
   MainAllocator* old_space_allocator() { return &old_space_allocator_.value(); }
+  // Returns the allocator for old space objects of `object_size`. Only
+  // depends on the size, so FreeLast() finds the LAB that Allocate() used.
+  MainAllocator* old_space_allocator(int object_size) {
+    if (!segregate_small_old_objects_ ||
+        object_size > kMaxSizeClassObjectSize) {
+      return old_space_allocator();
+    }
+    DCHECK_GE(object_size, kTaggedSize);
+    return &old_size_class_allocators_[object_size / kTaggedSize - 1].value();
+  }
   MainAllocator* code_space_allocator() {
     return &code_space_allocator_.value();
   }
@@ -52,6 +73,9 @@ class EvacuationAllocator {
   CompactionSpaceCollection compaction_spaces_;
   std::optional<MainAllocator> new_space_allocator_;
   std::optional<MainAllocator> old_space_allocator_;
+  const bool segregate_small_old_objects_;
+  std::array<std::optional<MainAllocator>, kNumberOfSizeClasses>
+      old_size_class_allocators_;
   std::optional<MainAllocator> code_space_allocator_;
   std::optional<MainAllocator> shared_space_allocator_;
   std::optional<MainAllocator> trusted_space_allocator_;
@@ -10,6 +10,7 @@
 
 #include "include/v8-metrics.h"
 #include "src/base/atomic-utils.h"
+#include "src/base/bits.h"
 #include "src/base/logging.h"
 #include "src/base/platform/time.h"
 #include "src/base/strings.h"
@@ -256,6 +257,7 @@ void GCTracer::StartCycle(GarbageCollector collector,
       type = marking == MarkingType::kIncremental
                  ? Event::Type::INCREMENTAL_MARK_COMPACTOR
                  : Event::Type::MARK_COMPACTOR;
+      marking_prefetched_objects_.store(0, std::memory_order_relaxed);
       break;
   }
 
@@ -454,6 +456,7 @@ void GCTracer::StopCycle(GarbageCollector collector) {
   DCHECK(IsConsistentWithCollector(collector));
 
   FetchBackgroundCounters();
+  RecordPauseHistograms(collector);
 
   if (Heap::IsYoungGenerationCollector(collector)) {
     ReportYoungCycleToRecorder();
@@ -704,6 +707,8 @@ void GCTracer::AddSurvivalRatio(double promotion_ratio) {
 }
 
 void GCTracer::AddIncrementalMarkingStep(double duration, size_t bytes) {
+  pause_histograms_.Record(PauseHistograms::Phase::kIncrementalMarkingStep,
+                           base::TimeDelta::FromMillisecondsD(duration));
   if (bytes > 0) {
     current_.incremental_marking_bytes += bytes;
     current_.incremental_marking_duration +=
@@ -1073,6 +1078,8 @@ void GCTracer::PrintNVP() const {
           "new_space_survive_rate=%.1f%% "
           "new_space_allocation_throughput=%.1f "
           "pool_chunks=%zu "
+          "marking_prefetch_distance=%d "
+          "marking_prefetched_objects=%zu "
           "compaction_speed=%.f\n",
           duration.InMillisecondsF(), spent_in_mutator.InMillisecondsF(),
           ToString(current_.type, true), current_.reduce_memory,
@@ -1161,7 +1168,8 @@ void GCTracer::PrintNVP() const {
           heap_->new_space_surviving_rate_,
           NewSpaceAllocationThroughputInBytesPerMillisecond(),
           heap_->memory_allocator()->pool()->NumberOfCommittedChunks(),
-          CompactionSpeedInBytesPerMillisecond());
+          v8_flags.marking_prefetch_distance.value(),
+          MarkingPrefetchedObjects(), CompactionSpeedInBytesPerMillisecond());
       break;
     case Event::Type::START:
       break;
@@ -1425,6 +1433,65 @@ void GCTracer::RecordGCPhasesHistograms(RecordGCPhasesInfo::Mode mode) {
   }
 }
 
+// static
+size_t GCTracer::PauseHistograms::BucketIndex(int64_t microseconds) {
+  if (microseconds < kSubBucketCount) {
+    return static_cast<size_t>(std::max<int64_t>(microseconds, 0));
+  }
+  const int msb = 63 - base::bits::CountLeadingZeros(
+                           static_cast<uint64_t>(microseconds));
+  const size_t index =
+      static_cast<size_t>(msb - kSubBucketBits + 1) * kSubBucketCount +
+      ((microseconds >> (msb - kSubBucketBits)) & (kSubBucketCount - 1));
+  return std::min(index, kBucketCount - 1);
+}
+
+// static
+int64_t GCTracer::PauseHistograms::BucketLowerBound(size_t index) {
+  DCHECK_LT(index, kBucketCount);
+  if (index < static_cast<size_t>(kSubBucketCount)) {
+    return static_cast<int64_t>(index);
+  }
+  const size_t range = index / kSubBucketCount;
+  const int64_t sub_bucket = index % kSubBucketCount;
+  return (kSubBucketCount + sub_bucket) << (range - 1);
+}
+
+void GCTracer::PauseHistograms::Record(Phase phase, base::TimeDelta duration) {
+  const int64_t microseconds = std::max<int64_t>(duration.InMicroseconds(), 0);
+  Histogram& histogram = histograms_[static_cast<size_t>(phase)];
+  histogram.buckets[BucketIndex(microseconds)].fetch_add(
+      1, std::memory_order_relaxed);
+  histogram.total_microseconds.fetch_add(microseconds,
+                                         std::memory_order_relaxed);
+  // There is a single writer, so no compare-and-swap loop is needed.
+  if (microseconds >
+      histogram.max_microseconds.load(std::memory_order_relaxed)) {
+    histogram.max_microseconds.store(microseconds, std::memory_order_relaxed);
+  }
+}
+
+void GCTracer::RecordPauseHistograms(GarbageCollector collector) {
+  using Phase = PauseHistograms::Phase;
+  const base::TimeDelta pause = current_.end_time - current_.start_time;
+  switch (collector) {
+    case GarbageCollector::SCAVENGER:
+      pause_histograms_.Record(Phase::kScavenge, pause);
+      break;
+    case GarbageCollector::MINOR_MARK_SWEEPER:
+      pause_histograms_.Record(Phase::kMinorMarkSweep, pause);
+      break;
+    case GarbageCollector::MARK_COMPACTOR:
+      pause_histograms_.Record(Phase::kMarkCompact, pause);
+      pause_histograms_.Record(Phase::kMark, current_.scopes[Scope::MC_MARK]);
+      pause_histograms_.Record(Phase::kSweep,
+                               current_.scopes[Scope::MC_SWEEP]);
+      pause_histograms_.Record(Phase::kEvacuate,
+                               current_.scopes[Scope::MC_EVACUATE]);
+      break;
+  }
+}
+
 void GCTracer::RecordGCSumCounters() {
   const base::TimeDelta atomic_pause_duration =
       current_.scopes[Scope::MARK_COMPACTOR];
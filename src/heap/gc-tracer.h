@@ -5,9 +5,11 @@
 #ifndef V8_HEAP_GC_TRACER_H_
 #define V8_HEAP_GC_TRACER_H_
 
+#include <atomic>
 #include <optional>
 
 #include "include/v8-metrics.h"
+#include "include/v8-statistics.h"
 #include "src/base/compiler-specific.h"
 #include "src/base/macros.h"
 #include "src/base/ring-buffer.h"
@@ -264,6 +266,48 @@ class V8_EXPORT_PRIVATE GCTracer {
     TimedHistogram* type_priority_timer_;
   };
 
+  // Pause histograms backing v8::Isolate::GetGCStatistics(). They are only
+  // written on the main thread, in StopCycle() and for incremental marking
+  // steps, and can be read from any thread without locking.
+  class PauseHistograms final {
+   public:
+    using Phase = v8::GCStatisticsSnapshot::Phase;
+    static constexpr size_t kBucketCount = v8::GCPauseHistogram::kBucketCount;
+
+    static size_t BucketIndex(int64_t microseconds);
+    static int64_t BucketLowerBound(size_t index);
+
+    void Record(Phase phase, base::TimeDelta duration);
+
+    uint64_t bucket(Phase phase, size_t index) const {
+      return histogram(phase).buckets[index].load(std::memory_order_relaxed);
+    }
+    int64_t total_microseconds(Phase phase) const {
+      return histogram(phase).total_microseconds.load(
+          std::memory_order_relaxed);
+    }
+    int64_t max_microseconds(Phase phase) const {
+      return histogram(phase).max_microseconds.load(std::memory_order_relaxed);
+    }
+
+   private:
+    // Number of linear buckets per power-of-two range of microseconds.
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int64_t kSubBucketCount = 1 << kSubBucketBits;
+
+    struct Histogram {
+      std::atomic<uint64_t> buckets[kBucketCount] = {};
+      std::atomic<int64_t> total_microseconds{0};
+      std::atomic<int64_t> max_microseconds{0};
+    };
+
+    const Histogram& histogram(Phase phase) const {
+      return histograms_[static_cast<size_t>(phase)];
+    }
+
+    Histogram histograms_[v8::GCStatisticsSnapshot::kPhaseCount];
+  };
+
   static constexpr base::TimeDelta kThroughputTimeFrame =
       base::TimeDelta::FromSeconds(5);
   static constexpr double kConservativeSpeedInBytesPerMillisecond = 128 * KB;
@@ -342,6 +386,17 @@ class V8_EXPORT_PRIVATE GCTracer {
   // Log an incremental marking step.
   void AddIncrementalMarkingStep(double duration, size_t bytes);
 
+  // Accounts objects that full GC markers visited only after prefetching them
+  // (see --marking-prefetch-distance). May be called from background threads.
+  void AddMarkingPrefetchedObjects(size_t objects) {
+    if (objects == 0) return;
+    marking_prefetched_objects_.fetch_add(objects, std::memory_order_relaxed);
+  }
+  // Returns the number of prefetched objects in the current full GC cycle.
+  size_t MarkingPrefetchedObjects() const {
+    return marking_prefetched_objects_.load(std::memory_order_relaxed);
+  }
+
   // Log an incremental marking step.
   void AddIncrementalSweepingStep(double duration);
 
@@ -459,6 +514,8 @@ class V8_EXPORT_PRIVATE GCTracer {
 
   GarbageCollector GetCurrentCollector() const;
 
+  const PauseHistograms& pause_histograms() const { return pause_histograms_; }
+
  private:
   using BytesAndDurationBuffer = ::heap::base::BytesAndDurationBuffer;
 
@@ -486,6 +543,7 @@ class V8_EXPORT_PRIVATE GCTracer {
   // within a GC is not necessary which is why the recording takes place at the
   // end of the atomic pause.
   void RecordGCSumCounters();
+  void RecordPauseHistograms(GarbageCollector collector);
 
   // Print one detailed trace line in name=value format.
   // TODO(ernstm): Move to Heap.
@@ -527,6 +585,11 @@ class V8_EXPORT_PRIVATE GCTracer {
   // Incremental marking speed for major GCs. Marking for minor GCs is ignored.
   double recorded_major_incremental_marking_speed_ = 0.0;
 
+  PauseHistograms pause_histograms_;
+
+  // Objects visited after being prefetched in the current full GC cycle.
+  std::atomic<size_t> marking_prefetched_objects_{0};
+
   std::optional<base::TimeDelta> average_time_to_incremental_marking_task_;
 
   double recorded_embedder_speed_ = 0.0;
@@ -741,6 +741,12 @@ void HeapVerification::VerifyRememberedSetFor(Tagged<HeapObject> object) {
   CollectSlots<OLD_TO_NEW>(chunk, start, end, &old_to_new, &typed_old_to_new);
   CollectSlots<OLD_TO_NEW_BACKGROUND>(chunk, start, end, &old_to_new,
                                       &typed_old_to_new);
+  if (const CardTable* card_table = chunk->card_table()) {
+    // Slots in dirty cards are added to OLD_TO_NEW at the next GC.
+    for (Address slot = start; slot < end; slot += kTaggedSize) {
+      if (card_table->IsDirty(chunk->Offset(slot))) old_to_new.insert(slot);
+    }
+  }
 
   OldToNewSlotVerifyingVisitor old_to_new_visitor(
       isolate(), &old_to_new, &typed_old_to_new,
@@ -120,6 +120,7 @@
 #include "src/tracing/trace-event.h"
 #include "src/utils/utils-inl.h"
 #include "src/utils/utils.h"
+#include "src/zone/accounting-allocator.h"
 
 #ifdef V8_ENABLE_CONSERVATIVE_STACK_SCANNING
 #include "src/heap/conservative-stack-visitor.h"
@@ -1079,6 +1080,7 @@ void Heap::GarbageCollectionPrologueInSafepoint() {
   TRACE_GC(tracer(), GCTracer::Scope::HEAP_PROLOGUE_SAFEPOINT);
   gc_count_++;
   new_space_allocation_counter_ = NewSpaceAllocationCounter();
+  FlushOldToNewCardTables();
 
   DCHECK_EQ(ResizeNewSpaceMode::kNone, resize_new_space_mode_);
   if (new_space_) {
@@ -3368,7 +3370,8 @@ bool Heap::CanMoveObjectStart(Tagged<HeapObject> object) {
 
 bool Heap::IsImmovable(Tagged<HeapObject> object) {
   MemoryChunk* chunk = MemoryChunk::FromHeapObject(object);
-  return chunk->NeverEvacuate() || chunk->IsLargePage();
+  return chunk->NeverEvacuate() ||
+         (chunk->IsLargePage() && !v8_flags.compact_large_objects);
 }
 
 bool Heap::IsLargeObject(Tagged<HeapObject> object) {
@@ -4212,6 +4215,10 @@ void Heap::MemoryPressureNotification(MemoryPressureLevel level,
                                       bool is_isolate_locked) {
   TRACE_EVENT1("devtools.timeline,v8", "V8.MemoryPressureNotification", "level",
                static_cast<int>(level));
+  if (level != MemoryPressureLevel::kNone) {
+    // Zone segments that are only cached for reuse can be released right away.
+    AccountingAllocator::ReleaseCachedSegments();
+  }
   MemoryPressureLevel previous =
       memory_pressure_level_.exchange(level, std::memory_order_relaxed);
   if ((previous != MemoryPressureLevel::kCritical &&
@@ -6441,10 +6448,60 @@ int Heap::InsertIntoRememberedSetFromCode(MutablePageMetadata* chunk,
   // This is called during runtime by a builtin, therefore it is run in the main
   // thread.
   DCHECK_NULL(LocalHeap::Current());
+  if (CardTable* card_table = OldToNewCardTableFor(chunk)) {
+    card_table->Mark(slot_offset);
+    return 0;
+  }
   RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(chunk, slot_offset);
   return 0;
 }
 
+// static
+CardTable* Heap::OldToNewCardTableFor(MutablePageMetadata* page) {
+  if (!v8_flags.old_to_new_card_marking) return nullptr;
+  if (CardTable* card_table = page->card_table()) return card_table;
+  if (!page->Chunk()->IsLargePage() || page->owner_identity() != LO_SPACE) {
+    return nullptr;
+  }
+  Tagged<HeapObject> object = LargePageMetadata::cast(page)->GetObject();
+  // Subclasses of FixedArray are excluded on purpose: e.g. the keys of an
+  // EphemeronHashTable must not be recorded as strong OLD_TO_NEW slots.
+  if (!IsFixedArrayExact(object) && !IsWeakFixedArray(object)) return nullptr;
+  DCHECK_NULL(LocalHeap::Current());
+  return page->AllocateCardTable();
+}
+
+void Heap::FlushOldToNewCardTables() {
+  if (!v8_flags.old_to_new_card_marking) return;
+  DCHECK_NULL(LocalHeap::Current());
+  for (LargePageMetadata* page : *lo_space()) {
+    // Also sets up card tables for arrays that only got recorded slots via
+    // the slot set so far, e.g. because they were promoted.
+    CardTable* card_table = OldToNewCardTableFor(page);
+    if (card_table == nullptr) continue;
+    Tagged<HeapObject> object = page->GetObject();
+    const Address chunk_start = page->ChunkAddress();
+    // Skip the map word. The object may have been right-trimmed since the
+    // cards were marked.
+    const Address object_start = object.address() + HeapObject::kHeaderSize;
+    const Address object_end = object.address() + object->Size();
+    card_table->IterateAndClear(
+        page->size(), [page, chunk_start, object_start, object_end](
+                          size_t card_start, size_t card_end) {
+          MaybeObjectSlot slot(
+              std::max(chunk_start + card_start, object_start));
+          MaybeObjectSlot end(std::min(chunk_start + card_end, object_end));
+          for (; slot < end; ++slot) {
+            Tagged<HeapObject> value;
+            if (!(*slot).GetHeapObject(&value)) continue;
+            if (!Heap::InYoungGeneration(value)) continue;
+            RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(
+                page, slot.address() - chunk_start);
+          }
+        });
+  }
+}
+
 #ifdef DEBUG
 void Heap::VerifySlotRangeHasNoRecordedSlots(Address start, Address end) {
 #ifndef V8_DISABLE_WRITE_BARRIERS
@@ -7204,6 +7261,10 @@ void Heap::GenerationalBarrierSlow(Tagged<HeapObject> object, Address slot,
   MemoryChunk* chunk = MemoryChunk::FromHeapObject(object);
   MutablePageMetadata* metadata = MutablePageMetadata::cast(chunk->Metadata());
   if (LocalHeap::Current() == nullptr) {
+    if (CardTable* card_table = OldToNewCardTableFor(metadata)) {
+      card_table->Mark(chunk->Offset(slot));
+      return;
+    }
     RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(
         metadata, chunk->Offset(slot));
   } else {
@@ -7263,6 +7324,10 @@ void Heap::WriteBarrierForRangeImpl(MemoryChunk* source_chunk,
   MarkCompactCollector* collector = this->mark_compact_collector();
   MutablePageMetadata* source_page_metadata =
       MutablePageMetadata::cast(source_chunk->Metadata());
+  CardTable* card_table = nullptr;
+  if (kModeMask & kDoGenerationalOrShared) {
+    card_table = OldToNewCardTableFor(source_page_metadata);
+  }
 
   for (TSlot slot = start_slot; slot < end_slot; ++slot) {
     // If we *only* need the generational or shared WB, we can skip objects
@@ -7292,8 +7357,12 @@ void Heap::WriteBarrierForRangeImpl(MemoryChunk* source_chunk,
 
     if (kModeMask & kDoGenerationalOrShared) {
       if (Heap::InYoungGeneration(value_heap_object)) {
-        RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(
-            source_page_metadata, source_chunk->Offset(slot.address()));
+        if (card_table) {
+          card_table->Mark(source_chunk->Offset(slot.address()));
+        } else {
+          RememberedSet<OLD_TO_NEW>::Insert<AccessMode::NON_ATOMIC>(
+              source_page_metadata, source_chunk->Offset(slot.address()));
+        }
       } else if (InWritableSharedSpace(value_heap_object)) {
         RememberedSet<OLD_TO_SHARED>::Insert<AccessMode::ATOMIC>(
             source_page_metadata, source_chunk->Offset(slot.address()));
@@ -81,6 +81,7 @@ class BackingStore;
 class MemoryChunkMetadata;
 class Boolean;
 class CodeLargeObjectSpace;
+class CardTable;
 class CodeRange;
 class CollectionBarrier;
 class ConcurrentMarking;
@@ -1038,6 +1039,17 @@ class Heap final {
   static int InsertIntoRememberedSetFromCode(MutablePageMetadata* chunk,
                                              size_t slot_offset);
 
+  // Returns the card table that records the old-to-new slots of |page| with
+  // --old-to-new-card-marking, allocating it on first use, or nullptr if the
+  // slots go into the OLD_TO_NEW slot set. Only large plain FixedArrays and
+  // WeakFixedArrays, which consist of tagged slots only, use a card table.
+  // Main thread only.
+  static CardTable* OldToNewCardTableFor(MutablePageMetadata* page);
+
+  // Turns the dirty cards of all card tables into OLD_TO_NEW slots. Called
+  // before the OLD_TO_NEW remembered set is processed.
+  void FlushOldToNewCardTables();
+
 #ifdef DEBUG
   void VerifySlotRangeHasNoRecordedSlots(Address start, Address end);
 #endif
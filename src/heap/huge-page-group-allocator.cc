@@ -0,0 +1,179 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/huge-page-group-allocator.h"
+
+#include "src/base/bits.h"
+#include "src/base/macros.h"
+
+namespace v8 {
+namespace internal {
+
+HugePageGroupAllocator::HugePageGroupAllocator(
+    v8::PageAllocator* page_allocator, bool use_explicit_huge_pages)
+    : page_allocator_(page_allocator),
+      use_explicit_huge_pages_(use_explicit_huge_pages) {
+  DCHECK_NOT_NULL(page_allocator_);
+  DCHECK(IsAligned(kGroupSize, page_allocator_->AllocatePageSize()));
+}
+
+HugePageGroupAllocator::~HugePageGroupAllocator() {
+  // All pages are freed before the heap tears down its allocators.
+  DCHECK(groups_.empty());
+}
+
+bool HugePageGroupAllocator::IsInGroup(Address address,
+                                       Address* group_start) const {
+  Address start = RoundDown(address, kGroupSize);
+  if (groups_.find(start) == groups_.end()) return false;
+  *group_start = start;
+  return true;
+}
+
+bool HugePageGroupAllocator::AddGroup(void* hint) {
+  void* start = page_allocator_->AllocatePages(
+      AlignedAddress(hint, kGroupSize), kGroupSize, kGroupSize,
+      PageAllocator::kReadWrite);
+  if (start == nullptr) return false;
+  Group group;
+  group.backing = base::OS::RequestHugePages(start, kGroupSize,
+                                             use_explicit_huge_pages_);
+  groups_.emplace(reinterpret_cast<Address>(start), group);
+  groups_with_free_pages_.insert(reinterpret_cast<Address>(start));
+  return true;
+}
+
+void* HugePageGroupAllocator::AllocatePages(void* hint, size_t size,
+                                            size_t alignment,
+                                            Permission access) {
+  if (size != kPageSize || kPageSize % alignment != 0 ||
+      access != PageAllocator::kReadWrite) {
+    return page_allocator_->AllocatePages(hint, size, alignment, access);
+  }
+  {
+    base::MutexGuard guard(&mutex_);
+    if (!groups_with_free_pages_.empty() || AddGroup(hint)) {
+      Address start = *groups_with_free_pages_.begin();
+      Group& group = groups_[start];
+      uint32_t index = base::bits::CountTrailingZeros(~group.used_pages);
+      DCHECK_LT(index, kPagesPerGroup);
+      group.used_pages |= uint32_t{1} << index;
+      if (group.used_pages == (uint64_t{1} << kPagesPerGroup) - 1) {
+        groups_with_free_pages_.erase(start);
+      }
+      return reinterpret_cast<void*>(start + index * kPageSize);
+    }
+  }
+  // There is no room for another group, but there may still be room for a
+  // single page.
+  return page_allocator_->AllocatePages(hint, size, alignment, access);
+}
+
+bool HugePageGroupAllocator::FreePages(void* address, size_t size) {
+  Address start;
+  {
+    base::MutexGuard guard(&mutex_);
+    if (IsInGroup(reinterpret_cast<Address>(address), &start)) {
+      DCHECK_EQ(size, kPageSize);
+      Group& group = groups_[start];
+      uint32_t index = static_cast<uint32_t>(
+          (reinterpret_cast<Address>(address) - start) / kPageSize);
+      DCHECK_NE(0, group.used_pages & (uint32_t{1} << index));
+      group.used_pages &= ~(uint32_t{1} << index);
+      if (group.used_pages != 0) {
+        groups_with_free_pages_.insert(start);
+        return true;
+      }
+      bool is_explicit =
+          group.backing == base::OS::HugePageBacking::kExplicit;
+      groups_.erase(start);
+      groups_with_free_pages_.erase(start);
+      if (is_explicit) {
+        // Replace the hugetlbfs mapping with a regular one before the
+        // underlying allocator reuses the range.
+        CHECK(page_allocator_->DecommitPages(reinterpret_cast<void*>(start),
+                                             kGroupSize));
+      }
+      return page_allocator_->FreePages(reinterpret_cast<void*>(start),
+                                        kGroupSize);
+    }
+  }
+  return page_allocator_->FreePages(address, size);
+}
+
+bool HugePageGroupAllocator::ReleasePages(void* address, size_t size,
+                                          size_t new_size) {
+  {
+    base::MutexGuard guard(&mutex_);
+    Address start;
+    // Only large pages are shrunk, and those never come from a group.
+    // Releasing the tail of a group page would hand memory that the group
+    // still owns back to the underlying allocator.
+    CHECK(!IsInGroup(reinterpret_cast<Address>(address), &start));
+  }
+  return page_allocator_->ReleasePages(address, size, new_size);
+}
+
+bool HugePageGroupAllocator::SetPermissions(void* address, size_t size,
+                                            Permission access) {
+  if (access == PageAllocator::kReadWrite) {
+    base::MutexGuard guard(&mutex_);
+    Address start;
+    // Group pages are always read-writable, and changing the permissions
+    // would split the huge page.
+    if (IsInGroup(reinterpret_cast<Address>(address), &start)) return true;
+  }
+  return page_allocator_->SetPermissions(address, size, access);
+}
+
+bool HugePageGroupAllocator::RecommitPages(void* address, size_t size,
+                                           Permission access) {
+  if (access == PageAllocator::kReadWrite) {
+    base::MutexGuard guard(&mutex_);
+    Address start;
+    if (IsInGroup(reinterpret_cast<Address>(address), &start)) return true;
+  }
+  return page_allocator_->RecommitPages(address, size, access);
+}
+
+bool HugePageGroupAllocator::DiscardSystemPages(void* address, size_t size) {
+  {
+    base::MutexGuard guard(&mutex_);
+    Address start;
+    // Discarding is only a hint. Keep the huge page intact instead; its
+    // memory is returned when the whole group is freed.
+    if (IsInGroup(reinterpret_cast<Address>(address), &start)) return true;
+  }
+  return page_allocator_->DiscardSystemPages(address, size);
+}
+
+bool HugePageGroupAllocator::DecommitPages(void* address, size_t size) {
+#ifdef DEBUG
+  {
+    base::MutexGuard guard(&mutex_);
+    Address start;
+    // Regular pages are freed rather than decommitted.
+    DCHECK(!IsInGroup(reinterpret_cast<Address>(address), &start));
+  }
+#endif  // DEBUG
+  return page_allocator_->DecommitPages(address, size);
+}
+
+size_t HugePageGroupAllocator::NumberOfGroups() const {
+  base::MutexGuard guard(&mutex_);
+  return groups_.size();
+}
+
+size_t HugePageGroupAllocator::NumberOfFreePages() const {
+  base::MutexGuard guard(&mutex_);
+  size_t free_pages = 0;
+  for (const auto& [start, group] : groups_) {
+    free_pages +=
+        kPagesPerGroup - base::bits::CountPopulation(group.used_pages);
+  }
+  return free_pages;
+}
+
+}  // namespace internal
+}  // namespace v8
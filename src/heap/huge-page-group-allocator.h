@@ -0,0 +1,123 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_HEAP_HUGE_PAGE_GROUP_ALLOCATOR_H_
+#define V8_HEAP_HUGE_PAGE_GROUP_ALLOCATOR_H_
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+#include "include/v8-platform.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
+#include "src/common/globals.h"
+
+namespace v8 {
+namespace internal {
+
+// A page allocator that carves regular heap pages out of 2 MB-aligned groups,
+// which are backed by transparent huge pages or, if requested and available,
+// by hugetlbfs pages. This makes the pages of a large heap share TLB entries,
+// which benefits the marker and the sweeper that walk all of them.
+//
+// Pages in a group stay committed when they are freed, as discarding them
+// would split the huge page, and are handed out again before any new group is
+// reserved. A group is only returned to the underlying allocator once all of
+// its pages are free. All other requests, e.g. for large pages, are forwarded
+// to the underlying allocator.
+class V8_EXPORT_PRIVATE HugePageGroupAllocator final
+    : public v8::PageAllocator {
+ public:
+  static constexpr size_t kGroupSize = size_t{2} * MB;
+  static constexpr size_t kPageSize = size_t{1} << kPageSizeBits;
+  static constexpr size_t kPagesPerGroup = kGroupSize / kPageSize;
+  static_assert(kGroupSize % kPageSize == 0);
+  static_assert(kPagesPerGroup <= 32);
+
+  HugePageGroupAllocator(v8::PageAllocator* page_allocator,
+                         bool use_explicit_huge_pages);
+  HugePageGroupAllocator(const HugePageGroupAllocator&) = delete;
+  HugePageGroupAllocator& operator=(const HugePageGroupAllocator&) = delete;
+  ~HugePageGroupAllocator() override;
+
+  size_t AllocatePageSize() override {
+    return page_allocator_->AllocatePageSize();
+  }
+
+  size_t CommitPageSize() override { return page_allocator_->CommitPageSize(); }
+
+  void SetRandomMmapSeed(int64_t seed) override {
+    page_allocator_->SetRandomMmapSeed(seed);
+  }
+
+  void* GetRandomMmapAddr() override {
+    return page_allocator_->GetRandomMmapAddr();
+  }
+
+  void* AllocatePages(void* hint, size_t size, size_t alignment,
+                      Permission access) override;
+
+  bool FreePages(void* address, size_t size) override;
+
+  bool ReleasePages(void* address, size_t size, size_t new_size) override;
+
+  bool SetPermissions(void* address, size_t size, Permission access) override;
+
+  bool RecommitPages(void* address, size_t size, Permission access) override;
+
+  bool DiscardSystemPages(void* address, size_t size) override;
+
+  bool DecommitPages(void* address, size_t size) override;
+
+  bool SealPages(void* address, size_t size) override {
+    return page_allocator_->SealPages(address, size);
+  }
+
+  bool ReserveForSharedMemoryMapping(void* address, size_t size) override {
+    return page_allocator_->ReserveForSharedMemoryMapping(address, size);
+  }
+
+  bool CanAllocateSharedPages() override {
+    return page_allocator_->CanAllocateSharedPages();
+  }
+
+  std::unique_ptr<SharedMemory> AllocateSharedPages(
+      size_t size, const void* original_address) override {
+    return page_allocator_->AllocateSharedPages(size, original_address);
+  }
+
+  // Number of groups that are currently reserved.
+  size_t NumberOfGroups() const;
+
+  // Number of pages in these groups that are not in use.
+  size_t NumberOfFreePages() const;
+
+ private:
+  struct Group {
+    // Bit i is set if the i-th page of the group is in use.
+    uint32_t used_pages = 0;
+    base::OS::HugePageBacking backing = base::OS::HugePageBacking::kNone;
+  };
+
+  // Returns whether |address| lies in a group, and the group's start address.
+  bool IsInGroup(Address address, Address* group_start) const;
+  // Reserves a new group and adds it to groups_with_free_pages_.
+  bool AddGroup(void* hint);
+
+  v8::PageAllocator* const page_allocator_;
+  const bool use_explicit_huge_pages_;
+
+  mutable base::Mutex mutex_;
+  std::unordered_map<Address, Group> groups_;
+  // Groups that are not full. New pages are taken from the group with the
+  // lowest address, which lets groups at higher addresses drain.
+  std::set<Address> groups_with_free_pages_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_HEAP_HUGE_PAGE_GROUP_ALLOCATOR_H_
@@ -23,6 +23,7 @@
 #include "src/heap/heap.h"
 #include "src/heap/incremental-marking-job.h"
 #include "src/heap/mark-compact.h"
+#include "src/heap/marking-barrier-inl.h"
 #include "src/heap/marking-barrier.h"
 #include "src/heap/marking-visitor-inl.h"
 #include "src/heap/marking-visitor.h"
@@ -31,6 +32,7 @@
 #include "src/heap/mutable-page-metadata.h"
 #include "src/heap/objects-visiting-inl.h"
 #include "src/heap/objects-visiting.h"
+#include "src/heap/remembered-set-inl.h"
 #include "src/heap/safepoint.h"
 #include "src/init/v8.h"
 #include "src/logging/runtime-call-stats-scope.h"
@@ -38,6 +40,7 @@
 #include "src/objects/data-handler-inl.h"
 #include "src/objects/slots-inl.h"
 #include "src/objects/visitors.h"
+#include "src/tasks/cancelable-task.h"
 #include "src/tracing/trace-event.h"
 #include "src/utils/utils.h"
 
@@ -249,6 +252,110 @@ void IncrementalMarking::MarkRoots() {
 
 void IncrementalMarking::MarkRootsForTesting() { MarkRoots(); }
 
+namespace {
+
+class ClientMarkingTask final : public CancelableTask {
+ public:
+  explicit ClientMarkingTask(Heap* heap)
+      : CancelableTask(heap->isolate()), heap_(heap) {}
+
+  ~ClientMarkingTask() override = default;
+  ClientMarkingTask(const ClientMarkingTask&) = delete;
+  ClientMarkingTask& operator=(const ClientMarkingTask&) = delete;
+
+ private:
+  // v8::internal::CancelableTask overrides.
+  void RunInternal() override {
+    heap_->incremental_marking()->MarkSharedObjectsFromClientHeap();
+  }
+
+  Heap* heap_;
+};
+
+}  // namespace
+
+void IncrementalMarking::MarkSharedObjectsFromClientHeap() {
+  DCHECK(isolate()->has_shared_space());
+  DCHECK(!isolate()->is_shared_space_isolate());
+
+  MarkingBarrier* marking_barrier =
+      heap_->main_thread_local_heap()->marking_barrier();
+  // Shared marking may have been finalized before this task ran. The barrier
+  // is only deactivated in a global safepoint, which can't be entered while
+  // the main thread is running here.
+  if (!marking_barrier->is_shared_activated()) return;
+  // This heap's own concurrent markers may record slots in the remembered
+  // sets. Leave those to the atomic pause of the shared heap.
+  if (IsMarking()) return;
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  // Background threads of this isolate may insert into the remembered sets.
+  // Only this isolate needs to be stopped for that.
+  IsolateSafepointScope safepoint_scope(heap_);
+
+  // All slots are kept here. The atomic pause iterates the remembered sets
+  // again for correctness, filters stale slots and also covers pages that are
+  // still being swept, which are skipped here.
+  PtrComprCageBase cage_base(isolate());
+  Heap* heap = heap_;
+  size_t marked_slots = 0;
+  OldGenerationMemoryChunkIterator chunk_iterator(heap);
+  for (MutablePageMetadata* chunk = chunk_iterator.next(); chunk;
+       chunk = chunk_iterator.next()) {
+    if (!chunk->SweepingDone()) continue;
+
+    RememberedSet<OLD_TO_SHARED>::Iterate(
+        chunk,
+        [marking_barrier, cage_base, &marked_slots](MaybeObjectSlot slot) {
+          Tagged<MaybeObject> obj = slot.Relaxed_Load(cage_base);
+          Tagged<HeapObject> heap_object;
+          if (obj.GetHeapObject(&heap_object) &&
+              InWritableSharedSpace(heap_object)) {
+            marking_barrier->MarkValueShared(heap_object);
+            marked_slots++;
+          }
+          return KEEP_SLOT;
+        },
+        SlotSet::KEEP_EMPTY_BUCKETS);
+
+    RememberedSet<OLD_TO_SHARED>::IterateTyped(
+        chunk, [marking_barrier, heap, &marked_slots](SlotType slot_type,
+                                                      Address slot) {
+          Tagged<HeapObject> heap_object =
+              UpdateTypedSlotHelper::GetTargetObject(heap, slot_type, slot);
+          if (InWritableSharedSpace(heap_object)) {
+            marking_barrier->MarkValueShared(heap_object);
+            marked_slots++;
+          }
+          return KEEP_SLOT;
+        });
+
+    RememberedSet<TRUSTED_TO_SHARED_TRUSTED>::Iterate(
+        chunk,
+        [marking_barrier, &marked_slots](MaybeObjectSlot slot) {
+          ProtectedPointerSlot protected_slot(slot.address());
+          Tagged<MaybeObject> obj = protected_slot.Relaxed_Load();
+          Tagged<HeapObject> heap_object;
+          if (obj.GetHeapObject(&heap_object) &&
+              InWritableSharedSpace(heap_object)) {
+            marking_barrier->MarkValueShared(heap_object);
+            marked_slots++;
+          }
+          return KEEP_SLOT;
+        },
+        SlotSet::KEEP_EMPTY_BUCKETS);
+  }
+
+  // Make the objects available to the shared heap's concurrent markers.
+  marking_barrier->PublishSharedIfNeeded();
+
+  if (v8_flags.trace_incremental_marking) {
+    isolate()->PrintWithTimestamp(
+        "[IncrementalMarking] Client marking: %zu slots in %.1fms\n",
+        marked_slots, (base::TimeTicks::Now() - start).InMillisecondsF());
+  }
+}
+
 void IncrementalMarking::StartMarkingMajor() {
   if (isolate()->serializer_enabled()) {
     // Black allocation currently starts when we start incremental marking,
@@ -285,6 +392,18 @@ void IncrementalMarking::StartMarkingMajor() {
   MarkingBarrier::ActivateAll(heap(), is_compacting_);
   isolate()->traced_handles()->SetIsMarking(true);
 
+  if (v8_flags.incremental_client_marking &&
+      isolate()->is_shared_space_isolate()) {
+    // Clients pre-mark the shared objects referenced from their remembered
+    // sets. This only moves tracing work ahead of the atomic pause, which
+    // still runs in a global safepoint and rescans every client.
+    isolate()->global_safepoint()->IterateClientIsolates([](Isolate* client) {
+      if (client->is_shared_space_isolate()) return;
+      client->heap()->GetForegroundTaskRunner()->PostTask(
+          std::make_unique<ClientMarkingTask>(client->heap()));
+    });
+  }
+
   StartBlackAllocation();
 
   {
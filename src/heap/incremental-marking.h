@@ -136,6 +136,13 @@ class V8_EXPORT_PRIVATE IncrementalMarking final {
 
   void MarkRootsForTesting();
 
+  // Called on a client isolate while the shared space isolate is marking.
+  // Marks shared objects referenced from this heap's remembered sets without
+  // stopping the other isolates, so that the shared heap's concurrent markers
+  // can trace from them early. The atomic pause still stops all clients in a
+  // global safepoint and rescans their roots and remembered sets.
+  void MarkSharedObjectsFromClientHeap();
+
   // Performs incremental marking step for unit tests.
   void AdvanceForTesting(v8::base::TimeDelta max_duration,
                          size_t max_bytes_to_mark = SIZE_MAX);
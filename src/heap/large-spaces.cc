@@ -190,6 +190,23 @@ void OldLargeObjectSpace::PromoteNewLargeObject(LargePageMetadata* page) {
   AddPage(page, static_cast<size_t>(page->GetObject()->Size(cage_base)));
 }
 
+void OldLargeObjectSpace::ReplacePage(LargePageMetadata* page,
+                                      LargePageMetadata* new_page) {
+  DCHECK_EQ(page->owner(), this);
+  DCHECK_EQ(new_page->owner(), this);
+  DCHECK_EQ(page->Chunk()->Offset(page->area_start()),
+            new_page->Chunk()->Offset(new_page->area_start()));
+  RemovePage(page);
+  // The object was already accounted for in |objects_size_|.
+  AddPage(new_page, 0);
+  ForAll<ExternalBackingStoreType>(
+      [page, new_page](ExternalBackingStoreType type, int index) {
+        new_page->IncrementExternalBackingStoreBytes(
+            type, page->ExternalBackingStoreBytes(type));
+      });
+  if (page->ProgressBar().IsEnabled()) new_page->ProgressBar().Enable();
+}
+
 void LargeObjectSpace::AddPage(LargePageMetadata* page, size_t object_size) {
   size_ += static_cast<int>(page->size());
   AccountCommitted(page->size());
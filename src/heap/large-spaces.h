@@ -150,6 +150,10 @@ class OldLargeObjectSpace : public LargeObjectSpace {
 
   void PromoteNewLargeObject(LargePageMetadata* page);
 
+  // Replaces |page| by |new_page|, to which the mark-compact collector moved
+  // the object of |page|. The caller is responsible for freeing |page|.
+  void ReplacePage(LargePageMetadata* page, LargePageMetadata* new_page);
+
  protected:
   explicit OldLargeObjectSpace(Heap* heap, AllocationSpace id);
   V8_WARN_UNUSED_RESULT AllocationResult AllocateRaw(LocalHeap* local_heap,
@@ -46,7 +46,8 @@ MainAllocator::MainAllocator(LocalHeap* local_heap, SpaceWithLinearArea* space,
                                                   : &owned_allocation_info_),
       allocator_policy_(space->CreateAllocatorPolicy(this)),
       supports_extending_lab_(allocator_policy_->SupportsExtendingLAB()),
-      black_allocation_(ComputeBlackAllocation(is_new_generation)) {
+      black_allocation_(ComputeBlackAllocation(is_new_generation)),
+      max_lab_size_(0) {
   CHECK_NOT_NULL(local_heap_);
   if (local_heap_->is_main_thread()) {
     allocation_counter_.emplace();
@@ -54,14 +55,16 @@ MainAllocator::MainAllocator(LocalHeap* local_heap, SpaceWithLinearArea* space,
   }
 }
 
-MainAllocator::MainAllocator(Heap* heap, SpaceWithLinearArea* space, InGCTag)
+MainAllocator::MainAllocator(Heap* heap, SpaceWithLinearArea* space, InGCTag,
+                             size_t max_lab_size)
     : local_heap_(nullptr),
       isolate_heap_(heap),
       space_(space),
       allocation_info_(&owned_allocation_info_),
       allocator_policy_(space->CreateAllocatorPolicy(this)),
       supports_extending_lab_(false),
-      black_allocation_(BlackAllocation::kAlwaysDisabled) {
+      black_allocation_(BlackAllocation::kAlwaysDisabled),
+      max_lab_size_(max_lab_size) {
   DCHECK(!allocation_counter_.has_value());
   DCHECK(!linear_area_original_data_.has_value());
 }
@@ -351,8 +354,14 @@ Address MainAllocator::ComputeLimit(Address start, Address end,
                                     size_t min_size) const {
   DCHECK_GE(end - start, min_size);
 
-  // Use the full LAB when allocation observers aren't enabled.
-  if (!SupportsAllocationObserver()) return end;
+  // Use the full LAB when allocation observers aren't enabled, unless the LAB
+  // size was explicitly bounded.
+  if (!SupportsAllocationObserver()) {
+    if (max_lab_size_ == 0) return end;
+    return start + std::max(std::min(static_cast<size_t>(end - start),
+                                     max_lab_size_),
+                            min_size);
+  }
 
   // LABs with allocation observers are only used outside GC and on the main
   // thread.
@@ -160,9 +160,11 @@ class MainAllocator {
       IsNewGeneration is_new_generation,
       LinearAllocationArea* allocation_info = nullptr);
 
-  // Use this constructor for GC LABs/allocations.
+  // Use this constructor for GC LABs/allocations. A non-zero `max_lab_size`
+  // bounds the size of the LABs taken from the free list; the remainder is
+  // returned to the space right away.
   V8_EXPORT_PRIVATE MainAllocator(Heap* heap, SpaceWithLinearArea* space,
-                                  InGCTag);
+                                  InGCTag, size_t max_lab_size = 0);
 
   // Returns the allocation pointer in this space.
   Address start() const { return allocation_info_->start(); }
@@ -362,6 +364,7 @@ class MainAllocator {
 
   const bool supports_extending_lab_;
   const BlackAllocation black_allocation_;
+  const size_t max_lab_size_;
 
   friend class AllocatorPolicy;
   friend class PagedSpaceAllocatorPolicy;
@@ -7,6 +7,7 @@
 #include <algorithm>
 #include <atomic>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <unordered_map>
@@ -343,6 +344,12 @@ bool MarkCompactCollector::StartCompaction(StartCompactionMode mode) {
 
   CollectEvacuationCandidates(heap_->trusted_space());
 
+  bool compacting_large_objects = false;
+  if (v8_flags.compact_large_objects) {
+    compacting_large_objects =
+        CollectLargeEvacuationCandidates(heap_->lo_space());
+  }
+
   if (heap_->isolate()->AllowsCodeCompaction() &&
       (!heap_->IsGCWithStack() || v8_flags.compact_code_space_with_stack)) {
     CollectEvacuationCandidates(heap_->code_space());
@@ -350,7 +357,7 @@ bool MarkCompactCollector::StartCompaction(StartCompactionMode mode) {
     TraceFragmentation(heap_->code_space());
   }
 
-  compacting_ = !evacuation_candidates_.empty();
+  compacting_ = !evacuation_candidates_.empty() || compacting_large_objects;
   return compacting_;
 }
 
@@ -708,6 +715,70 @@ void MarkCompactCollector::CollectEvacuationCandidates(PagedSpace* space) {
   }
 }
 
+bool MarkCompactCollector::CollectLargeEvacuationCandidates(
+    OldLargeObjectSpace* space) {
+  DCHECK_EQ(LO_SPACE, space->identity());
+  // Bytes of large objects to select for evacuation. Every candidate needs a
+  // new page during evacuation, and slots pointing into it are recorded
+  // during marking.
+  const size_t kMaxEvacuatedBytesForReduceMemory = 128 * MB;
+  const size_t kMaxEvacuatedBytes = 32 * MB;
+  const size_t max_evacuated_bytes = heap_->ShouldReduceMemory()
+                                         ? kMaxEvacuatedBytesForReduceMemory
+                                         : kMaxEvacuatedBytes;
+
+  // Objects move to the lowest free region that fits them. Only objects that
+  // lie above the range that all pages would occupy if they were packed from
+  // the lowest page upwards can free up address space by moving, and those at
+  // the highest addresses are selected first.
+  std::vector<LargePageMetadata*> pages;
+  Address lowest_page = kNullAddress;
+  size_t total_size = 0;
+  for (LargePageMetadata* page : *space) {
+    total_size += page->size();
+    if (lowest_page == kNullAddress || page->ChunkAddress() < lowest_page) {
+      lowest_page = page->ChunkAddress();
+    }
+    MemoryChunk* chunk = page->Chunk();
+    if (chunk->NeverEvacuate() || chunk->IsPinned()) continue;
+    pages.push_back(page);
+  }
+  const Address packed_end = lowest_page + total_size;
+  std::sort(pages.begin(), pages.end(),
+            [](const LargePageMetadata* a, const LargePageMetadata* b) {
+              return a->ChunkAddress() > b->ChunkAddress();
+            });
+
+  size_t evacuated_bytes = 0;
+  for (LargePageMetadata* page : pages) {
+    if (page->ChunkAddress() < packed_end) break;
+    if (!v8_flags.compact_on_every_full_gc &&
+        evacuated_bytes + page->size() > max_evacuated_bytes) {
+      continue;
+    }
+    MemoryChunk* chunk = page->Chunk();
+    CHECK(!chunk->IsEvacuationCandidate());
+    CHECK_NULL(page->slot_set<OLD_TO_OLD>());
+    CHECK_NULL(page->typed_slot_set<OLD_TO_OLD>());
+    if (v8_flags.trace_evacuation_candidates) {
+      PrintIsolate(heap_->isolate(),
+                   "Large evacuation candidate: Area size: %zu.\n",
+                   page->area_size());
+    }
+    chunk->SetFlagSlow(MemoryChunk::EVACUATION_CANDIDATE);
+    evacuated_bytes += page->size();
+  }
+
+  if (v8_flags.trace_fragmentation) {
+    PrintIsolate(heap_->isolate(),
+                 "compaction-selection: space=%s reduce_memory=%d "
+                 "total_size=%zu evacuated_bytes=%zu\n",
+                 ToString(space->identity()), heap_->ShouldReduceMemory(),
+                 total_size / KB, evacuated_bytes / KB);
+  }
+  return evacuated_bytes > 0;
+}
+
 void MarkCompactCollector::Prepare() {
 #ifdef DEBUG
   DCHECK(state_ == IDLE);
@@ -1735,6 +1806,33 @@ class EvacuateOldSpaceVisitor final : public EvacuateVisitorBase {
     }
     return false;
   }
+
+  // Moves the object of a large evacuation candidate to |target|, which is at
+  // the same offset on a freshly allocated large page. Whole OS pages of the
+  // object are remapped where the platform supports it, so only the part on
+  // the first page, which also holds the page header, is copied.
+  void MoveLargeObject(Tagged<HeapObject> object, Tagged<HeapObject> target,
+                       int size) {
+    const Address src_addr = object.address();
+    const Address dst_addr = target.address();
+    DCHECK_EQ(MemoryChunk::FromHeapObject(object)->Offset(src_addr),
+              MemoryChunk::FromHeapObject(target)->Offset(dst_addr));
+    const size_t commit_page_size = MemoryAllocator::GetCommitPageSize();
+    const Address src_pages = ::RoundUp(src_addr, commit_page_size);
+    const Address src_pages_end = ::RoundUp(src_addr + size, commit_page_size);
+    if (src_pages < src_pages_end &&
+        base::OS::MovePages(
+            reinterpret_cast<void*>(src_pages), src_pages_end - src_pages,
+            reinterpret_cast<void*>(dst_addr + (src_pages - src_addr)))) {
+      heap_->CopyBlock(dst_addr, src_addr,
+                       static_cast<int>(src_pages - src_addr));
+    } else {
+      heap_->CopyBlock(dst_addr, src_addr, size);
+    }
+    ExecuteMigrationObservers(LO_SPACE, object, target, size);
+    target->IterateFast(target->map(cage_base()), size, record_visitor_);
+    object->set_map_word_forwarded(target, kRelaxedStore);
+  }
 };
 
 class EvacuateRecordOnlyVisitor final : public HeapObjectVisitor {
@@ -2196,8 +2294,15 @@ std::pair<size_t, size_t> MarkCompactCollector::ProcessMarkingWorklist(
         GarbageCollector::MARK_COMPACTOR, TaskPriority::kUserBlocking);
   }
 
-  while (local_marking_worklists_->Pop(&object) ||
-         local_marking_worklists_->PopOnHold(&object)) {
+  // Per-context mode switches the active worklist based on the popped object,
+  // which doesn't mix with popping ahead.
+  MarkingPrefetchQueue prefetch_queue(
+      is_per_context_mode ? 0 : v8_flags.marking_prefetch_distance);
+  auto pop = [this](Tagged<HeapObject>* object) {
+    return local_marking_worklists_->Pop(object) ||
+           local_marking_worklists_->PopOnHold(object);
+  };
+  while (prefetch_queue.Pop(&object, pop)) {
     // The marking worklist should never contain filler objects.
     CHECK(!IsFreeSpaceOrFiller(object, cage_base));
     DCHECK(IsHeapObject(object));
@@ -2239,6 +2344,11 @@ std::pair<size_t, size_t> MarkCompactCollector::ProcessMarkingWorklist(
       break;
     }
   }
+  prefetch_queue.Flush([this](Tagged<HeapObject> object) {
+    local_marking_worklists_->Push(object);
+  });
+  heap_->tracer()->AddMarkingPrefetchedObjects(
+      prefetch_queue.prefetched_objects());
   return std::make_pair(bytes_processed, objects_processed);
 }
 
@@ -4361,6 +4471,7 @@ class Evacuator final : public Malloced {
     kObjectsNewToOld,
     kPageNewToOld,
     kObjectsOldToOld,
+    kLargeObjectOldToOld,
   };
 
   static const char* EvacuationModeName(EvacuationMode mode) {
@@ -4371,6 +4482,8 @@ class Evacuator final : public Malloced {
         return "page-new-to-old";
       case kObjectsOldToOld:
         return "objects-old-to-old";
+      case kLargeObjectOldToOld:
+        return "large-object-old-to-old";
     }
   }
 
@@ -4379,6 +4492,10 @@ class Evacuator final : public Malloced {
     if (chunk->IsFlagSet(MemoryChunk::PAGE_NEW_OLD_PROMOTION))
       return kPageNewToOld;
     if (chunk->InYoungGeneration()) return kObjectsNewToOld;
+    if (chunk->IsLargePage()) {
+      DCHECK(chunk->IsEvacuationCandidate());
+      return kLargeObjectOldToOld;
+    }
     return kObjectsOldToOld;
   }
 
@@ -4571,6 +4688,16 @@ bool Evacuator::RawEvacuatePage(MutablePageMetadata* page) {
       }
       break;
     }
+    case kLargeObjectOldToOld: {
+      LargePageMetadata* large_page = LargePageMetadata::cast(page);
+      LargePageMetadata* target_page =
+          heap_->mark_compact_collector()->large_page_relocations_.at(
+              large_page);
+      Tagged<HeapObject> object = large_page->GetObject();
+      old_space_visitor_.MoveLargeObject(object, target_page->GetObject(),
+                                         object->Size());
+      break;
+    }
   }
 
   return true;
@@ -4738,6 +4865,52 @@ void TraceEvacuation(Isolate* isolate, size_t pages_count,
 
 }  // namespace
 
+void MarkCompactCollector::PrepareLargePageEvacuation() {
+  DCHECK(large_page_relocations_.empty());
+  OldLargeObjectSpace* space = heap_->lo_space();
+  PtrComprCageBase cage_base(heap_->isolate());
+  // Objects may only move if all pointers to them are known.
+  const bool keep_in_place =
+      heap_->IsGCWithStack() && !v8_flags.compact_with_stack;
+  std::vector<LargePageMetadata*> aborted_pages;
+  // Objects of at least this size did not find a lower page, so they are not
+  // tried. This avoids committing pages that are freed again right away.
+  size_t failed_size = std::numeric_limits<size_t>::max();
+  for (LargePageMetadata* page : *space) {
+    MemoryChunk* chunk = page->Chunk();
+    if (!chunk->IsEvacuationCandidate()) continue;
+
+    LargePageMetadata* target_page = nullptr;
+    const size_t object_size = page->GetObject()->Size(cage_base);
+    if (!keep_in_place && object_size < failed_size) {
+      target_page = heap_->memory_allocator()->AllocateLargePage(
+          space, object_size, NOT_EXECUTABLE);
+      // Moving the object only reduces fragmentation if the new page is at a
+      // lower address.
+      if (target_page && target_page->ChunkAddress() > page->ChunkAddress()) {
+        heap_->memory_allocator()->Free(
+            MemoryAllocator::FreeMode::kImmediately, target_page);
+        target_page = nullptr;
+      }
+      if (!target_page) failed_size = object_size;
+    }
+    if (target_page) {
+      large_page_relocations_.emplace(page, target_page);
+    } else {
+      chunk->ClearFlagSlow(MemoryChunk::EVACUATION_CANDIDATE);
+      aborted_pages.push_back(page);
+    }
+  }
+
+  // Slots of objects on evacuation candidates are not recorded during
+  // marking, so record them now for the objects that stay in place.
+  EvacuateRecordOnlyVisitor record_visitor(heap_);
+  for (LargePageMetadata* page : aborted_pages) {
+    Tagged<HeapObject> object = page->GetObject();
+    record_visitor.Visit(object, object->Size(cage_base));
+  }
+}
+
 void MarkCompactCollector::EvacuatePagesInParallel() {
   std::vector<std::pair<ParallelWorkItem, MutablePageMetadata*>>
       evacuation_items;
@@ -4808,6 +4981,11 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
     evacuation_items.emplace_back(ParallelWorkItem{}, page);
   }
 
+  PrepareLargePageEvacuation();
+  for (const auto& relocation : large_page_relocations_) {
+    evacuation_items.emplace_back(ParallelWorkItem{}, relocation.first);
+  }
+
   // Promote young generation large objects.
   if (auto* new_lo_space = heap_->new_lo_space()) {
     for (auto it = new_lo_space->begin(); it != new_lo_space->end();) {
@@ -4837,6 +5015,13 @@ void MarkCompactCollector::EvacuatePagesInParallel() {
 
   const size_t aborted_pages = PostProcessAbortedEvacuationCandidates();
 
+  // Moved large objects are found through their new pages from now on. The
+  // old pages stay mapped until pointers are updated, as their first page
+  // holds the forwarding addresses.
+  for (const auto& [page, target_page] : large_page_relocations_) {
+    heap_->lo_space()->ReplacePage(page, target_page);
+  }
+
   if (v8_flags.trace_evacuation) {
     TraceEvacuation(heap_->isolate(), pages_count, wanted_num_tasks, live_bytes,
                     aborted_pages);
@@ -5732,6 +5917,11 @@ void MarkCompactCollector::ReleaseEvacuationCandidates() {
     space->ReleasePage(p);
   }
   old_space_evacuation_pages_.clear();
+  for (const auto& relocation : large_page_relocations_) {
+    heap_->memory_allocator()->Free(MemoryAllocator::FreeMode::kPostpone,
+                                    relocation.first);
+  }
+  large_page_relocations_.clear();
   compacting_ = false;
 }
 
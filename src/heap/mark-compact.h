@@ -5,6 +5,7 @@
 #ifndef V8_HEAP_MARK_COMPACT_H_
 #define V8_HEAP_MARK_COMPACT_H_
 
+#include <unordered_map>
 #include <vector>
 
 #include "include/v8-internal.h"
@@ -26,6 +27,7 @@ class LargeObjectSpace;
 class LargePageMetadata;
 class MainMarkingVisitor;
 class MarkCompactCollector;
+class OldLargeObjectSpace;
 class RecordMigratedSlotVisitor;
 
 class RootMarkingVisitor final : public RootVisitor {
@@ -92,6 +94,11 @@ class MarkCompactCollector final {
 
   void AddEvacuationCandidate(PageMetadata* p);
 
+  // Marks the pages of the old large object space whose objects are likely to
+  // free up address space when moved to lower addresses, up to a byte budget.
+  // Returns whether any page was selected.
+  bool CollectLargeEvacuationCandidates(OldLargeObjectSpace* space);
+
   // Prepares for GC by resetting relocation info in old and map spaces and
   // choosing spaces to compact.
   void Prepare();
@@ -358,6 +365,9 @@ class MarkCompactCollector final {
   void EvacuateEpilogue();
   void Evacuate();
   void EvacuatePagesInParallel();
+  // Allocates the pages that large evacuation candidates are moved to, and
+  // keeps objects for which no page at a lower address is available in place.
+  void PrepareLargePageEvacuation();
   void UpdatePointersAfterEvacuation();
 
   void ReleaseEvacuationCandidates();
@@ -430,6 +440,9 @@ class MarkCompactCollector final {
   std::vector<std::pair<Address, PageMetadata*>>
       aborted_evacuation_candidates_due_to_flags_;
   std::vector<LargePageMetadata*> promoted_large_pages_;
+  // Large evacuation candidates and the pages their objects are moved to.
+  std::unordered_map<LargePageMetadata*, LargePageMetadata*>
+      large_page_relocations_;
 
   MarkingState* const marking_state_;
   NonAtomicMarkingState* const non_atomic_marking_state_;
@@ -56,6 +56,13 @@ class MarkingBarrier {
   void WriteWithoutHost(Tagged<HeapObject> value);
 
   inline void MarkValue(Tagged<HeapObject> host, Tagged<HeapObject> value);
+  // Marks a shared object on behalf of a client isolate and pushes it onto the
+  // shared heap worklist. Only usable while shared marking is active.
+  inline void MarkValueShared(Tagged<HeapObject> value);
+
+  bool is_shared_activated() const {
+    return shared_heap_worklists_.has_value();
+  }
 
   bool is_minor() const { return marking_mode_ == MarkingMode::kMinorMarking; }
 
@@ -67,7 +74,6 @@ class MarkingBarrier {
 #endif  // DEBUG
 
  private:
-  inline void MarkValueShared(Tagged<HeapObject> value);
   inline void MarkValueLocal(Tagged<HeapObject> value);
 
   void RecordRelocSlot(Tagged<InstructionStream> host, RelocInfo* rinfo,
@@ -57,6 +57,7 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate,
                                  size_t capacity)
     : isolate_(isolate),
       data_page_allocator_(isolate->page_allocator()),
+      ungrouped_data_page_allocator_(isolate->page_allocator()),
       code_page_allocator_(code_page_allocator),
       trusted_page_allocator_(trusted_page_allocator),
       capacity_(RoundUp(capacity, PageMetadata::kPageSize)),
@@ -64,6 +65,11 @@ MemoryAllocator::MemoryAllocator(Isolate* isolate,
   DCHECK_NOT_NULL(data_page_allocator_);
   DCHECK_NOT_NULL(code_page_allocator_);
   DCHECK_NOT_NULL(trusted_page_allocator_);
+  if (v8_flags.huge_page_groups) {
+    huge_page_group_allocator_ = std::make_unique<HugePageGroupAllocator>(
+        data_page_allocator_, v8_flags.huge_page_groups_hugetlbfs);
+    data_page_allocator_ = huge_page_group_allocator_.get();
+  }
 }
 
 void MemoryAllocator::TearDown() {
@@ -81,7 +87,9 @@ void MemoryAllocator::TearDown() {
 
   code_page_allocator_ = nullptr;
   data_page_allocator_ = nullptr;
+  ungrouped_data_page_allocator_ = nullptr;
   trusted_page_allocator_ = nullptr;
+  huge_page_group_allocator_.reset();
 }
 
 void MemoryAllocator::Pool::ReleasePooledChunks() {
@@ -21,6 +21,7 @@
 #include "src/base/platform/semaphore.h"
 #include "src/common/globals.h"
 #include "src/heap/code-range.h"
+#include "src/heap/huge-page-group-allocator.h"
 #include "src/heap/memory-chunk-metadata.h"
 #include "src/heap/mutable-page-metadata.h"
 #include "src/heap/spaces.h"
@@ -228,6 +229,14 @@ class MemoryAllocator {
       case TRUSTED_LO_SPACE:
       case SHARED_TRUSTED_LO_SPACE:
         return trusted_page_allocator_;
+      case RO_SPACE:
+      case LO_SPACE:
+      case NEW_LO_SPACE:
+      case SHARED_LO_SPACE:
+        // Read-only pages may be shared with other isolates or outlive this
+        // allocator, and large pages may be shrunk, so neither comes from a
+        // huge page group.
+        return ungrouped_data_page_allocator_;
       default:
         return data_page_allocator_;
     }
@@ -393,11 +402,20 @@ class MemoryAllocator {
 
   Isolate* isolate_;
 
+  // Carves regular data pages out of huge page groups, see
+  // --huge-page-groups. Null if the flag is off.
+  std::unique_ptr<HugePageGroupAllocator> huge_page_group_allocator_;
+
   // Page allocator used for allocating data pages. Depending on the
   // configuration it may be a page allocator instance provided by v8::Platform
   // or a BoundedPageAllocator (when pointer compression is enabled).
   v8::PageAllocator* data_page_allocator_;
 
+  // Page allocator used for allocating read-only and large data pages. This
+  // is the page allocator of the isolate, even if regular data pages use huge
+  // page groups.
+  v8::PageAllocator* ungrouped_data_page_allocator_;
+
   // Page allocator used for allocating code pages. Depending on the
   // configuration it may be a page allocator instance provided by v8::Platform
   // or a BoundedPageAllocator from Heap::code_range_ (when pointer compression
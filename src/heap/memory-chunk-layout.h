@@ -18,6 +18,7 @@ namespace internal {
 
 class MarkingBitmap;
 class FreeListCategory;
+class CardTable;
 class Heap;
 class TypedSlotsSet;
 class SlotSet;
@@ -89,6 +90,7 @@ class V8_EXPORT_PRIVATE MemoryChunkLayout {
     FIELD(ActiveSystemPages*, ActiveSystemPages),
     FIELD(size_t, AllocatedLabSize),
     FIELD(size_t, AgeInNewSpace),
+    FIELD(CardTable*, CardTable),
     FIELD(MarkingBitmap, MarkingBitmap),
     kEndOfMarkingBitmap,
     kMutablePageMetadataStart = kSlotSetOffset,
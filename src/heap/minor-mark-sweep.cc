@@ -355,6 +355,10 @@ void MinorMarkSweepCollector::StartMarking(bool force_use_background_threads) {
   use_background_threads_in_cycle_ =
       force_use_background_threads || heap_->ShouldUseBackgroundThreads();
 
+  // The remembered sets are picked up below, so they need to include the
+  // slots that are only recorded in card tables so far.
+  heap_->FlushOldToNewCardTables();
+
   auto* cpp_heap = CppHeap::From(heap_->cpp_heap_);
   // CppHeap's marker must be initialized before the V8 marker to allow
   // exchanging of worklists.
@@ -146,6 +146,7 @@ void MutablePageMetadata::ReleaseAllocatedMemoryNeededForWritableChunk() {
   ReleaseTypedSlotSet(OLD_TO_NEW);
   ReleaseTypedSlotSet(OLD_TO_OLD);
   ReleaseTypedSlotSet(OLD_TO_SHARED);
+  ReleaseCardTable();
 
   if (!Chunk()->IsLargePage()) {
     PageMetadata* page = static_cast<PageMetadata*>(this);
@@ -157,6 +158,17 @@ void MutablePageMetadata::ReleaseAllAllocatedMemory() {
   ReleaseAllocatedMemoryNeededForWritableChunk();
 }
 
+CardTable* MutablePageMetadata::AllocateCardTable() {
+  DCHECK_NULL(card_table_);
+  card_table_ = CardTable::Allocate(size());
+  return card_table_;
+}
+
+void MutablePageMetadata::ReleaseCardTable() {
+  CardTable::Delete(card_table_);
+  card_table_ = nullptr;
+}
+
 SlotSet* MutablePageMetadata::AllocateSlotSet(RememberedSetType type) {
   SlotSet* new_slot_set = SlotSet::Allocate(buckets());
   SlotSet* old_slot_set = base::AsAtomicPointer::AcquireRelease_CompareAndSwap(
@@ -271,6 +283,9 @@ void MutablePageMetadata::ValidateOffsets(MutablePageMetadata* chunk) {
   DCHECK_EQ(reinterpret_cast<Address>(&chunk->age_in_new_space_) -
                 chunk->MetadataAddress(),
             MemoryChunkLayout::kAgeInNewSpaceOffset);
+  DCHECK_EQ(reinterpret_cast<Address>(&chunk->card_table_) -
+                chunk->MetadataAddress(),
+            MemoryChunkLayout::kCardTableOffset);
 }
 #endif
 
@@ -11,6 +11,7 @@
 #include "src/base/platform/mutex.h"
 #include "src/common/globals.h"
 #include "src/heap/base/active-system-pages.h"
+#include "src/heap/card-table.h"
 #include "src/heap/list.h"
 #include "src/heap/marking.h"
 #include "src/heap/memory-chunk-layout.h"
@@ -46,6 +47,7 @@ class MutablePageMetadata : public MemoryChunkMetadata {
 
   static const intptr_t kOldToNewSlotSetOffset =
       MemoryChunkLayout::kSlotSetOffset;
+  static const intptr_t kCardTableOffset = MemoryChunkLayout::kCardTableOffset;
 
   // Page size in bytes.  This must be a multiple of the OS page size.
   static const int kPageSize = kRegularPageSize;
@@ -161,6 +163,13 @@ class MutablePageMetadata : public MemoryChunkMetadata {
     return typed_slot_set;
   }
 
+  // Card table for the old-to-new slots of a large array, see
+  // Heap::OldToNewCardTableFor(). Only accessed by the main thread.
+  CardTable* card_table() const { return card_table_; }
+  CardTable* AllocateCardTable();
+  // Not safe to be called concurrently.
+  void ReleaseCardTable();
+
   int ComputeFreeListsLength();
 
   // Approximate amount of physical memory committed for this chunk.
@@ -331,6 +340,8 @@ class MutablePageMetadata : public MemoryChunkMetadata {
   // counter is reset to 0 whenever the page is empty.
   size_t age_in_new_space_ = 0;
 
+  CardTable* card_table_ = nullptr;
+
   MarkingBitmap marking_bitmap_;
 
  private:
@@ -4,6 +4,9 @@
 
 #include "src/heap/pretenuring-handler.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "src/common/globals.h"
 #include "src/execution/isolate.h"
 #include "src/flags/flags.h"
@@ -11,6 +14,9 @@
 #include "src/heap/gc-tracer-inl.h"
 #include "src/heap/new-spaces.h"
 #include "src/objects/allocation-site-inl.h"
+#include "src/objects/feedback-vector-inl.h"
+#include "src/objects/script-inl.h"
+#include "src/objects/shared-function-info-inl.h"
 
 namespace v8 {
 namespace internal {
@@ -289,7 +295,99 @@ void PretenuringHandler::PretenureAllocationSiteOnNextCollection(
   allocation_sites_to_pretenure_->Push(site);
 }
 
-void PretenuringHandler::reset() { allocation_sites_to_pretenure_.reset(); }
+void PretenuringHandler::RecordLiteralAllocationSite(
+    Tagged<FeedbackVector> vector, FeedbackSlot slot,
+    Tagged<AllocationSite> site) {
+  DCHECK(v8_flags.cache_pretenuring_decisions);
+  Tagged<SharedFunctionInfo> shared = vector->shared_function_info();
+  if (!IsScript(shared->script())) return;
+  if (literal_sites_.size() >= literal_sites_prune_limit_) {
+    literal_sites_.remove_if(
+        [](const LiteralSite& literal_site) { return !literal_site.site; });
+    literal_sites_prune_limit_ =
+        std::max(kMinLiteralSitesPruneLimit, 2 * literal_sites_.size());
+  }
+  Handle<AllocationSite> handle =
+      heap_->isolate()->global_handles()->Create(site);
+  literal_sites_.push_back({Cast<Script>(shared->script())->id(),
+                            shared->function_literal_id(), slot.ToInt(),
+                            handle.location()});
+  GlobalHandles::MakeWeak(&literal_sites_.back().site);
+}
+
+void PretenuringHandler::ExportPretenuringDecisions(
+    Tagged<Script> script, std::vector<uint32_t>* decisions) {
+  DisallowGarbageCollection no_gc;
+  std::unordered_map<Address, const LiteralSite*> literal_sites;
+  for (const LiteralSite& literal_site : literal_sites_) {
+    if (!literal_site.site || literal_site.script_id != script->id()) continue;
+    literal_sites.emplace(*literal_site.site, &literal_site);
+  }
+  if (literal_sites.empty()) return;
+  // Only top-level sites are linked into the list. Their nested sites, e.g.
+  // of arrays within an object literal, are identified by their depth.
+  for (Tagged<Object> current = heap_->allocation_sites_list();
+       IsAllocationSite(current);
+       current = Cast<AllocationSite>(current)->weak_next()) {
+    auto it = literal_sites.find(current.ptr());
+    if (it == literal_sites.end()) continue;
+    uint32_t depth = 0;
+    for (Tagged<Object> nested = current; IsAllocationSite(nested);
+         nested = Cast<AllocationSite>(nested)->nested_site(), ++depth) {
+      if (Cast<AllocationSite>(nested)->GetAllocationType() !=
+          AllocationType::kOld) {
+        continue;
+      }
+      decisions->push_back(
+          static_cast<uint32_t>(it->second->function_literal_id));
+      decisions->push_back(static_cast<uint32_t>(it->second->slot));
+      decisions->push_back(depth);
+    }
+  }
+}
+
+void PretenuringHandler::ImportPretenuringDecisions(
+    Tagged<Script> script, base::Vector<const uint32_t> decisions) {
+  DCHECK_EQ(0, decisions.size() % 3);
+  for (size_t i = 0; i + 2 < decisions.size(); i += 3) {
+    imported_pretenuring_decisions_.emplace(
+        script->id(), static_cast<int>(decisions[i]),
+        static_cast<int>(decisions[i + 1]), static_cast<int>(decisions[i + 2]));
+  }
+  if (V8_UNLIKELY(v8_flags.trace_pretenuring) && !decisions.empty()) {
+    heap_->isolate()->PrintWithTimestamp(
+        "Imported %zu pretenuring decisions for script %d\n",
+        decisions.size() / 3, script->id());
+  }
+}
+
+void PretenuringHandler::ApplyImportedPretenuringDecision(
+    Tagged<FeedbackVector> vector, FeedbackSlot slot,
+    Tagged<AllocationSite> site) {
+  Tagged<SharedFunctionInfo> shared = vector->shared_function_info();
+  if (!IsScript(shared->script())) return;
+  const int script_id = Cast<Script>(shared->script())->id();
+  int depth = 0;
+  for (Tagged<Object> nested = site; IsAllocationSite(nested);
+       nested = Cast<AllocationSite>(nested)->nested_site(), ++depth) {
+    auto it = imported_pretenuring_decisions_.find(
+        {script_id, shared->function_literal_id(), slot.ToInt(), depth});
+    if (it == imported_pretenuring_decisions_.end()) continue;
+    // Each decision is consumed by the first site created for it. Sites of
+    // closures created later start out undecided again.
+    imported_pretenuring_decisions_.erase(it);
+    Cast<AllocationSite>(nested)->set_pretenure_decision(
+        AllocationSite::kTenure);
+  }
+}
+
+void PretenuringHandler::reset() {
+  allocation_sites_to_pretenure_.reset();
+  for (const LiteralSite& literal_site : literal_sites_) {
+    if (literal_site.site) GlobalHandles::Destroy(literal_site.site);
+  }
+  literal_sites_.clear();
+}
 
 }  // namespace internal
 }  // namespace v8
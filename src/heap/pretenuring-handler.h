@@ -5,7 +5,13 @@
 #ifndef V8_HEAP_PRETENURING_HANDLER_H_
 #define V8_HEAP_PRETENURING_HANDLER_H_
 
+#include <list>
 #include <memory>
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include "src/base/vector.h"
 
 #include "src/objects/allocation-site.h"
 #include "src/objects/heap-object.h"
@@ -14,9 +20,12 @@
 namespace v8 {
 namespace internal {
 
+class FeedbackSlot;
+class FeedbackVector;
 template <typename T>
 class GlobalHandleVector;
 class Heap;
+class Script;
 
 class PretenuringHandler final {
  public:
@@ -75,6 +84,39 @@ class PretenuringHandler final {
     return !global_pretenuring_feedback_.empty();
   }
 
+  // ===========================================================================
+  // Cached pretenuring decisions. =============================================
+  // ===========================================================================
+
+  // Remembers that the freshly created top-level literal {site} is stored in
+  // {slot} of {vector}. The site is held weakly. Only called with
+  // --cache-pretenuring-decisions.
+  void RecordLiteralAllocationSite(Tagged<FeedbackVector> vector,
+                                   FeedbackSlot slot,
+                                   Tagged<AllocationSite> site);
+
+  // Appends a (function literal id, feedback slot, nesting depth) triple to
+  // {decisions} for every currently tenured site of the recorded literals of
+  // {script}, including nested sites.
+  void ExportPretenuringDecisions(Tagged<Script> script,
+                                  std::vector<uint32_t>* decisions);
+
+  // Remembers decisions exported for {script} by a previous run. Literal
+  // allocation sites are created lazily, so the decisions are only applied
+  // once the corresponding site is installed in its feedback vector.
+  void ImportPretenuringDecisions(Tagged<Script> script,
+                                  base::Vector<const uint32_t> decisions);
+
+  bool HasImportedPretenuringDecisions() const {
+    return !imported_pretenuring_decisions_.empty();
+  }
+
+  // Tenures the freshly created literal {site} stored in {slot} of {vector},
+  // and its nested sites, if decisions were imported for them.
+  void ApplyImportedPretenuringDecision(Tagged<FeedbackVector> vector,
+                                        FeedbackSlot slot,
+                                        Tagged<AllocationSite> site);
+
   V8_EXPORT_PRIVATE static int GetMinMementoCountForTesting();
 
  private:
@@ -89,6 +131,23 @@ class PretenuringHandler final {
 
   std::unique_ptr<GlobalHandleVector<AllocationSite>>
       allocation_sites_to_pretenure_;
+
+  // Top-level literal sites recorded for --cache-pretenuring-decisions. The
+  // list keeps the weak handle locations stable, which are reset to nullptr
+  // once a site dies.
+  struct LiteralSite {
+    int script_id;
+    int function_literal_id;
+    int slot;
+    Address* site;
+  };
+  static constexpr size_t kMinLiteralSitesPruneLimit = 64;
+  std::list<LiteralSite> literal_sites_;
+  size_t literal_sites_prune_limit_ = kMinLiteralSitesPruneLimit;
+
+  // Decisions imported from the code cache that were not yet applied, keyed by
+  // script id, function literal id, feedback slot and nesting depth.
+  std::set<std::tuple<int, int, int, int>> imported_pretenuring_decisions_;
 };
 
 }  // namespace internal
@@ -105,6 +105,13 @@ class ReadOnlyHeap {
 
   bool roots_init_complete() const { return roots_init_complete_; }
 
+  // Returns the number of bytes of the read-only space that were mapped from
+  // the snapshot rather than copied, see --map-read-only-space-from-snapshot.
+  size_t mapped_snapshot_bytes() const { return mapped_snapshot_bytes_; }
+  void set_mapped_snapshot_bytes(size_t bytes) {
+    mapped_snapshot_bytes_ = bytes;
+  }
+
  protected:
   friend class ReadOnlyArtifacts;
   friend class PointerCompressedReadOnlyArtifacts;
@@ -126,6 +133,7 @@ class ReadOnlyHeap {
 
   bool roots_init_complete_ = false;
   ReadOnlySpace* read_only_space_ = nullptr;
+  size_t mapped_snapshot_bytes_ = 0;
 
 #ifdef V8_ENABLE_SANDBOX
   // The read-only heap has its own code pointer space. Entries in this space
@@ -24,6 +24,9 @@ namespace internal {
 namespace {
 
 v8::StartupData g_snapshot;
+// Set if the snapshot was mapped rather than read, see
+// --map-read-only-space-from-snapshot.
+base::OS::MemoryMappedFile* g_snapshot_file = nullptr;
 
 void ClearStartupData(v8::StartupData* data) {
   data->data = nullptr;
@@ -36,6 +39,12 @@ void DeleteStartupData(v8::StartupData* data) {
 }
 
 void FreeStartupData() {
+  if (g_snapshot_file) {
+    delete g_snapshot_file;
+    g_snapshot_file = nullptr;
+    ClearStartupData(&g_snapshot);
+    return;
+  }
   DeleteStartupData(&g_snapshot);
 }
 
@@ -45,6 +54,22 @@ void Load(const char* blob_file, v8::StartupData* startup_data,
 
   CHECK(blob_file);
 
+  if (v8_flags.map_read_only_space_from_snapshot) {
+    // The read-only space can only be mapped from the snapshot if the blob
+    // itself is backed by the file.
+    CHECK_NULL(g_snapshot_file);
+    g_snapshot_file = base::OS::MemoryMappedFile::open(
+        blob_file, base::OS::MemoryMappedFile::FileMode::kReadOnly);
+    if (g_snapshot_file && g_snapshot_file->size() > 0) {
+      startup_data->data = static_cast<const char*>(g_snapshot_file->memory());
+      startup_data->raw_size = static_cast<int>(g_snapshot_file->size());
+      (*setter_fn)(startup_data);
+      return;
+    }
+    delete g_snapshot_file;
+    g_snapshot_file = nullptr;
+  }
+
   FILE* file = base::Fopen(blob_file, "rb");
   if (!file) {
     PrintF(stderr, "Failed to open startup resource '%s'.\n", blob_file);
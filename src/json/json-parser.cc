@@ -14,6 +14,7 @@
 #include "src/debug/debug.h"
 #include "src/execution/frames-inl.h"
 #include "src/heap/factory.h"
+#include "src/json/json-simd.h"
 #include "src/numbers/conversions.h"
 #include "src/numbers/hash-seed-inl.h"
 #include "src/objects/elements-kind.h"
@@ -128,6 +129,62 @@ static const constexpr uint8_t character_json_scan_flags[256] = {
 #undef CALL_GET_SCAN_FLAGS
 };
 
+// Returns the first position in [cursor, end) that is not JSON whitespace, or
+// |end|.
+template <typename Char>
+V8_INLINE const Char* SkipJsonWhitespace(const Char* cursor, const Char* end) {
+#ifdef V8_JSON_SIMD
+  cursor = json_simd::VectorizedSkip(cursor, end,
+                                     json_simd::NonWhitespaceMask<Char>);
+#endif
+  return std::find_if(cursor, end, [](Char c) {
+    return c > unibrow::Latin1::kMaxChar ||
+           one_char_json_tokens[c] != JsonToken::WHITESPACE;
+  });
+}
+
+// Returns the first position in [cursor, end) that is not a decimal digit, or
+// |end|.
+template <typename Char>
+V8_INLINE const Char* SkipDecimalDigits(const Char* cursor, const Char* end) {
+#ifdef V8_JSON_SIMD
+  cursor = json_simd::VectorizedSkip(cursor, end,
+                                     json_simd::NonDecimalMask<Char>);
+#endif
+  return std::find_if(cursor, end, [](Char c) { return !IsDecimalDigit(c); });
+}
+
+// Skips a prefix of [cursor, end) which certainly doesn't contain a character
+// that may terminate a JSON string. For two-byte input, the characters skipped
+// are or'ed into |bits| so the caller can tell whether the string fits into a
+// one-byte string.
+template <typename Char>
+V8_INLINE const Char* SkipPlainStringCharacters(const Char* cursor,
+                                                const Char* end,
+                                                base::uc32* bits) {
+#ifdef V8_JSON_SIMD
+  if constexpr (sizeof(Char) == 1) {
+    return json_simd::VectorizedSkip(cursor, end,
+                                     json_simd::StringTerminatorMask<Char>);
+  } else {
+    // Only skip whole blocks so that |bits| never sees characters following
+    // the terminator.
+    const Char* start = cursor;
+    json_simd::Block accumulated = json_simd::SplatChar<Char>(0);
+    while (static_cast<size_t>(end - cursor) >= json_simd::kLanes<Char>) {
+      if (json_simd::StringTerminatorMask(cursor) != 0) break;
+      accumulated = json_simd::Or(accumulated, json_simd::LoadBlock(cursor));
+      cursor += json_simd::kLanes<Char>;
+    }
+    if (cursor != start) *bits |= json_simd::HorizontalOr16(accumulated);
+    return cursor;
+  }
+#else
+  USE(end, bits);
+  return cursor;
+#endif
+}
+
 }  // namespace
 
 MaybeHandle<Object> JsonParseInternalizer::Internalize(
@@ -562,16 +619,18 @@ JsonToken GetTokenForCharacter(Char c) {
 
 template <typename Char>
 void JsonParser<Char>::SkipWhitespace() {
-  JsonToken local_next = JsonToken::EOS;
-
-  cursor_ = std::find_if(cursor_, end_, [&](Char c) {
-    JsonToken current = GetTokenForCharacter(c);
-    bool result = current != JsonToken::WHITESPACE;
-    if (V8_LIKELY(result)) local_next = current;
-    return result;
-  });
+  if (V8_LIKELY(!is_at_end())) {
+    // Compact JSON has no whitespace between tokens at all, so check the
+    // current character before looking at a whole block.
+    JsonToken current = GetTokenForCharacter(*cursor_);
+    if (V8_LIKELY(current != JsonToken::WHITESPACE)) {
+      next_ = current;
+      return;
+    }
+    cursor_ = SkipJsonWhitespace(cursor_ + 1, end_);
+  }
 
-  next_ = local_next;
+  next_ = is_at_end() ? JsonToken::EOS : GetTokenForCharacter(*cursor_);
 }
 
 template <typename Char>
@@ -631,6 +690,60 @@ JsonString JsonParser<Char>::ScanJsonPropertyKey(JsonContinuation* cont) {
   return ScanJsonString(true);
 }
 
+template <typename Char>
+std::optional<JsonString> JsonParser<Char>::TryScanExpectedPropertyKey(
+    Tagged<String> expected_key) {
+  DisallowGarbageCollection no_gc;
+  // Property keys are almost always internalized sequential one-byte strings.
+  if (!IsSeqOneByteString(expected_key)) return std::nullopt;
+  const int length = expected_key->length();
+  if (length == 0 || end_ - cursor_ <= length) return std::nullopt;
+  const uint8_t* chars = Cast<SeqOneByteString>(expected_key)->GetChars(no_gc);
+  if (!CompareCharsEqual(cursor_, chars, length) || cursor_[length] != '"') {
+    return std::nullopt;
+  }
+  // The raw comparison doesn't notice if the expected key contains characters
+  // that can't appear unescaped in a JSON string.
+  if (V8_UNLIKELY(std::any_of(chars, chars + length, [](uint8_t c) {
+        return MayTerminateJsonString(character_json_scan_flags[c]);
+      }))) {
+    return std::nullopt;
+  }
+  // Named property keys are never array indices, so there is no need to
+  // check for those either.
+  JsonString key(position(), length, sizeof(Char) == 2, true, false);
+  cursor_ += length + 1;
+  return key;
+}
+
+template <typename Char>
+Handle<Map> JsonParser<Char>::GetFieldFeedback(DirectHandle<Map> map,
+                                               InternalIndex descriptor) {
+  DisallowGarbageCollection no_gc;
+  Tagged<DescriptorArray> descriptors = map->instance_descriptors(isolate_);
+  PropertyDetails details = descriptors->GetDetails(descriptor);
+  if (details.location() != PropertyLocation::kField ||
+      !details.representation().IsHeapObject()) {
+    return {};
+  }
+  // The field type tracks the map of the values stored in the field as long
+  // as there is only one and it is stable.
+  Tagged<FieldType> type = descriptors->GetFieldType(descriptor);
+  if (!IsClass(type)) return {};
+  Tagged<Map> field_map = FieldType::AsClass(type);
+  // Only use maps of objects that JSON.parse could have produced, as the
+  // feedback map is used as is.
+  Tagged<Map> object_function_map = object_constructor_->initial_map();
+  if (field_map->instance_type() != JS_OBJECT_TYPE ||
+      field_map->is_dictionary_map() ||
+      field_map->GetConstructor() != *object_constructor_ ||
+      field_map->prototype() != object_function_map->prototype() ||
+      field_map->IsDetached(isolate_)) {
+    return {};
+  }
+  return handle(field_map, isolate_);
+}
+
 class FoldedMutableHeapNumberAllocation {
  public:
   // TODO(leszeks): If allocation alignment is ever enabled, we'll need to add
@@ -717,7 +830,9 @@ class FoldedMutableHeapNumberAllocator {
 //      (e.g. cached from previous runs, or assumed from surrounding objects).
 //      If given, then we first check whether the property matches the
 //      entry in the DescriptorArray of the final map; if yes, then we don't
-//      need to do any map transitions.
+//      need to do any map transitions. The caller may also vouch for the
+//      first few keys matching the final map, in which case they are not
+//      even looked at.
 //   2. When given a property key, it looks for whether there is exactly one
 //      transition away from the current map ("ExpectedTransition").
 //      The expected key is passed as a hint to the current property key
@@ -741,12 +856,14 @@ class JSDataObjectBuilder {
   JSDataObjectBuilder(Isolate* isolate, ElementsKind elements_kind,
                       int expected_named_properties,
                       Handle<Map> expected_final_map,
-                      HeapNumberMode heap_number_mode)
+                      HeapNumberMode heap_number_mode,
+                      int expected_final_map_matched_keys = 0)
       : isolate_(isolate),
         elements_kind_(elements_kind),
         expected_property_count_(expected_named_properties),
         heap_number_mode_(heap_number_mode),
-        expected_final_map_(expected_final_map) {
+        expected_final_map_(expected_final_map),
+        expected_final_map_matched_keys_(expected_final_map_matched_keys) {
     if (!TryInitializeMapFromExpectedFinalMap()) {
       InitializeMapFromZero();
     }
@@ -995,6 +1112,13 @@ class JSDataObjectBuilder {
 
     InternalIndex descriptor_index(current_property_index_);
     if (IsOnExpectedFinalMapFastPath()) {
+      if (current_property_index_ < expected_final_map_matched_keys_) {
+        DCHECK_EQ(*map_, *expected_final_map_);
+        DCHECK(Cast<String>(expected_final_map_->instance_descriptors(isolate_)
+                                ->GetKey(descriptor_index))
+                   ->IsEqualTo(key_chars));
+        return true;
+      }
       expected_key = handle(
           Cast<String>(
               expected_final_map_->instance_descriptors(isolate_)->GetKey(
@@ -1202,6 +1326,9 @@ class JSDataObjectBuilder {
 
   Handle<Map> expected_final_map_ = {};
   int property_count_in_expected_final_map_ = 0;
+  // Number of leading properties whose keys are known to match the
+  // descriptors of the expected final map.
+  int expected_final_map_matched_keys_ = 0;
 };
 
 class NamedPropertyValueIterator {
@@ -1283,9 +1410,12 @@ class JsonParser<Char>::NamedPropertyIterator {
 
 template <typename Char>
 Handle<JSObject> JsonParser<Char>::BuildJsonObject(const JsonContinuation& cont,
-                                                   Handle<Map> feedback) {
+                                                   Handle<Map> feedback,
+                                                   int feedback_key_count) {
   if (!feedback.is_null() && feedback->is_deprecated()) {
     feedback = Map::Update(isolate_, feedback);
+    // The keys were matched against the descriptors of the deprecated map.
+    feedback_key_count = 0;
   }
   size_t start = cont.index;
   DCHECK_LE(start, property_stack_.size());
@@ -1335,7 +1465,8 @@ Handle<JSObject> JsonParser<Char>::BuildJsonObject(const JsonContinuation& cont,
 
   JSDataObjectBuilder js_data_object_builder(
       isolate_, elements_kind, named_length, feedback,
-      JSDataObjectBuilder::kHeapNumbersGuaranteedUniquelyOwned);
+      JSDataObjectBuilder::kHeapNumbersGuaranteedUniquelyOwned,
+      feedback_key_count);
 
   NamedPropertyIterator it(*this, property_stack_.begin() + start,
                            property_stack_.end());
@@ -1482,23 +1613,48 @@ MaybeHandle<Object> JsonParser<Char>::ParseJsonObject(Handle<Map> feedback) {
 
   JsonContinuation cont(isolate_, JsonContinuation::kObjectProperty,
                         property_stack_.size());
+  // As long as the keys follow the descriptors of the feedback map, which is
+  // the map of the previous object of the same shape, they are matched
+  // against the descriptor keys directly. This skips scanning them, and lets
+  // BuildJsonObject skip looking them up.
+  int feedback_key_count = 0;
+  bool on_feedback_keys = !feedback.is_null();
   bool first = true;
   do {
     ExpectNext(
         JsonToken::STRING,
         first ? MessageTemplate::kJsonParseExpectedPropNameOrRBrace
               : MessageTemplate::kJsonParseExpectedDoubleQuotedPropertyName);
-    JsonString key = ScanJsonPropertyKey(&cont);
+    InternalIndex descriptor(feedback_key_count);
+    on_feedback_keys = on_feedback_keys &&
+                       feedback_key_count < feedback->NumberOfOwnDescriptors();
+    std::optional<JsonString> matched_key =
+        on_feedback_keys
+            ? TryScanExpectedPropertyKey(Cast<String>(
+                  feedback->instance_descriptors(isolate_)->GetKey(descriptor)))
+            : std::nullopt;
+    Handle<Map> value_feedback;
+    if (matched_key.has_value()) {
+      feedback_key_count++;
+      value_feedback = GetFieldFeedback(feedback, descriptor);
+    } else {
+      on_feedback_keys = false;
+    }
+    JsonString key =
+        matched_key.has_value() ? *matched_key : ScanJsonPropertyKey(&cont);
     ExpectNext(JsonToken::COLON,
                MessageTemplate::kJsonParseExpectedColonAfterPropertyName);
     Handle<Object> value;
-    if (V8_UNLIKELY(!ParseJsonValueRecursive().ToHandle(&value))) return {};
+    if (V8_UNLIKELY(
+            !ParseJsonValueRecursive(value_feedback).ToHandle(&value))) {
+      return {};
+    }
     property_stack_.emplace_back(key, value);
     first = false;
   } while (Check(JsonToken::COMMA));
 
   Expect(JsonToken::RBRACE, MessageTemplate::kJsonParseExpectedCommaOrRBrace);
-  Handle<Object> result = BuildJsonObject(cont, feedback);
+  Handle<Object> result = BuildJsonObject(cont, feedback, feedback_key_count);
   property_stack_.resize_no_init(cont.index);
   return cont.scope.CloseAndEscape(result);
 }
@@ -1874,8 +2030,7 @@ MaybeHandle<Object> JsonParser<Char>::ParseJsonValue() {
 
 template <typename Char>
 void JsonParser<Char>::AdvanceToNonDecimal() {
-  cursor_ =
-      std::find_if(cursor_, end_, [](Char c) { return !IsDecimalDigit(c); });
+  cursor_ = SkipDecimalDigits(cursor_, end_);
 }
 
 template <typename Char>
@@ -2045,9 +2200,15 @@ template <typename SinkChar>
 void JsonParser<Char>::DecodeString(SinkChar* sink, int start, int length) {
   SinkChar* sink_start = sink;
   const Char* cursor = chars_ + start;
+  base::uc32 unused_bits = 0;
   while (true) {
     const Char* end = cursor + length - (sink - sink_start);
-    cursor = std::find_if(cursor, end, [&sink](Char c) {
+    // The string has been validated already, so the only string terminator
+    // left to find is the next backslash.
+    const Char* run_end = SkipPlainStringCharacters(cursor, end, &unused_bits);
+    CopyChars(sink, cursor, run_end - cursor);
+    sink += run_end - cursor;
+    cursor = std::find_if(run_end, end, [&sink](Char c) {
       if (c == '\\') return true;
       *sink++ = c;
       return false;
@@ -2113,6 +2274,7 @@ JsonString JsonParser<Char>::ScanJsonString(bool needs_internalization) {
   base::uc32 bits = 0;
 
   while (true) {
+    cursor_ = SkipPlainStringCharacters(cursor_, end_, &bits);
     cursor_ = std::find_if(cursor_, end_, [&bits](Char c) {
       if (sizeof(Char) == 2 && V8_UNLIKELY(c > unibrow::Latin1::kMaxChar)) {
         bits |= c;
@@ -299,6 +299,11 @@ class JsonParser final {
   // four-digit hex escapes (uXXXX). Any other use of backslashes is invalid.
   JsonString ScanJsonString(bool needs_internalization);
   JsonString ScanJsonPropertyKey(JsonContinuation* cont);
+  // Scans the property key at the cursor if it is |expected_key|, which is
+  // compared against the raw source characters. Returns nothing and leaves
+  // the cursor untouched otherwise.
+  std::optional<JsonString> TryScanExpectedPropertyKey(
+      Tagged<String> expected_key);
   base::uc32 ScanUnicodeCharacter();
   base::Vector<const Char> GetKeyChars(JsonString key) {
     return base::Vector<const Char>(chars_ + key.start(), key.length());
@@ -332,9 +337,16 @@ class JsonParser final {
       Handle<Map> feedback = {});
   MaybeHandle<Object> ParseJsonArray();
   MaybeHandle<Object> ParseJsonObject(Handle<Map> feedback);
+  // Returns the map to use as feedback for an object stored in the field
+  // |descriptor| of |map|, if the field is known to hold plain objects of a
+  // single shape.
+  Handle<Map> GetFieldFeedback(DirectHandle<Map> map, InternalIndex descriptor);
 
+  // |feedback_key_count| is the number of leading named properties whose keys
+  // are already known to match the descriptors of |feedback|.
   Handle<JSObject> BuildJsonObject(const JsonContinuation& cont,
-                                   Handle<Map> feedback);
+                                   Handle<Map> feedback,
+                                   int feedback_key_count = 0);
   Handle<Object> BuildJsonArray(size_t start);
 
   static const int kMaxContextCharacters = 10;
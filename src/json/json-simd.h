@@ -0,0 +1,250 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_JSON_JSON_SIMD_H_
+#define V8_JSON_JSON_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "src/base/bits.h"
+#include "src/base/build_config.h"
+#include "src/base/macros.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_JSON_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+// As in src/objects/simd.cc, Neon is only used on 64-bit ARM.
+#define V8_JSON_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(V8_JSON_SIMD_SSE2) || defined(V8_JSON_SIMD_NEON)
+#define V8_JSON_SIMD 1
+#endif
+
+// Helpers for the JSON parser and stringifier to look at 16 bytes of one- or
+// two-byte characters at a time. The *Mask functions produce a bitmask with
+// kBitsPerLane bits set for every lane that holds a character of interest,
+// which VectorizedSkip turns into the position of the first such character.
+//
+// They only speed up the common case of long runs of uninteresting characters;
+// callers are expected to handle the tail of the input, which is shorter than
+// a block, with their regular scalar code.
+
+namespace v8 {
+namespace internal {
+namespace json_simd {
+
+#ifdef V8_JSON_SIMD
+
+constexpr size_t kBlockSize = 16;
+
+template <typename Char>
+constexpr size_t kLanes = kBlockSize / sizeof(Char);
+
+#ifdef V8_JSON_SIMD_SSE2
+
+using Block = __m128i;
+
+// _mm_movemask_epi8 yields one bit per byte.
+template <typename Char>
+constexpr int kBitsPerLane = sizeof(Char);
+
+V8_INLINE Block LoadBlock(const void* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+template <typename Char>
+V8_INLINE uint64_t ToMask(Block v) {
+  return _mm_movemask_epi8(v);
+}
+
+template <typename Char>
+V8_INLINE Block SplatChar(Char c) {
+  return sizeof(Char) == 1 ? _mm_set1_epi8(static_cast<char>(c))
+                           : _mm_set1_epi16(static_cast<int16_t>(c));
+}
+
+template <typename Char>
+V8_INLINE Block CompareEqual(Block a, Block b) {
+  return sizeof(Char) == 1 ? _mm_cmpeq_epi8(a, b) : _mm_cmpeq_epi16(a, b);
+}
+
+// Lanes holding an unsigned value <= |limit|.
+template <typename Char>
+V8_INLINE Block CompareLessOrEqual(Block v, Char limit) {
+  Block saturated = sizeof(Char) == 1
+                        ? _mm_subs_epu8(v, SplatChar<Char>(limit))
+                        : _mm_subs_epu16(v, SplatChar<Char>(limit));
+  return CompareEqual<Char>(saturated, _mm_setzero_si128());
+}
+
+template <typename Char>
+V8_INLINE Block Subtract(Block a, Block b) {
+  return sizeof(Char) == 1 ? _mm_sub_epi8(a, b) : _mm_sub_epi16(a, b);
+}
+
+V8_INLINE Block Or(Block a, Block b) { return _mm_or_si128(a, b); }
+
+V8_INLINE void StoreBlock(void* p, Block v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+#else  // V8_JSON_SIMD_NEON
+
+using Block = uint8x16_t;
+
+// The masks are narrowed with a shift-right-and-narrow (one byte lanes) or a
+// plain narrow (two byte lanes), which leaves 4 resp. 8 bits per lane.
+template <typename Char>
+constexpr int kBitsPerLane = sizeof(Char) == 1 ? 4 : 8;
+
+V8_INLINE Block LoadBlock(const void* p) {
+  return vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+}
+
+template <typename Char>
+V8_INLINE uint64_t ToMask(Block v) {
+  uint8x8_t narrowed = sizeof(Char) == 1
+                           ? vshrn_n_u16(vreinterpretq_u16_u8(v), 4)
+                           : vmovn_u16(vreinterpretq_u16_u8(v));
+  return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+template <typename Char>
+V8_INLINE Block SplatChar(Char c) {
+  return sizeof(Char) == 1
+             ? vdupq_n_u8(static_cast<uint8_t>(c))
+             : vreinterpretq_u8_u16(vdupq_n_u16(static_cast<uint16_t>(c)));
+}
+
+template <typename Char>
+V8_INLINE Block CompareEqual(Block a, Block b) {
+  return sizeof(Char) == 1
+             ? vceqq_u8(a, b)
+             : vreinterpretq_u8_u16(vceqq_u16(vreinterpretq_u16_u8(a),
+                                              vreinterpretq_u16_u8(b)));
+}
+
+// Lanes holding an unsigned value <= |limit|.
+template <typename Char>
+V8_INLINE Block CompareLessOrEqual(Block v, Char limit) {
+  return sizeof(Char) == 1
+             ? vcleq_u8(v, SplatChar<Char>(limit))
+             : vreinterpretq_u8_u16(
+                   vcleq_u16(vreinterpretq_u16_u8(v),
+                             vreinterpretq_u16_u8(SplatChar<Char>(limit))));
+}
+
+template <typename Char>
+V8_INLINE Block Subtract(Block a, Block b) {
+  return sizeof(Char) == 1
+             ? vsubq_u8(a, b)
+             : vreinterpretq_u8_u16(vsubq_u16(vreinterpretq_u16_u8(a),
+                                              vreinterpretq_u16_u8(b)));
+}
+
+V8_INLINE Block Or(Block a, Block b) { return vorrq_u8(a, b); }
+
+V8_INLINE void StoreBlock(void* p, Block v) {
+  vst1q_u8(reinterpret_cast<uint8_t*>(p), v);
+}
+
+#endif  // V8_JSON_SIMD_NEON
+
+// All lanes of a block, as produced by ToMask.
+template <typename Char>
+constexpr uint64_t kAllLanes =
+    kLanes<Char> * kBitsPerLane<Char> == 64
+        ? ~uint64_t{0}
+        : (uint64_t{1} << (kLanes<Char> * kBitsPerLane<Char>)) - 1;
+
+// Lanes in |v| holding '"', '\\' or a control character. In a valid JSON
+// string these are exactly the characters that terminate a run of plain
+// characters; when stringifying they are the Latin1 characters that need to be
+// escaped.
+template <typename Char>
+V8_INLINE Block StringSpecialCharacters(Block v) {
+  Block quote = CompareEqual<Char>(v, SplatChar<Char>('"'));
+  Block backslash = CompareEqual<Char>(v, SplatChar<Char>('\\'));
+  Block control = CompareLessOrEqual<Char>(v, 0x1F);
+  return Or(Or(quote, backslash), control);
+}
+
+// Mask of the lanes in the block at |p| that end a run of plain string
+// characters.
+template <typename Char>
+V8_INLINE uint64_t StringTerminatorMask(const Char* p) {
+  return ToMask<Char>(StringSpecialCharacters<Char>(LoadBlock(p)));
+}
+
+// Mask of the lanes in the block at |p| that JSON.stringify has to escape,
+// i.e. string terminators and, for two-byte strings, surrogates.
+template <typename Char>
+V8_INLINE uint64_t NeedsEscapingMask(const Char* p) {
+  Block v = LoadBlock(p);
+  Block special = StringSpecialCharacters<Char>(v);
+  if constexpr (sizeof(Char) == 2) {
+    Block surrogate = CompareLessOrEqual<Char>(
+        Subtract<Char>(v, SplatChar<Char>(0xD800)), 0xDFFF - 0xD800);
+    special = Or(special, surrogate);
+  }
+  return ToMask<Char>(special);
+}
+
+// Mask of the lanes in the block at |p| that are not JSON whitespace.
+template <typename Char>
+V8_INLINE uint64_t NonWhitespaceMask(const Char* p) {
+  Block v = LoadBlock(p);
+  Block whitespace = Or(Or(CompareEqual<Char>(v, SplatChar<Char>(' ')),
+                           CompareEqual<Char>(v, SplatChar<Char>('\n'))),
+                        Or(CompareEqual<Char>(v, SplatChar<Char>('\r')),
+                           CompareEqual<Char>(v, SplatChar<Char>('\t'))));
+  return ~ToMask<Char>(whitespace) & kAllLanes<Char>;
+}
+
+// Mask of the lanes in the block at |p| that are not decimal digits.
+template <typename Char>
+V8_INLINE uint64_t NonDecimalMask(const Char* p) {
+  Block v = LoadBlock(p);
+  Block digit =
+      CompareLessOrEqual<Char>(Subtract<Char>(v, SplatChar<Char>('0')), 9);
+  return ~ToMask<Char>(digit) & kAllLanes<Char>;
+}
+
+// Advances |cursor| block by block until a block contains a lane selected by
+// |mask_function|, and returns the position of that lane. If no lane matched,
+// returns a position less than a block away from |end|.
+template <typename Char, typename MaskFunction>
+V8_INLINE const Char* VectorizedSkip(const Char* cursor, const Char* end,
+                                     MaskFunction mask_function) {
+  while (static_cast<size_t>(end - cursor) >= kLanes<Char>) {
+    uint64_t mask = mask_function(cursor);
+    if (mask != 0) {
+      return cursor + base::bits::CountTrailingZeros(mask) / kBitsPerLane<Char>;
+    }
+    cursor += kLanes<Char>;
+  }
+  return cursor;
+}
+
+// Bitwise or of all two-byte lanes in |v|.
+V8_INLINE uint16_t HorizontalOr16(Block v) {
+  alignas(kBlockSize) uint16_t lanes[kLanes<uint16_t>];
+  StoreBlock(lanes, v);
+  uint16_t result = 0;
+  for (uint16_t lane : lanes) result |= lane;
+  return result;
+}
+
+#endif  // V8_JSON_SIMD
+
+}  // namespace json_simd
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_JSON_JSON_SIMD_H_
@@ -0,0 +1,262 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/json/json-streaming-parser.h"
+
+#include <algorithm>
+#include <string>
+
+#include "src/execution/isolate.h"
+#include "src/handles/global-handles-inl.h"
+#include "src/heap/factory.h"
+#include "src/json/json-parser.h"
+#include "src/objects/fixed-array-inl.h"
+#include "src/objects/js-array-inl.h"
+#include "src/objects/objects-inl.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr bool IsJsonWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+}  // namespace
+
+JsonStreamingParser::JsonStreamingParser(Isolate* isolate)
+    : isolate_(isolate) {}
+
+JsonStreamingParser::~JsonStreamingParser() {
+  if (!elements_.is_null()) GlobalHandles::Destroy(elements_.location());
+}
+
+bool JsonStreamingParser::Feed(base::Vector<const char> chunk) {
+  DCHECK(is_active());
+  buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+  if (state_ == State::kBuffering) return true;
+  if (!Scan()) return Fail();
+  // Drop the source of everything that has been parsed already.
+  if (element_start_ > 0) {
+    buffer_.erase(buffer_.begin(), buffer_.begin() + element_start_);
+    scan_position_ -= element_start_;
+    element_start_ = 0;
+  }
+  return true;
+}
+
+bool JsonStreamingParser::Scan() {
+  for (; scan_position_ < buffer_.size(); scan_position_++) {
+    const char c = buffer_[scan_position_];
+    switch (state_) {
+      case State::kStart:
+        if (IsJsonWhitespace(c)) {
+          element_start_ = scan_position_ + 1;
+        } else if (c == '[') {
+          state_ = State::kArray;
+          depth_ = 1;
+          element_start_ = scan_position_ + 1;
+        } else {
+          state_ = State::kBuffering;
+          scan_position_ = buffer_.size();
+          return true;
+        }
+        break;
+
+      case State::kArray:
+        if (in_string_) {
+          if (escaped_) {
+            escaped_ = false;
+          } else if (c == '\\') {
+            escaped_ = true;
+          } else if (c == '"') {
+            in_string_ = false;
+          }
+          break;
+        }
+        switch (c) {
+          case '"':
+            in_string_ = true;
+            break;
+          case '[':
+          case '{':
+            depth_++;
+            break;
+          case ']':
+          case '}':
+            if (--depth_ == 0 && !CompleteElement(scan_position_, c)) {
+              return false;
+            }
+            break;
+          case ',':
+            if (depth_ == 1 && !CompleteElement(scan_position_, c)) {
+              return false;
+            }
+            break;
+        }
+        break;
+
+      case State::kAfterArray:
+        if (!IsJsonWhitespace(c)) {
+          return ThrowFragmentError("[]", base::Vector<const char>(&c, 1), "");
+        }
+        element_start_ = scan_position_ + 1;
+        break;
+
+      case State::kBuffering:
+      case State::kFailed:
+      case State::kFinished:
+        UNREACHABLE();
+    }
+  }
+  return true;
+}
+
+bool JsonStreamingParser::CompleteElement(size_t end, char terminator) {
+  DCHECK_EQ(buffer_[end], terminator);
+  base::Vector<const char> text(buffer_.data() + element_start_,
+                                end - element_start_);
+  const char* prefix = after_comma_ ? "[0," : "[";
+  const bool is_empty = std::all_of(text.begin(), text.end(), IsJsonWhitespace);
+
+  if (terminator == '}') return ThrowFragmentError(prefix, text, "}");
+  if (is_empty) {
+    // "[]" is fine, "[,", "[1,,", and "[1,]" are not.
+    if (terminator == ',' || after_comma_) {
+      return ThrowFragmentError(prefix, text, terminator == ',' ? "," : "]");
+    }
+  } else {
+    HandleScope scope(isolate_);
+    Handle<Object> value;
+    if (!ParseValue(text).ToHandle(&value)) return false;
+    AddElement(value);
+  }
+
+  after_comma_ = terminator == ',';
+  element_start_ = end + 1;
+  if (terminator == ']') state_ = State::kAfterArray;
+  return true;
+}
+
+void JsonStreamingParser::AddElement(DirectHandle<Object> value) {
+  if (elements_.is_null()) {
+    elements_ =
+        isolate_->global_handles()->Create(*ArrayList::New(isolate_, 16));
+  }
+  DirectHandle<ArrayList> list = ArrayList::Add(isolate_, elements_, value);
+  if (*list != *elements_) {
+    GlobalHandles::Destroy(elements_.location());
+    elements_ = isolate_->global_handles()->Create(*list);
+  }
+}
+
+MaybeHandle<Object> JsonStreamingParser::ParseValue(
+    base::Vector<const char> text) {
+  Handle<String> source;
+  ASSIGN_RETURN_ON_EXCEPTION(isolate_, source,
+                             isolate_->factory()->NewStringFromUtf8(text));
+  source = String::Flatten(isolate_, source);
+  Handle<Object> undefined = isolate_->factory()->undefined_value();
+  return source->IsOneByteRepresentation()
+             ? JsonParser<uint8_t>::Parse(isolate_, source, undefined)
+             : JsonParser<uint16_t>::Parse(isolate_, source, undefined);
+}
+
+bool JsonStreamingParser::ThrowFragmentError(const char* prefix,
+                                             base::Vector<const char> text,
+                                             const char* suffix) {
+  std::string fragment(prefix);
+  fragment.append(text.begin(), text.end());
+  fragment.append(suffix);
+  HandleScope scope(isolate_);
+  MaybeHandle<Object> result = ParseValue(base::VectorOf(fragment));
+  CHECK(result.is_null());
+  DCHECK(isolate_->has_exception());
+  return false;
+}
+
+Handle<JSArray> JsonStreamingParser::BuildArray() {
+  Factory* factory = isolate_->factory();
+  if (elements_.is_null()) {
+    return factory->NewJSArray(PACKED_SMI_ELEMENTS, 0, 0);
+  }
+
+  // Pick the elements kind the same way JsonParser::BuildJsonArray does.
+  int length = elements_->length();
+  ElementsKind kind = PACKED_SMI_ELEMENTS;
+  for (int i = 0; i < length; i++) {
+    Tagged<Object> value = elements_->get(i);
+    if (IsHeapObject(value)) {
+      if (IsHeapNumber(Cast<HeapObject>(value))) {
+        kind = PACKED_DOUBLE_ELEMENTS;
+      } else {
+        kind = PACKED_ELEMENTS;
+        break;
+      }
+    }
+  }
+
+  Handle<JSArray> array = factory->NewJSArray(kind, length, length);
+  DisallowGarbageCollection no_gc;
+  Tagged<ArrayList> list = *elements_;
+  if (kind == PACKED_DOUBLE_ELEMENTS) {
+    Tagged<FixedDoubleArray> elements =
+        Cast<FixedDoubleArray>(array->elements());
+    for (int i = 0; i < length; i++) {
+      elements->set(i, Object::NumberValue(list->get(i)));
+    }
+  } else {
+    Tagged<FixedArray> elements = Cast<FixedArray>(array->elements());
+    WriteBarrierMode mode = kind == PACKED_SMI_ELEMENTS
+                                ? SKIP_WRITE_BARRIER
+                                : elements->GetWriteBarrierMode(no_gc);
+    for (int i = 0; i < length; i++) {
+      elements->set(i, list->get(i), mode);
+    }
+  }
+  return array;
+}
+
+MaybeHandle<Object> JsonStreamingParser::Finish() {
+  DCHECK(is_active());
+  base::Vector<const char> text(buffer_.data() + element_start_,
+                                buffer_.size() - element_start_);
+  MaybeHandle<Object> result;
+  switch (state_) {
+    case State::kStart:
+    case State::kBuffering:
+      result = ParseValue(text);
+      break;
+    case State::kArray:
+      // The top-level array has not been closed.
+      ThrowFragmentError(after_comma_ ? "[0," : "[", text, "");
+      break;
+    case State::kAfterArray:
+      result = BuildArray();
+      break;
+    case State::kFailed:
+    case State::kFinished:
+      UNREACHABLE();
+  }
+
+  if (result.is_null()) {
+    Fail();
+  } else {
+    state_ = State::kFinished;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+  }
+  return result;
+}
+
+bool JsonStreamingParser::Fail() {
+  state_ = State::kFailed;
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  return false;
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,103 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_JSON_JSON_STREAMING_PARSER_H_
+#define V8_JSON_JSON_STREAMING_PARSER_H_
+
+#include <vector>
+
+#include "src/base/vector.h"
+#include "src/handles/handles.h"
+#include "src/objects/fixed-array.h"
+
+namespace v8 {
+namespace internal {
+
+class Isolate;
+
+// Parses JSON text that arrives in UTF-8 encoded chunks, backing
+// v8::JSON::StreamingParser.
+//
+// If the top-level value is an array, which is by far the most common shape
+// of large payloads, every element is handed to JsonParser as soon as its
+// closing ',' or ']' has been seen, and its source bytes are dropped. Only the
+// bytes of the element that is currently incomplete are kept alive, and the
+// parsed elements are collected in a growable list. Finish() copies them into
+// a new backing store of the elements kind that fits them. Any other
+// top-level value is buffered and parsed by Finish().
+//
+// Syntax errors inside an element are reported with positions relative to
+// that element's source text.
+class JsonStreamingParser final {
+ public:
+  explicit JsonStreamingParser(Isolate* isolate);
+  ~JsonStreamingParser();
+
+  JsonStreamingParser(const JsonStreamingParser&) = delete;
+  JsonStreamingParser& operator=(const JsonStreamingParser&) = delete;
+
+  // Appends |chunk| and parses all array elements it completes. Returns false
+  // if a syntax error was found, in which case an exception is pending.
+  V8_WARN_UNUSED_RESULT bool Feed(base::Vector<const char> chunk);
+
+  // Parses what is left and returns the top-level value.
+  V8_WARN_UNUSED_RESULT MaybeHandle<Object> Finish();
+
+  // Whether Feed() or Finish() may still be called.
+  bool is_active() const {
+    return state_ != State::kFailed && state_ != State::kFinished;
+  }
+
+ private:
+  enum class State : uint8_t {
+    // No non-whitespace character has been seen yet.
+    kStart,
+    // Inside a top-level array.
+    kArray,
+    // The top-level array has been closed, only whitespace may follow.
+    kAfterArray,
+    // The top-level value is not an array and is buffered until Finish().
+    kBuffering,
+    kFailed,
+    kFinished,
+  };
+
+  // Scans the bytes in buffer_ that have not been looked at yet.
+  bool Scan();
+  // Handles the end of an array element, at buffer_[end] == |terminator|.
+  bool CompleteElement(size_t end, char terminator);
+  void AddElement(DirectHandle<Object> value);
+  // Parses |text| as a complete JSON value.
+  MaybeHandle<Object> ParseValue(base::Vector<const char> text);
+  // Throws the SyntaxError JSON.parse would report for the malformed array
+  // fragment |prefix| |text| |suffix|.
+  bool ThrowFragmentError(const char* prefix, base::Vector<const char> text,
+                          const char* suffix);
+  Handle<JSArray> BuildArray();
+  bool Fail();
+
+  Isolate* const isolate_;
+  State state_ = State::kStart;
+
+  // Source bytes that have not been turned into values yet.
+  std::vector<char> buffer_;
+  // Position of the next byte in buffer_ to be scanned.
+  size_t scan_position_ = 0;
+  // Start of the current array element in buffer_.
+  size_t element_start_ = 0;
+
+  // Lexical state of the array scanner, carried over chunk boundaries.
+  int depth_ = 0;
+  bool in_string_ = false;
+  bool escaped_ = false;
+  bool after_comma_ = false;
+
+  // Global handle to the elements parsed so far.
+  Handle<ArrayList> elements_;
+};
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_JSON_JSON_STREAMING_PARSER_H_
@@ -4,10 +4,12 @@
 
 #include "src/json/json-stringifier.h"
 
+#include "include/v8-profiler.h"
 #include "src/base/strings.h"
 #include "src/common/assert-scope.h"
 #include "src/common/message-template.h"
 #include "src/execution/protectors-inl.h"
+#include "src/json/json-simd.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/elements-kind.h"
 #include "src/objects/heap-number-inl.h"
@@ -20,13 +22,16 @@
 #include "src/objects/smi.h"
 #include "src/objects/tagged.h"
 #include "src/strings/string-builder-inl.h"
+#include "src/strings/unicode-inl.h"
+#include "src/strings/unicode-simd.h"
 
 namespace v8 {
 namespace internal {
 
 class JsonStringifier {
  public:
-  explicit JsonStringifier(Isolate* isolate);
+  explicit JsonStringifier(Isolate* isolate,
+                           v8::OutputStream* output_stream = nullptr);
 
   ~JsonStringifier() {
     if (one_byte_ptr_ != one_byte_array_) delete[] one_byte_ptr_;
@@ -38,6 +43,13 @@ class JsonStringifier {
                                                       Handle<Object> replacer,
                                                       Handle<Object> gap);
 
+  // Serializes |object| as UTF-8 into the output stream passed to the
+  // constructor. Returns false if |object| is not serializable or the stream
+  // aborted, and Nothing if an exception was thrown.
+  V8_WARN_UNUSED_RESULT Maybe<bool> StringifyToStream(Handle<Object> object,
+                                                      Handle<Object> replacer,
+                                                      Handle<Object> gap);
+
  private:
   enum Result { UNCHANGED, SUCCESS, EXCEPTION, NEED_STACK };
 
@@ -254,6 +266,12 @@ class JsonStringifier {
       cursor_ += length;
     }
 
+    template <typename SrcChar>
+    V8_INLINE void AppendChars(base::Vector<const SrcChar> chars) {
+      CopyChars(cursor_, chars.begin(), chars.size());
+      cursor_ += chars.size();
+    }
+
    private:
     int* current_index_;
     DestChar* start_;
@@ -343,6 +361,12 @@ class JsonStringifier {
   template <typename Char>
   V8_INLINE static bool DoNotEscape(Char c);
 
+  // Returns the first character in [begin, end) that needs to be escaped, or
+  // |end|.
+  template <typename Char>
+  V8_INLINE static const Char* FindCharacterToEscape(const Char* begin,
+                                                     const Char* end);
+
   V8_INLINE void NewLine();
   V8_NOINLINE void NewLineOutline();
   V8_INLINE void Indent() { indent_++; }
@@ -367,12 +391,26 @@ class JsonStringifier {
   static const int kInitialPartLength = 2048;
   static const int kMaxPartLength = 16 * 1024;
   static const int kPartLengthGrowthFactor = 2;
+  // Strings are escaped in slices of at most this many characters, so that
+  // the worst-case escaped length of a slice fits into a part.
+  static const int kMaxStringSliceLength = kMaxPartLength >> 3;
+
+  // When writing to an output stream, parts are not grown beyond this length
+  // but flushed to the stream instead.
+  static const int kStreamingPartLength = kMaxPartLength;
 
   Factory* factory() { return isolate_->factory(); }
 
   V8_NOINLINE void Extend();
   V8_NOINLINE void ChangeEncoding();
 
+  // Transcodes the current part to UTF-8 and writes it to output_stream_.
+  // Unless |is_final|, a trailing leading surrogate is kept in the part until
+  // its trailing surrogate has been seen. Returns the number of characters
+  // that were flushed.
+  int FlushToStream(bool is_final);
+  void WriteToStream(const char* data, size_t length);
+
   Isolate* isolate_;
   String::Encoding encoding_;
   Handle<FixedArray> property_list_;
@@ -388,6 +426,10 @@ class JsonStringifier {
   bool overflowed_;
   bool need_stack_;
 
+  v8::OutputStream* output_stream_;
+  bool output_stream_aborted_;
+  std::vector<char> utf8_buffer_;
+
   using KeyObject = std::pair<Handle<Object>, Handle<Object>>;
   std::vector<KeyObject> stack_;
 
@@ -405,6 +447,13 @@ MaybeHandle<Object> JsonStringify(Isolate* isolate, Handle<Object> object,
   return stringifier.Stringify(object, replacer, gap);
 }
 
+Maybe<bool> JsonStringifyToStream(Isolate* isolate, Handle<Object> object,
+                                  Handle<Object> replacer, Handle<Object> gap,
+                                  v8::OutputStream* output_stream) {
+  JsonStringifier stringifier(isolate, output_stream);
+  return stringifier.StringifyToStream(object, replacer, gap);
+}
+
 // Translation table to escape Latin1 characters.
 // Table entries start at a multiple of 8 and are null-terminated.
 const char* const JsonStringifier::JsonEscapeTable =
@@ -447,7 +496,8 @@ const bool JsonStringifier::JsonDoNotEscapeFlagTable[] = {
     1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
 };
 
-JsonStringifier::JsonStringifier(Isolate* isolate)
+JsonStringifier::JsonStringifier(Isolate* isolate,
+                                 v8::OutputStream* output_stream)
     : isolate_(isolate),
       encoding_(String::ONE_BYTE_ENCODING),
       gap_(nullptr),
@@ -458,6 +508,8 @@ JsonStringifier::JsonStringifier(Isolate* isolate)
       stack_nesting_level_(0),
       overflowed_(false),
       need_stack_(false),
+      output_stream_(output_stream),
+      output_stream_aborted_(false),
       stack_(),
       key_cache_(isolate) {
   one_byte_ptr_ = one_byte_array_;
@@ -501,6 +553,35 @@ MaybeHandle<Object> JsonStringifier::Stringify(Handle<Object> object,
   return MaybeHandle<Object>();
 }
 
+Maybe<bool> JsonStringifier::StringifyToStream(Handle<Object> object,
+                                               Handle<Object> replacer,
+                                               Handle<Object> gap) {
+  DCHECK_NOT_NULL(output_stream_);
+  if (!InitializeReplacer(replacer)) {
+    CHECK(isolate_->has_exception());
+    return Nothing<bool>();
+  }
+  if (!IsUndefined(*gap, isolate_) && !InitializeGap(gap)) {
+    CHECK(isolate_->has_exception());
+    return Nothing<bool>();
+  }
+  // Output that has been flushed to the stream cannot be taken back, so track
+  // the stack from the start instead of restarting on NEED_STACK.
+  need_stack_ = true;
+  Result result = SerializeObject(object);
+  DCHECK_NE(result, NEED_STACK);
+  if (result == EXCEPTION) {
+    CHECK(isolate_->has_exception());
+    return Nothing<bool>();
+  }
+  if (result == UNCHANGED) return Just(false);
+  DCHECK_EQ(result, SUCCESS);
+  FlushToStream(true);
+  if (output_stream_aborted_) return Just(false);
+  output_stream_->EndOfStream();
+  return Just(true);
+}
+
 bool JsonStringifier::InitializeReplacer(Handle<Object> replacer) {
   DCHECK(property_list_.is_null());
   DCHECK(replacer_function_.is_null());
@@ -1381,14 +1462,22 @@ bool JsonStringifier::SerializeStringUnchecked_(
   // Assert that base::uc16 character is not truncated down to 8 bit.
   // The <base::uc16, char> version of this method must not be called.
   DCHECK(sizeof(DestChar) >= sizeof(SrcChar));
+  if (raw_json) {
+    dest->AppendChars(src);
+    return false;
+  }
   bool required_escaping = false;
   for (int i = 0; i < src.length(); i++) {
+    // Copy the run of characters that need no escaping in one go.
+    int run_end = static_cast<int>(
+        FindCharacterToEscape(src.begin() + i, src.end()) - src.begin());
+    dest->AppendChars(src.SubVector(i, run_end));
+    i = run_end;
+    if (i == src.length()) break;
     SrcChar c = src[i];
-    if (raw_json || DoNotEscape(c)) {
-      dest->Append(c);
-    } else if (sizeof(SrcChar) != 1 &&
-               base::IsInRange(c, static_cast<SrcChar>(0xD800),
-                               static_cast<SrcChar>(0xDFFF))) {
+    if (sizeof(SrcChar) != 1 &&
+        base::IsInRange(c, static_cast<SrcChar>(0xD800),
+                        static_cast<SrcChar>(0xDFFF))) {
       // The current character is a surrogate.
       required_escaping = true;
       if (c <= 0xDBFF) {
@@ -1444,69 +1533,26 @@ bool JsonStringifier::SerializeString_(Tagged<String> string,
   int length = string->length();
   bool required_escaping = false;
   if (!raw_json) Append<uint8_t, DestChar>('"');
-  // We might be able to fit the whole escaped string in the current string
-  // part, or we might need to allocate.
+  // Escape the string in slices that are guaranteed to fit into the current
+  // part, extending the part in between as needed.
   base::Vector<const SrcChar> vector = string->GetCharVector<SrcChar>(no_gc);
-  if V8_LIKELY (EscapedLengthIfCurrentPartFits(length)) {
+  int start = 0;
+  while (start < length) {
+    int end = start + std::min(length - start, kMaxStringSliceLength);
+    // Don't split surrogate pairs.
+    if (sizeof(SrcChar) != 1 && end < length &&
+        unibrow::Utf16::IsLeadSurrogate(vector[end - 1])) {
+      end--;
+    }
+    while (!EscapedLengthIfCurrentPartFits(end - start)) Extend();
     NoExtendBuilder<DestChar> no_extend(
         reinterpret_cast<DestChar*>(part_ptr_) + current_index_,
         &current_index_);
-    required_escaping = SerializeStringUnchecked_<SrcChar, DestChar, raw_json>(
-        vector, &no_extend);
-  } else {
-    for (int i = 0; i < vector.length(); i++) {
-      SrcChar c = vector.at(i);
-      if (raw_json || DoNotEscape(c)) {
-        Append<SrcChar, DestChar>(c);
-      } else if (sizeof(SrcChar) != 1 &&
-                 base::IsInRange(c, static_cast<SrcChar>(0xD800),
-                                 static_cast<SrcChar>(0xDFFF))) {
-        // The current character is a surrogate.
-        required_escaping = true;
-        if (c <= 0xDBFF) {
-          // The current character is a leading surrogate.
-          if (i + 1 < vector.length()) {
-            // There is a next character.
-            SrcChar next = vector.at(i + 1);
-            if (base::IsInRange(next, static_cast<SrcChar>(0xDC00),
-                                static_cast<SrcChar>(0xDFFF))) {
-              // The next character is a trailing surrogate, meaning this is a
-              // surrogate pair.
-              Append<SrcChar, DestChar>(c);
-              Append<SrcChar, DestChar>(next);
-              i++;
-            } else {
-              // The next character is not a trailing surrogate. Thus, the
-              // current character is a lone leading surrogate.
-              AppendCStringLiteral("\\u");
-              char* const hex = DoubleToRadixCString(c, 16);
-              AppendCString(hex);
-              DeleteArray(hex);
-            }
-          } else {
-            // There is no next character. Thus, the current character is a
-            // lone leading surrogate.
-            AppendCStringLiteral("\\u");
-            char* const hex = DoubleToRadixCString(c, 16);
-            AppendCString(hex);
-            DeleteArray(hex);
-          }
-        } else {
-          // The current character is a lone trailing surrogate. (If it had
-          // been preceded by a leading surrogate, we would've ended up in the
-          // other branch earlier on, and the current character would've been
-          // handled as part of the surrogate pair already.)
-          AppendCStringLiteral("\\u");
-          char* const hex = DoubleToRadixCString(c, 16);
-          AppendCString(hex);
-          DeleteArray(hex);
-        }
-      } else {
-        DCHECK_LT(c, 0x60);
-        required_escaping = true;
-        AppendCString(&JsonEscapeTable[c * kJsonEscapeTableEntrySize]);
-      }
+    if (SerializeStringUnchecked_<SrcChar, DestChar, raw_json>(
+            vector.SubVector(start, end), &no_extend)) {
+      required_escaping = true;
     }
+    start = end;
   }
   if (!raw_json) Append<uint8_t, DestChar>('"');
   return required_escaping;
@@ -1572,6 +1618,16 @@ bool JsonStringifier::DoNotEscape(uint16_t c) {
          (c >= 0x23 && c != 0x5C && (c < 0xD800 || c > 0xDFFF));
 }
 
+template <typename Char>
+const Char* JsonStringifier::FindCharacterToEscape(const Char* begin,
+                                                   const Char* end) {
+#ifdef V8_JSON_SIMD
+  begin = json_simd::VectorizedSkip(begin, end,
+                                    json_simd::NeedsEscapingMask<Char>);
+#endif  // V8_JSON_SIMD
+  return std::find_if(begin, end, [](Char c) { return !DoNotEscape(c); });
+}
+
 void JsonStringifier::NewLine() {
   if (gap_ == nullptr) return;
   NewLineOutline();
@@ -1632,6 +1688,12 @@ bool JsonStringifier::SerializeString(Handle<String> object) {
 }
 
 void JsonStringifier::Extend() {
+  if (output_stream_ != nullptr && part_length_ >= kStreamingPartLength) {
+    // Make room by flushing the part instead of growing it. If nothing could
+    // be flushed, the part is too small for what is about to be appended and
+    // grows after all.
+    if (FlushToStream(false) > 0) return;
+  }
   if (part_length_ >= String::kMaxLength) {
     // Set the flag and carry on. Delay throwing the exception till the end.
     current_index_ = 0;
@@ -1667,5 +1729,59 @@ void JsonStringifier::ChangeEncoding() {
   one_byte_ptr_ = nullptr;
 }
 
+int JsonStringifier::FlushToStream(bool is_final) {
+  DCHECK_NOT_NULL(output_stream_);
+  int length = current_index_;
+  if (encoding_ == String::TWO_BYTE_ENCODING && !is_final && length > 0 &&
+      unibrow::Utf16::IsLeadSurrogate(two_byte_ptr_[length - 1])) {
+    length--;
+  }
+  if (length == 0) return 0;
+  if (!output_stream_aborted_) {
+    // Lone surrogates cannot occur in well-formed JSON.stringify output, but
+    // are replaced with U+FFFD just in case.
+    int previous = unibrow::Utf16::kNoPreviousCharacter;
+    char* utf8_end;
+    if (encoding_ == String::ONE_BYTE_ENCODING) {
+      utf8_buffer_.resize(unibrow::Utf8::kMax8BitCodeUnitSize *
+                          static_cast<size_t>(length));
+      utf8_end =
+          EncodeUtf8(base::Vector<const uint8_t>(one_byte_ptr_, length),
+                     utf8_buffer_.data(), true, &previous);
+    } else {
+      utf8_buffer_.resize(unibrow::Utf8::kMax16BitCodeUnitSize *
+                          static_cast<size_t>(length));
+      utf8_end =
+          EncodeUtf8(base::Vector<const base::uc16>(two_byte_ptr_, length),
+                     utf8_buffer_.data(), true, &previous);
+    }
+    WriteToStream(utf8_buffer_.data(), utf8_end - utf8_buffer_.data());
+  }
+  if (length < current_index_) {
+    DCHECK_EQ(length + 1, current_index_);
+    two_byte_ptr_[0] = two_byte_ptr_[length];
+  }
+  current_index_ -= length;
+  return length;
+}
+
+void JsonStringifier::WriteToStream(const char* data, size_t length) {
+  const size_t chunk_size =
+      static_cast<size_t>(std::max(1, output_stream_->GetChunkSize()));
+  while (length > 0) {
+    size_t size = std::min(length, chunk_size);
+    if (output_stream_->WriteAsciiChunk(const_cast<char*>(data),
+                                        static_cast<int>(size)) ==
+        v8::OutputStream::kAbort) {
+      // Keep serializing, as there is no way to bail out of the middle of an
+      // object, but drop the remaining output.
+      output_stream_aborted_ = true;
+      return;
+    }
+    data += size;
+    length -= size;
+  }
+}
+
 }  // namespace internal
 }  // namespace v8
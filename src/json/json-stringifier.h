@@ -8,12 +8,24 @@
 #include "src/objects/objects.h"
 
 namespace v8 {
+
+class OutputStream;
+
 namespace internal {
 
 V8_WARN_UNUSED_RESULT MaybeHandle<Object> JsonStringify(Isolate* isolate,
                                                         Handle<Object> object,
                                                         Handle<Object> replacer,
                                                         Handle<Object> gap);
+
+// Like JsonStringify, but writes the result as UTF-8 to |output_stream|
+// instead of creating a string. Returns false if |object| is not serializable
+// or the stream aborted, and Nothing if an exception was thrown. Output that
+// was written before an exception was thrown is not taken back.
+V8_WARN_UNUSED_RESULT Maybe<bool> JsonStringifyToStream(
+    Isolate* isolate, Handle<Object> object, Handle<Object> replacer,
+    Handle<Object> gap, v8::OutputStream* output_stream);
+
 }  // namespace internal
 }  // namespace v8
 
@@ -4,18 +4,32 @@
 
 #include "src/libplatform/default-worker-threads-task-runner.h"
 
+#include <algorithm>
+
 #include "src/base/platform/time.h"
 #include "src/libplatform/delayed-task-queue.h"
 
 namespace v8 {
 namespace platform {
 
+namespace {
+
+// The worker thread that runs on the current thread, if any.
+thread_local base::Thread* current_worker_thread = nullptr;
+
+}  // namespace
+
 DefaultWorkerThreadsTaskRunner::DefaultWorkerThreadsTaskRunner(
     uint32_t thread_pool_size, TimeFunction time_function,
     base::Thread::Priority priority)
     : queue_(time_function), time_function_(time_function) {
   for (uint32_t i = 0; i < thread_pool_size; ++i) {
-    thread_pool_.push_back(std::make_unique<WorkerThread>(this, priority));
+    thread_pool_.push_back(std::make_unique<WorkerThread>(this, i, priority));
+  }
+  // Workers access the whole pool when stealing, so only start them once the
+  // pool is complete.
+  for (auto& thread : thread_pool_) {
+    CHECK(thread->Start());
   }
 }
 
@@ -28,37 +42,61 @@ double DefaultWorkerThreadsTaskRunner::MonotonicallyIncreasingTime() {
 void DefaultWorkerThreadsTaskRunner::Terminate() {
   {
     base::MutexGuard guard(&lock_);
-    terminated_ = true;
+    if (terminated_.load(std::memory_order_relaxed)) return;
+    terminated_.store(true, std::memory_order_relaxed);
     queue_.Terminate();
+    for (WorkerThread* thread : idle_threads_) {
+      thread->set_is_idle(false);
+      thread->Notify();
+    }
     idle_threads_.clear();
+    num_idle_threads_.store(0, std::memory_order_relaxed);
+  }
+  // Workers steal from each other until they are done, so join all of them
+  // before destroying any.
+  for (auto& thread : thread_pool_) {
+    thread->Join();
   }
-  // Clearing the thread pool lets all worker threads join.
-  thread_pool_.clear();
 }
 
 void DefaultWorkerThreadsTaskRunner::PostTaskImpl(
     std::unique_ptr<Task> task, const SourceLocation& location) {
+  if (terminated_.load(std::memory_order_relaxed)) return;
+  bool queued = false;
+  if (WorkerThread* worker = CurrentWorkerThread()) {
+    if (!worker->local_queue().IsFull()) {
+      worker->local_queue().Push(std::move(task));
+      queued = true;
+    }
+  } else if (!thread_pool_.empty()) {
+    const size_t index =
+        next_external_queue_.fetch_add(1, std::memory_order_relaxed) %
+        thread_pool_.size();
+    queued = thread_pool_[index]->external_queue().TryPush(task);
+  }
+  if (queued) {
+    // Pairs with the fence in WorkerThread::GetNext(): Either an idle thread
+    // is observed here, or the idle thread observes the task before waiting.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (num_idle_threads_.load(std::memory_order_relaxed) == 0) return;
+    base::MutexGuard guard(&lock_);
+    NotifyIdleThread();
+    return;
+  }
+
   base::MutexGuard guard(&lock_);
-  if (terminated_) return;
+  if (terminated_.load(std::memory_order_relaxed)) return;
   queue_.Append(std::move(task));
-
-  if (!idle_threads_.empty()) {
-    idle_threads_.back()->Notify();
-    idle_threads_.pop_back();
-  }
+  NotifyIdleThread();
 }
 
 void DefaultWorkerThreadsTaskRunner::PostDelayedTaskImpl(
     std::unique_ptr<Task> task, double delay_in_seconds,
     const SourceLocation& location) {
   base::MutexGuard guard(&lock_);
-  if (terminated_) return;
+  if (terminated_.load(std::memory_order_relaxed)) return;
   queue_.AppendDelayed(std::move(task), delay_in_seconds);
-
-  if (!idle_threads_.empty()) {
-    idle_threads_.back()->Notify();
-    idle_threads_.pop_back();
-  }
+  NotifyIdleThread();
 }
 
 void DefaultWorkerThreadsTaskRunner::PostIdleTaskImpl(
@@ -72,46 +110,147 @@ bool DefaultWorkerThreadsTaskRunner::IdleTasksEnabled() {
   return false;
 }
 
+DefaultWorkerThreadsTaskRunner::WorkerThread*
+DefaultWorkerThreadsTaskRunner::CurrentWorkerThread() const {
+  auto* thread = static_cast<WorkerThread*>(current_worker_thread);
+  if (!thread || thread->runner() != this) return nullptr;
+  return thread;
+}
+
+bool DefaultWorkerThreadsTaskRunner::HasStealableTasks() const {
+  for (const auto& thread : thread_pool_) {
+    if (!thread->local_queue().IsEmpty() ||
+        !thread->external_queue().IsEmpty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void DefaultWorkerThreadsTaskRunner::NotifyIdleThread() {
+  lock_.AssertHeld();
+  if (idle_threads_.empty()) return;
+  WorkerThread* thread = idle_threads_.back();
+  thread->set_is_idle(false);
+  thread->Notify();
+  idle_threads_.pop_back();
+  num_idle_threads_.store(idle_threads_.size(), std::memory_order_relaxed);
+}
+
+void DefaultWorkerThreadsTaskRunner::AddIdleThread(WorkerThread* thread) {
+  lock_.AssertHeld();
+  DCHECK(!thread->is_idle());
+  thread->set_is_idle(true);
+  idle_threads_.push_back(thread);
+  num_idle_threads_.store(idle_threads_.size(), std::memory_order_relaxed);
+}
+
+void DefaultWorkerThreadsTaskRunner::RemoveIdleThread(WorkerThread* thread) {
+  lock_.AssertHeld();
+  // The thread was already removed if it was woken up by a new task.
+  if (!thread->is_idle()) return;
+  thread->set_is_idle(false);
+  auto it = std::find(idle_threads_.begin(), idle_threads_.end(), thread);
+  DCHECK_NE(idle_threads_.end(), it);
+  idle_threads_.erase(it);
+  num_idle_threads_.store(idle_threads_.size(), std::memory_order_relaxed);
+}
+
 DefaultWorkerThreadsTaskRunner::WorkerThread::WorkerThread(
-    DefaultWorkerThreadsTaskRunner* runner, base::Thread::Priority priority)
+    DefaultWorkerThreadsTaskRunner* runner, size_t index,
+    base::Thread::Priority priority)
     : Thread(
           Options("V8 DefaultWorkerThreadsTaskRunner WorkerThread", priority)),
-      runner_(runner) {
-  CHECK(Start());
+      runner_(runner),
+      index_(index) {}
+
+DefaultWorkerThreadsTaskRunner::WorkerThread::~WorkerThread() = default;
+
+void DefaultWorkerThreadsTaskRunner::WorkerThread::Run() {
+  current_worker_thread = this;
+  while (std::unique_ptr<Task> task = GetNext()) {
+    task->Run();
+  }
+  current_worker_thread = nullptr;
 }
 
-DefaultWorkerThreadsTaskRunner::WorkerThread::~WorkerThread() {
-  condition_var_.NotifyAll();
-  Join();
+std::unique_ptr<Task> DefaultWorkerThreadsTaskRunner::WorkerThread::GetNext() {
+  for (;;) {
+    if (tasks_until_shared_queue_check_ > 0) {
+      if (std::unique_ptr<Task> task = TakeLockFree()) {
+        --tasks_until_shared_queue_check_;
+        return task;
+      }
+    }
+    tasks_until_shared_queue_check_ = kSharedQueueCheckInterval;
+
+    bool terminated = false;
+    bool wait_indefinitely = false;
+    base::TimeDelta wait_time;
+    {
+      base::MutexGuard guard(&runner_->lock_);
+      DelayedTaskQueue::MaybeNextTask next_task = runner_->queue_.TryGetNext();
+      switch (next_task.state) {
+        case DelayedTaskQueue::MaybeNextTask::kTask:
+          return std::move(next_task.task);
+        case DelayedTaskQueue::MaybeNextTask::kTerminated:
+          // Help other workers with their remaining tasks before exiting.
+          terminated = true;
+          break;
+        case DelayedTaskQueue::MaybeNextTask::kWaitIndefinite:
+          wait_indefinitely = true;
+          runner_->AddIdleThread(this);
+          break;
+        case DelayedTaskQueue::MaybeNextTask::kWaitDelayed:
+          wait_time = next_task.wait_time;
+          runner_->AddIdleThread(this);
+          break;
+      }
+    }
+
+    // Pairs with the fence in PostTaskImpl(): Either the posting thread
+    // observes this thread as idle, or this thread observes the task. The
+    // lock-free queues are checked without holding |lock_|.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::unique_ptr<Task> task;
+    if (runner_->HasStealableTasks()) task = TakeLockFree();
+    if (terminated) return task;
+
+    base::MutexGuard guard(&runner_->lock_);
+    if (task) {
+      runner_->RemoveIdleThread(this);
+      return task;
+    }
+    // The thread is no longer idle if a task was posted in the meantime.
+    if (!is_idle_) continue;
+    if (wait_indefinitely) {
+      condition_var_.Wait(&runner_->lock_);
+    } else {
+      // WaitFor unfortunately doesn't care about our fake time and will
+      // wait the 'real' amount of time, based on whatever clock the
+      // system call uses.
+      bool notified = condition_var_.WaitFor(&runner_->lock_, wait_time);
+      USE(notified);
+    }
+    runner_->RemoveIdleThread(this);
+  }
 }
 
-void DefaultWorkerThreadsTaskRunner::WorkerThread::Run() {
-  base::MutexGuard guard(&runner_->lock_);
-  while (true) {
-    DelayedTaskQueue::MaybeNextTask next_task = runner_->queue_.TryGetNext();
-    switch (next_task.state) {
-      case DelayedTaskQueue::MaybeNextTask::kTask:
-        runner_->lock_.Unlock();
-        next_task.task->Run();
-        runner_->lock_.Lock();
-        continue;
-      case DelayedTaskQueue::MaybeNextTask::kTerminated:
-        return;
-      case DelayedTaskQueue::MaybeNextTask::kWaitIndefinite:
-        runner_->idle_threads_.push_back(this);
-        condition_var_.Wait(&runner_->lock_);
-        continue;
-      case DelayedTaskQueue::MaybeNextTask::kWaitDelayed:
-        // WaitFor unfortunately doesn't care about our fake time and will wait
-        // the 'real' amount of time, based on whatever clock the system call
-        // uses.
-        runner_->idle_threads_.push_back(this);
-        bool notified =
-            condition_var_.WaitFor(&runner_->lock_, next_task.wait_time);
-        USE(notified);
-        continue;
+std::unique_ptr<Task>
+DefaultWorkerThreadsTaskRunner::WorkerThread::TakeLockFree() {
+  if (std::unique_ptr<Task> task = local_queue_.Steal()) return task;
+  if (std::unique_ptr<Task> task = external_queue_.Steal()) return task;
+  const auto& thread_pool = runner_->thread_pool_;
+  for (size_t i = 1; i < thread_pool.size(); ++i) {
+    WorkerThread* victim = thread_pool[(index_ + i) % thread_pool.size()].get();
+    if (std::unique_ptr<Task> task = victim->local_queue().Steal()) {
+      return task;
+    }
+    if (std::unique_ptr<Task> task = victim->external_queue().Steal()) {
+      return task;
     }
   }
+  return nullptr;
 }
 
 void DefaultWorkerThreadsTaskRunner::WorkerThread::Notify() {
@@ -5,6 +5,7 @@
 #ifndef V8_LIBPLATFORM_DEFAULT_WORKER_THREADS_TASK_RUNNER_H_
 #define V8_LIBPLATFORM_DEFAULT_WORKER_THREADS_TASK_RUNNER_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -14,10 +15,18 @@
 #include "src/base/platform/mutex.h"
 #include "src/base/platform/platform.h"
 #include "src/libplatform/delayed-task-queue.h"
+#include "src/libplatform/work-stealing-queue.h"
 
 namespace v8 {
 namespace platform {
 
+// Runs tasks on a pool of worker threads. Tasks posted by a worker thread of
+// the pool go to a lock-free queue owned by that worker. Tasks posted from other
+// threads, e.g. job workers posted by DefaultJob, are distributed round-robin
+// over lock-free queues that every worker has for that purpose. Workers that
+// run out of tasks steal tasks from the queues of other workers before they
+// take |lock_|, which only guards delayed tasks, tasks that did not fit into
+// the lock-free queues, and the set of idle workers.
 class V8_PLATFORM_EXPORT DefaultWorkerThreadsTaskRunner
     : public NON_EXPORTED_BASE(TaskRunner) {
  public:
@@ -50,7 +59,7 @@ class V8_PLATFORM_EXPORT DefaultWorkerThreadsTaskRunner
   class WorkerThread : public base::Thread {
    public:
     explicit WorkerThread(DefaultWorkerThreadsTaskRunner* runner,
-                          base::Thread::Priority priority);
+                          size_t index, base::Thread::Priority priority);
     ~WorkerThread() override;
 
     WorkerThread(const WorkerThread&) = delete;
@@ -61,21 +70,79 @@ class V8_PLATFORM_EXPORT DefaultWorkerThreadsTaskRunner
 
     void Notify();
 
+    DefaultWorkerThreadsTaskRunner* runner() const { return runner_; }
+
+    // Queue of tasks posted by this thread.
+    WorkStealingQueue& local_queue() { return local_queue_; }
+    const WorkStealingQueue& local_queue() const { return local_queue_; }
+
+    // Queue of tasks posted from outside of the pool.
+    SharedWorkStealingQueue& external_queue() { return external_queue_; }
+    const SharedWorkStealingQueue& external_queue() const {
+      return external_queue_;
+    }
+
+    // Whether this thread is in |idle_threads_|. Guarded by |lock_|.
+    bool is_idle() const { return is_idle_; }
+    void set_is_idle(bool is_idle) { is_idle_ = is_idle; }
+
    private:
+    // The shared queue is checked after this many tasks taken from lock-free
+    // queues, so that delayed and overflowing tasks don't starve while workers
+    // keep posting to each other.
+    static constexpr size_t kSharedQueueCheckInterval = 32;
+
+    // Gets the next task (local, external, stolen, delayed or immediate) to be
+    // executed. Blocks if no task is available. Returns nullptr once the
+    // runner is terminated and no tasks are left.
+    std::unique_ptr<Task> GetNext();
+
+    // Takes a task from the queues of this thread, or steals one from the
+    // queues of another worker thread, without taking |lock_|.
+    std::unique_ptr<Task> TakeLockFree();
+
     DefaultWorkerThreadsTaskRunner* runner_;
+    const size_t index_;
     base::ConditionVariable condition_var_;
+    WorkStealingQueue local_queue_;
+    SharedWorkStealingQueue external_queue_;
+    bool is_idle_ = false;
+    size_t tasks_until_shared_queue_check_ = 0;
   };
 
-  // Called by the WorkerThread. Gets the next take (delayed or immediate) to be
-  // executed. Blocks if no task is available.
-  std::unique_ptr<Task> GetNext();
+  // Returns the worker thread of this runner that the current thread is, or
+  // nullptr if the current thread is not one of its workers.
+  WorkerThread* CurrentWorkerThread() const;
+
+  // Returns whether any worker thread has tasks in its lock-free queues. Does
+  // not require |lock_|.
+  bool HasStealableTasks() const;
+
+  // Wakes up an idle thread, if any. Requires |lock_| to be held.
+  void NotifyIdleThread();
+
+  // Marks |thread| as idle, or not idle, respectively. Requires |lock_| to be
+  // held.
+  void AddIdleThread(WorkerThread* thread);
+  void RemoveIdleThread(WorkerThread* thread);
 
-  bool terminated_ = false;
+  std::atomic<bool> terminated_{false};
   base::Mutex lock_;
   // Vector of idle threads -- these are pushed in LIFO order, so that the most
   // recently active thread is the first to be reactivated.
   std::vector<WorkerThread*> idle_threads_;
+  // Size of |idle_threads_|, which allows worker threads to post tasks to
+  // their local queue without taking |lock_| if no thread needs to be woken
+  // up.
+  std::atomic<size_t> num_idle_threads_{0};
+  // Worker threads steal from each other, so the pool is only modified before
+  // the threads are started and after all of them are joined. Threads that
+  // post from outside of the pool may still access it, which is why it is
+  // only cleared on destruction.
   std::vector<std::unique_ptr<WorkerThread>> thread_pool_;
+  // Index of the worker thread that the next task posted from outside of the
+  // pool is queued for.
+  std::atomic<size_t> next_external_queue_{0};
   // Worker threads access this queue, so we can only destroy it after all
   // workers stopped.
   DelayedTaskQueue queue_;
@@ -0,0 +1,177 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_LIBPLATFORM_WORK_STEALING_QUEUE_H_
+#define V8_LIBPLATFORM_WORK_STEALING_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+
+#include "include/v8-platform.h"
+#include "src/base/logging.h"
+
+namespace v8 {
+namespace platform {
+
+// Bounded lock-free queue of tasks in the style of a Chase-Lev deque. Only the
+// owning thread may push tasks, while any thread, including the owner, may
+// steal them. Tasks are taken in the order they are pushed.
+//
+// Unlike a Chase-Lev deque the owner does not take tasks from the bottom in
+// LIFO order, as that would run tasks that a worker posts out of order and
+// could starve old tasks as long as the worker keeps posting.
+class WorkStealingQueue final {
+ public:
+  static constexpr size_t kCapacity = 256;
+
+  WorkStealingQueue() = default;
+  ~WorkStealingQueue() { DCHECK(IsEmpty()); }
+
+  WorkStealingQueue(const WorkStealingQueue&) = delete;
+  WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+  // Returns whether the queue is full. May only be called by the owner, in
+  // which case the result can only become outdated towards not being full.
+  bool IsFull() const {
+    return bottom_.load(std::memory_order_relaxed) -
+               top_.load(std::memory_order_acquire) ==
+           kCapacity;
+  }
+
+  // Appends |task| to the queue. May only be called by the owner on a queue
+  // that is not full.
+  void Push(std::unique_ptr<Task> task) {
+    DCHECK(!IsFull());
+    const size_t bottom = bottom_.load(std::memory_order_relaxed);
+    tasks_[bottom % kCapacity].store(task.release(),
+                                     std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+  }
+
+  // Takes the oldest task from the queue. Returns nullptr if the queue is
+  // empty.
+  std::unique_ptr<Task> Steal() {
+    size_t top = top_.load(std::memory_order_acquire);
+    for (;;) {
+      if (top >= bottom_.load(std::memory_order_acquire)) return nullptr;
+      // The slot may be overwritten by the owner as soon as another thread
+      // steals the task, in which case the CAS below fails.
+      Task* task = tasks_[top % kCapacity].load(std::memory_order_relaxed);
+      if (top_.compare_exchange_weak(top, top + 1, std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+        return std::unique_ptr<Task>(task);
+      }
+    }
+  }
+
+  // Returns whether the queue is empty. The result may be outdated by the time
+  // it is returned unless called by the owner on a queue that no other thread
+  // steals from.
+  bool IsEmpty() const {
+    return top_.load(std::memory_order_relaxed) >=
+           bottom_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Index of the next task to steal.
+  std::atomic<size_t> top_{0};
+  // Index of the next task to push.
+  std::atomic<size_t> bottom_{0};
+  std::atomic<Task*> tasks_[kCapacity] = {};
+};
+
+// Bounded lock-free queue of tasks that any thread may push to and steal from,
+// based on Dmitry Vyukov's bounded MPMC queue. Tasks are taken in the order
+// they are pushed. Tasks that are left in the queue when it is destroyed are
+// deleted without running them.
+class SharedWorkStealingQueue final {
+ public:
+  static constexpr size_t kCapacity = 256;
+
+  SharedWorkStealingQueue() {
+    for (size_t i = 0; i < kCapacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  ~SharedWorkStealingQueue() {
+    while (Steal()) {
+    }
+  }
+
+  SharedWorkStealingQueue(const SharedWorkStealingQueue&) = delete;
+  SharedWorkStealingQueue& operator=(const SharedWorkStealingQueue&) = delete;
+
+  // Appends |task| to the queue. Returns false, leaving |task| untouched, if
+  // the queue is full.
+  bool TryPush(std::unique_ptr<Task>& task) {
+    size_t position = push_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[position % kCapacity];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      if (sequence == position) {
+        if (push_position_.compare_exchange_weak(position, position + 1,
+                                                 std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (sequence < position) {
+        // The cell still holds the task that was pushed one round earlier.
+        return false;
+      } else {
+        position = push_position_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->task.store(task.release(), std::memory_order_relaxed);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Takes the oldest task from the queue. Returns nullptr if the queue is
+  // empty, or if the oldest task is still being pushed.
+  std::unique_ptr<Task> Steal() {
+    size_t position = steal_position_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+      cell = &cells_[position % kCapacity];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      if (sequence == position + 1) {
+        if (steal_position_.compare_exchange_weak(position, position + 1,
+                                                  std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (sequence < position + 1) {
+        return nullptr;
+      } else {
+        position = steal_position_.load(std::memory_order_relaxed);
+      }
+    }
+    Task* task = cell->task.load(std::memory_order_relaxed);
+    cell->sequence.store(position + kCapacity, std::memory_order_release);
+    return std::unique_ptr<Task>(task);
+  }
+
+  // Returns whether the queue is empty. The result may be outdated by the time
+  // it is returned.
+  bool IsEmpty() const {
+    return steal_position_.load(std::memory_order_relaxed) >=
+           push_position_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct Cell {
+    // Equals the push position for which the cell is free, or that position
+    // plus one once the task is pushed.
+    std::atomic<size_t> sequence;
+    std::atomic<Task*> task{nullptr};
+  };
+
+  std::atomic<size_t> push_position_{0};
+  std::atomic<size_t> steal_position_{0};
+  Cell cells_[kCapacity];
+};
+
+}  // namespace platform
+}  // namespace v8
+
+#endif  // V8_LIBPLATFORM_WORK_STEALING_QUEUE_H_
@@ -4,12 +4,18 @@
 
 #include "src/objects/backing-store.h"
 
+#include <algorithm>
 #include <cstring>
+#include <deque>
 #include <optional>
+#include <vector>
 
+#include "include/v8-platform.h"
 #include "src/base/bits.h"
+#include "src/base/platform/platform.h"
 #include "src/execution/isolate.h"
 #include "src/handles/global-handles.h"
+#include "src/init/v8.h"
 #include "src/logging/counters.h"
 #include "src/sandbox/sandbox.h"
 
@@ -108,6 +114,178 @@ void RecordStatus(Isolate* isolate, AllocationStatus status) {
       static_cast<int>(status));
 }
 
+// Process-wide cache of page-aligned memory for mid-sized ArrayBuffer backing
+// stores (--pool-array-buffer-backing-stores). Freed stores are collected and
+// zeroed in batches on a worker thread before they are put into their size
+// class. The most recently freed blocks stay resident so that new stores don't
+// page fault. Older blocks are discarded, lazily with MADV_FREE where the OS
+// supports it and through the page allocator otherwise, and blocks beyond the
+// pool limit are unmapped. Discarded blocks read back as zero either way, so
+// pooled blocks are handed out without clearing them again.
+class BackingStorePool final {
+ public:
+  static constexpr size_t kMinSize = 64 * KB;
+  static constexpr size_t kMaxSize = 1 * MB;
+
+  static bool IsPoolable(size_t byte_length) {
+    return byte_length >= kMinSize && byte_length <= kMaxSize;
+  }
+
+  void* Allocate(size_t byte_length);
+  void Free(void* buffer_start, size_t byte_length);
+
+ private:
+  class ClearTask;
+
+  // A freed block whose first `byte_length` bytes may be non-zero.
+  struct DirtyBlock {
+    void* start;
+    size_t byte_length;
+  };
+
+  // Powers of two and their midpoints, so at most a third of a block is
+  // unused.
+  static constexpr size_t kSizeClasses[] = {
+      64 * KB, 96 * KB, 128 * KB, 192 * KB, 256 * KB,
+      384 * KB, 512 * KB, 768 * KB, 1 * MB};
+  static constexpr size_t kNumberOfSizeClasses = arraysize(kSizeClasses);
+
+  struct SizeClass {
+    // Free blocks, oldest first. The first `discarded` blocks have been
+    // discarded, the remaining ones are resident.
+    std::deque<void*> blocks;
+    size_t discarded = 0;
+  };
+
+  static size_t SizeClassIndex(size_t byte_length) {
+    DCHECK(IsPoolable(byte_length));
+    return std::lower_bound(std::begin(kSizeClasses), std::end(kSizeClasses),
+                            byte_length) -
+           std::begin(kSizeClasses);
+  }
+
+  size_t BlockSize(size_t index) const {
+    return RoundUp(kSizeClasses[index], page_allocator_->AllocatePageSize());
+  }
+
+  // Discards the oldest resident blocks, starting with the largest size
+  // class, until the resident size is within its limit.
+  void DiscardOldBlocks();
+  // Zeroes the blocks freed since the last call and adds them to their size
+  // classes.
+  void ClearDirtyBlocks();
+
+  v8::PageAllocator* const page_allocator_ = GetArrayBufferPageAllocator();
+  base::Mutex mutex_;
+  SizeClass size_classes_[kNumberOfSizeClasses];
+  std::vector<DirtyBlock> dirty_blocks_;
+  bool clear_task_pending_ = false;
+  size_t resident_bytes_ = 0;
+  // Includes dirty blocks.
+  size_t pooled_bytes_ = 0;
+};
+
+class BackingStorePool::ClearTask final : public v8::Task {
+ public:
+  explicit ClearTask(BackingStorePool* pool) : pool_(pool) {}
+
+  void Run() override { pool_->ClearDirtyBlocks(); }
+
+ private:
+  BackingStorePool* const pool_;
+};
+
+void* BackingStorePool::Allocate(size_t byte_length) {
+  const size_t index = SizeClassIndex(byte_length);
+  const size_t block_size = BlockSize(index);
+  {
+    base::MutexGuard guard(&mutex_);
+    SizeClass& size_class = size_classes_[index];
+    if (!size_class.blocks.empty()) {
+      // Prefer the most recently freed block, which is most likely resident.
+      void* block = size_class.blocks.back();
+      size_class.blocks.pop_back();
+      pooled_bytes_ -= block_size;
+      if (size_class.discarded > size_class.blocks.size()) {
+        size_class.discarded--;
+      } else {
+        resident_bytes_ -= block_size;
+      }
+      return block;
+    }
+  }
+  return AllocatePages(page_allocator_, nullptr, block_size,
+                       page_allocator_->AllocatePageSize(),
+                       PageAllocator::kReadWrite);
+}
+
+void BackingStorePool::Free(void* buffer_start, size_t byte_length) {
+  const size_t index = SizeClassIndex(byte_length);
+  const size_t block_size = BlockSize(index);
+  bool keep;
+  bool post_task = false;
+  {
+    base::MutexGuard guard(&mutex_);
+    keep = pooled_bytes_ + block_size <= v8_flags.array_buffer_pool_max_size;
+    if (keep) {
+      pooled_bytes_ += block_size;
+      dirty_blocks_.push_back({buffer_start, byte_length});
+      post_task = !clear_task_pending_;
+      clear_task_pending_ = true;
+    }
+  }
+  if (!keep) {
+    FreePages(page_allocator_, buffer_start, block_size);
+    return;
+  }
+  if (post_task) {
+    V8::GetCurrentPlatform()->CallOnWorkerThread(
+        std::make_unique<ClearTask>(this));
+  }
+}
+
+void BackingStorePool::ClearDirtyBlocks() {
+  std::vector<DirtyBlock> dirty_blocks;
+  {
+    base::MutexGuard guard(&mutex_);
+    dirty_blocks.swap(dirty_blocks_);
+    clear_task_pending_ = false;
+  }
+  for (const DirtyBlock& block : dirty_blocks) {
+    // Only the first `byte_length` bytes were accessible since the block was
+    // last zeroed.
+    memset(block.start, 0, block.byte_length);
+  }
+  base::MutexGuard guard(&mutex_);
+  for (const DirtyBlock& block : dirty_blocks) {
+    const size_t index = SizeClassIndex(block.byte_length);
+    size_classes_[index].blocks.push_back(block.start);
+    resident_bytes_ += BlockSize(index);
+  }
+  DiscardOldBlocks();
+}
+
+void BackingStorePool::DiscardOldBlocks() {
+  mutex_.AssertHeld();
+  while (resident_bytes_ > v8_flags.array_buffer_pool_resident_size) {
+    for (size_t index = kNumberOfSizeClasses; index-- > 0;) {
+      SizeClass& size_class = size_classes_[index];
+      if (size_class.discarded == size_class.blocks.size()) continue;
+      void* block = size_class.blocks[size_class.discarded++];
+      const size_t block_size = BlockSize(index);
+      // The block is zeroed, so it reads as zero whether or not the OS has
+      // reclaimed its pages by the time it is reused.
+      if (!base::OS::DiscardSystemPagesLazily(block, block_size)) {
+        USE(page_allocator_->DiscardSystemPages(block, block_size));
+      }
+      resident_bytes_ -= block_size;
+      break;
+    }
+  }
+}
+
+DEFINE_LAZY_LEAKY_OBJECT_GETTER(BackingStorePool, GetBackingStorePool)
+
 }  // namespace
 
 // The backing store for a Wasm shared memory remembers all the isolates
@@ -135,7 +313,8 @@ BackingStore::BackingStore(void* buffer_start, size_t byte_length,
       has_guard_regions_(has_guard_regions),
       globally_registered_(false),
       custom_deleter_(custom_deleter),
-      empty_deleter_(empty_deleter) {
+      empty_deleter_(empty_deleter),
+      pooled_(false) {
   // TODO(v8:11111): RAB / GSAB - Wasm integration.
   DCHECK_IMPLIES(is_wasm_memory_, !is_resizable_by_js_);
   DCHECK_IMPLIES(is_resizable_by_js_, !custom_deleter_);
@@ -212,6 +391,13 @@ BackingStore::~BackingStore() {
     return;
   }
 
+  if (pooled_) {
+    TRACE_BS("BS:pool   bs=%p mem=%p (length=%zu)\n", this, buffer_start_,
+             byte_length());
+    GetBackingStorePool()->Free(buffer_start_, byte_length_);
+    return;
+  }
+
   // JSArrayBuffer backing store. Deallocate through the embedder's allocator.
   auto allocator = get_v8_api_array_buffer_allocator();
   TRACE_BS("BS:free   bs=%p mem=%p (length=%zu, capacity=%zu)\n", this,
@@ -224,6 +410,7 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
     Isolate* isolate, size_t byte_length, SharedFlag shared,
     InitializedFlag initialized) {
   void* buffer_start = nullptr;
+  bool pooled = false;
   auto allocator = isolate->array_buffer_allocator();
   CHECK_NOT_NULL(allocator);
   if (byte_length != 0) {
@@ -242,8 +429,17 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
       return allocator->Allocate(byte_length);
     };
 
-    buffer_start = isolate->heap()->AllocateExternalBackingStore(
-        allocate_buffer, byte_length);
+    if (v8_flags.pool_array_buffer_backing_stores &&
+        BackingStorePool::IsPoolable(byte_length)) {
+      // Pooled memory is always zeroed, regardless of `initialized`.
+      pooled = true;
+      buffer_start = isolate->heap()->AllocateExternalBackingStore(
+          [](size_t length) { return GetBackingStorePool()->Allocate(length); },
+          byte_length);
+    } else {
+      buffer_start = isolate->heap()->AllocateExternalBackingStore(
+          allocate_buffer, byte_length);
+    }
 
     if (buffer_start == nullptr) {
       // Allocation failed.
@@ -272,6 +468,8 @@ std::unique_ptr<BackingStore> BackingStore::Allocate(
                                  false,   // custom_deleter
                                  false);  // empty_deleter
 
+  result->pooled_ = pooled;
+
   TRACE_BS("BS:alloc  bs=%p mem=%p (length=%zu)\n", result,
            result->buffer_start(), byte_length);
   result->SetAllocatorFromIsolate(isolate);
@@ -728,11 +926,23 @@ bool BackingStore::Reallocate(Isolate* isolate, size_t new_byte_length) {
   auto allocator = get_v8_api_array_buffer_allocator();
   CHECK_EQ(isolate->array_buffer_allocator(), allocator);
   CHECK_EQ(byte_length_, byte_capacity_);
-  START_ALLOW_USE_DEPRECATED()
-  void* new_start =
-      allocator->Reallocate(buffer_start_, byte_length_, new_byte_length);
-  END_ALLOW_USE_DEPRECATED()
-  if (!new_start) return false;
+  void* new_start;
+  if (pooled_) {
+    // Pooled memory doesn't belong to the embedder's allocator, so move the
+    // contents over to it.
+    new_start = allocator->Allocate(new_byte_length);
+    if (!new_start) return false;
+    memcpy(new_start, buffer_start_,
+           std::min(byte_length_.load(), new_byte_length));
+    GetBackingStorePool()->Free(buffer_start_, byte_length_);
+    pooled_ = false;
+  } else {
+    START_ALLOW_USE_DEPRECATED()
+    new_start =
+        allocator->Reallocate(buffer_start_, byte_length_, new_byte_length);
+    END_ALLOW_USE_DEPRECATED()
+    if (!new_start) return false;
+  }
   buffer_start_ = new_start;
   byte_capacity_ = new_byte_length;
   byte_length_ = new_byte_length;
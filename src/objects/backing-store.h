@@ -223,6 +223,9 @@ class V8_EXPORT_PRIVATE BackingStore : public BackingStoreBase {
   bool globally_registered_ : 1;
   const bool custom_deleter_ : 1;
   const bool empty_deleter_ : 1;
+  // Allocated from the process-wide backing store pool instead of the
+  // embedder's allocator (--pool-array-buffer-backing-stores).
+  bool pooled_ : 1;
 };
 
 // A global, per-process mapping from buffer addresses to backing stores
@@ -152,7 +152,8 @@ HeapSnapshot* HeapProfiler::TakeSnapshot(
 
 class FileOutputStream : public v8::OutputStream {
  public:
-  explicit FileOutputStream(const char* filename) : os_(filename) {}
+  explicit FileOutputStream(const char* filename)
+      : os_(filename, std::ios_base::out | std::ios_base::binary) {}
   ~FileOutputStream() override { os_.close(); }
 
   WriteResult WriteAsciiChunk(char* data, int size) override {
@@ -166,13 +167,30 @@ class FileOutputStream : public v8::OutputStream {
   std::ofstream os_;
 };
 
+namespace {
+
+void SerializeSnapshotToFile(HeapSnapshot* snapshot, const char* filename) {
+  FileOutputStream stream(filename);
+  if (v8_flags.heap_snapshot_binary) {
+    HeapSnapshotBinarySerializer serializer(snapshot);
+    serializer.Serialize(&stream);
+  } else {
+    HeapSnapshotJSONSerializer serializer(snapshot);
+    serializer.Serialize(&stream);
+  }
+}
+
+}  // namespace
+
 // Precondition: only call this if you have just completed a full GC cycle.
 void HeapProfiler::WriteSnapshotToDiskAfterGC() {
   // We need to set a stack marker for the stack walk performed by the
   // snapshot generator to work.
   heap()->stack().SetMarkerIfNeededAndCallback([this]() {
     int64_t time = V8::GetCurrentPlatform()->CurrentClockTimeMilliseconds();
-    std::string filename = "v8-heap-" + std::to_string(time) + ".heapsnapshot";
+    std::string filename = "v8-heap-" + std::to_string(time) +
+                           (v8_flags.heap_snapshot_binary ? ".heapsnapshot.bin"
+                                                          : ".heapsnapshot");
     v8::HeapProfiler::HeapSnapshotOptions options;
     std::unique_ptr<HeapSnapshot> result(
         new HeapSnapshot(this, options.snapshot_mode, options.numerics_mode));
@@ -180,9 +198,7 @@ void HeapProfiler::WriteSnapshotToDiskAfterGC() {
                                     options.global_object_name_resolver, heap(),
                                     options.stack_state);
     if (!generator.GenerateSnapshotAfterGC()) return;
-    FileOutputStream stream(filename.c_str());
-    HeapSnapshotJSONSerializer serializer(result.get());
-    serializer.Serialize(&stream);
+    SerializeSnapshotToFile(result.get(), filename.c_str());
     PrintF("Wrote heap snapshot to %s.\n", filename.c_str());
   });
 }
@@ -190,9 +206,7 @@ void HeapProfiler::WriteSnapshotToDiskAfterGC() {
 void HeapProfiler::TakeSnapshotToFile(
     const v8::HeapProfiler::HeapSnapshotOptions options, std::string filename) {
   HeapSnapshot* snapshot = TakeSnapshot(options);
-  FileOutputStream stream(filename.c_str());
-  HeapSnapshotJSONSerializer serializer(snapshot);
-  serializer.Serialize(&stream);
+  SerializeSnapshotToFile(snapshot, filename.c_str());
 }
 
 bool HeapProfiler::StartSamplingHeapProfiler(
@@ -4,9 +4,11 @@
 
 #include "src/profiler/heap-snapshot-generator.h"
 
+#include <atomic>
 #include <optional>
 #include <utility>
 
+#include "include/v8-platform.h"
 #include "src/api/api-inl.h"
 #include "src/base/vector.h"
 #include "src/codegen/assembler-inl.h"
@@ -16,7 +18,9 @@
 #include "src/handles/global-handles.h"
 #include "src/heap/combined-heap.h"
 #include "src/heap/heap.h"
+#include "src/heap/local-heap-inl.h"
 #include "src/heap/safepoint.h"
+#include "src/init/v8.h"
 #include "src/numbers/conversions.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/api-callbacks.h"
@@ -3736,4 +3740,261 @@ void HeapSnapshotJSONSerializer::SerializeLocations() {
   }
 }
 
+namespace {
+
+// Records are encoded in chunks of this many, which is also the granularity
+// of the work distributed to worker threads.
+constexpr size_t kBinaryRecordsPerChunk = 16 * KB;
+
+void WriteVarint(std::vector<uint8_t>* out, uint64_t value) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<uint8_t>(value) | 0x80);
+    value >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^
+         static_cast<uint64_t>(value >> 63);
+}
+
+template <typename EncodeRecord>
+class EncodeRecordsJob final : public JobTask {
+ public:
+  EncodeRecordsJob(size_t first_record, size_t count,
+                   std::vector<std::vector<uint8_t>>* buffers,
+                   const EncodeRecord& encode)
+      : first_record_(first_record),
+        count_(count),
+        buffers_(buffers),
+        encode_(encode) {}
+
+  void Run(JobDelegate* delegate) final {
+    while (!delegate->ShouldYield()) {
+      size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= buffers_->size()) return;
+      EncodeChunk(chunk);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    size_t next_chunk = next_chunk_.load(std::memory_order_relaxed);
+    return next_chunk >= buffers_->size() ? 0 : buffers_->size() - next_chunk;
+  }
+
+  void EncodeChunk(size_t chunk) {
+    std::vector<uint8_t>& buffer = (*buffers_)[chunk];
+    buffer.clear();
+    size_t start = first_record_ + chunk * kBinaryRecordsPerChunk;
+    size_t end =
+        std::min(start + kBinaryRecordsPerChunk, first_record_ + count_);
+    for (size_t i = start; i < end; i++) encode_(i, &buffer);
+  }
+
+ private:
+  const size_t first_record_;
+  const size_t count_;
+  std::vector<std::vector<uint8_t>>* const buffers_;
+  const EncodeRecord& encode_;
+  std::atomic<size_t> next_chunk_{0};
+};
+
+}  // namespace
+
+void HeapSnapshotBinarySerializer::Serialize(v8::OutputStream* stream) {
+  v8::base::ElapsedTimer timer;
+  timer.Start();
+  DCHECK_NULL(writer_);
+  writer_ = new OutputStreamWriter(stream);
+  SerializeImpl();
+  delete writer_;
+  writer_ = nullptr;
+
+  if (i::v8_flags.profile_heap_snapshot) {
+    base::OS::PrintError(
+        "[Binary serialization of heap snapshot took %0.3f ms]\n",
+        timer.Elapsed().InMillisecondsF());
+  }
+  timer.Stop();
+}
+
+void HeapSnapshotBinarySerializer::SerializeImpl() {
+  DCHECK_EQ(0, snapshot_->root()->index());
+  AssignStringIds();
+  SerializeHeader();
+  if (writer_->aborted()) return;
+  SerializeNodes();
+  if (writer_->aborted()) return;
+  SerializeEdges();
+  if (writer_->aborted()) return;
+  SerializeSamples();
+  if (writer_->aborted()) return;
+  SerializeLocations();
+  if (writer_->aborted()) return;
+  SerializeStrings();
+  if (writer_->aborted()) return;
+  writer_->Finalize();
+}
+
+uint32_t HeapSnapshotBinarySerializer::GetStringId(const char* s) {
+  base::HashMap::Entry* cache_entry = strings_.LookupOrInsert(
+      const_cast<char*>(s), HeapSnapshotJSONSerializer::StringHash(s));
+  if (cache_entry->value == nullptr) {
+    cache_entry->value = reinterpret_cast<void*>(next_string_id_++);
+  }
+  return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(cache_entry->value));
+}
+
+void HeapSnapshotBinarySerializer::AssignStringIds() {
+  // Interning the strings is the only part of the encoding that depends on
+  // the records before it, so it is done up front on the main thread.
+  const std::deque<HeapEntry>& entries = snapshot_->entries();
+  node_names_.reserve(entries.size());
+  for (const HeapEntry& entry : entries) {
+    node_names_.push_back(GetStringId(entry.name()));
+  }
+  const std::vector<HeapGraphEdge*>& edges = snapshot_->children();
+  edge_names_or_indices_.reserve(edges.size());
+  for (const HeapGraphEdge* edge : edges) {
+    edge_names_or_indices_.push_back(
+        edge->type() == HeapGraphEdge::kElement ||
+                edge->type() == HeapGraphEdge::kHidden
+            ? edge->index()
+            : GetStringId(edge->name()));
+  }
+}
+
+void HeapSnapshotBinarySerializer::WriteBuffer(
+    const std::vector<uint8_t>& buffer) {
+  writer_->AddBytes(buffer.data(), buffer.size());
+}
+
+template <typename EncodeRecord>
+void HeapSnapshotBinarySerializer::SerializeRecords(
+    size_t count, const EncodeRecord& encode) {
+  // Encode a bounded window of chunks at a time, so that the memory needed
+  // for buffering does not grow with the size of the snapshot.
+  const size_t window_chunks =
+      2 * (V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1);
+  std::vector<std::vector<uint8_t>> buffers;
+  for (size_t first = 0; first < count;
+       first += window_chunks * kBinaryRecordsPerChunk) {
+    size_t window_count =
+        std::min(count - first, window_chunks * kBinaryRecordsPerChunk);
+    buffers.resize((window_count + kBinaryRecordsPerChunk - 1) /
+                   kBinaryRecordsPerChunk);
+    auto job = std::make_unique<EncodeRecordsJob<EncodeRecord>>(
+        first, window_count, &buffers, encode);
+    if (buffers.size() == 1) {
+      job->EncodeChunk(0);
+    } else {
+      std::unique_ptr<JobHandle> job_handle =
+          V8::GetCurrentPlatform()->CreateJob(TaskPriority::kUserBlocking,
+                                              std::move(job));
+      // Join while parked, so that safepoints requested by other threads are
+      // not held up. Snapshots written from within a GC are serialized in
+      // place.
+      Heap* heap = snapshot_->profiler()->heap();
+      if (heap->gc_state() == Heap::NOT_IN_GC) {
+        heap->main_thread_local_heap()->ExecuteMainThreadWhileParked(
+            [&job_handle]() { job_handle->Join(); });
+      } else {
+        job_handle->Join();
+      }
+    }
+    for (const std::vector<uint8_t>& buffer : buffers) {
+      WriteBuffer(buffer);
+      if (writer_->aborted()) return;
+    }
+  }
+}
+
+void HeapSnapshotBinarySerializer::SerializeHeader() {
+  std::vector<uint8_t> buffer(std::begin(kMagic), std::end(kMagic));
+  buffer.push_back(kVersion);
+  WriteVarint(&buffer, snapshot_->entries().size());
+  WriteVarint(&buffer, snapshot_->children().size());
+  WriteVarint(&buffer,
+              snapshot_->profiler()->heap_object_map()->samples().size());
+  WriteVarint(&buffer, snapshot_->locations().size());
+  WriteBuffer(buffer);
+}
+
+void HeapSnapshotBinarySerializer::SerializeNodes() {
+  const std::deque<HeapEntry>& entries = snapshot_->entries();
+  SerializeRecords(entries.size(), [&](size_t i, std::vector<uint8_t>* out) {
+    const HeapEntry& entry = entries[i];
+    // Ids mostly increase by small steps, so store the difference to the
+    // previous node's id.
+    int64_t previous_id = i == 0 ? 0 : entries[i - 1].id();
+    WriteVarint(out, entry.type());
+    WriteVarint(out, node_names_[i]);
+    WriteVarint(out, ZigZagEncode(entry.id() - previous_id));
+    WriteVarint(out, entry.self_size());
+    WriteVarint(out, entry.children_count());
+    WriteVarint(out, entry.trace_node_id());
+    WriteVarint(out, entry.detachedness());
+  });
+}
+
+void HeapSnapshotBinarySerializer::SerializeEdges() {
+  const std::vector<HeapGraphEdge*>& edges = snapshot_->children();
+  SerializeRecords(edges.size(), [&](size_t i, std::vector<uint8_t>* out) {
+    DCHECK(i == 0 ||
+           edges[i - 1]->from()->index() <= edges[i]->from()->index());
+    WriteVarint(out, edges[i]->type());
+    WriteVarint(out, edge_names_or_indices_[i]);
+    WriteVarint(out, edges[i]->to()->index());
+  });
+}
+
+void HeapSnapshotBinarySerializer::SerializeLocations() {
+  const std::vector<EntrySourceLocation>& locations = snapshot_->locations();
+  SerializeRecords(locations.size(),
+                   [&](size_t i, std::vector<uint8_t>* out) {
+                     const EntrySourceLocation& location = locations[i];
+                     // Like in the JSON format, these are unsigned.
+                     WriteVarint(out,
+                                 static_cast<uint32_t>(location.entry_index));
+                     WriteVarint(out, static_cast<uint32_t>(location.scriptId));
+                     WriteVarint(out, static_cast<uint32_t>(location.line));
+                     WriteVarint(out, static_cast<uint32_t>(location.col));
+                   });
+}
+
+void HeapSnapshotBinarySerializer::SerializeSamples() {
+  const std::vector<HeapObjectsMap::TimeInterval>& samples =
+      snapshot_->profiler()->heap_object_map()->samples();
+  std::vector<uint8_t> buffer;
+  for (const HeapObjectsMap::TimeInterval& sample : samples) {
+    base::TimeDelta time_delta = sample.timestamp - samples[0].timestamp;
+    WriteVarint(&buffer, time_delta.InMicroseconds());
+    WriteVarint(&buffer, sample.last_assigned_id());
+  }
+  WriteBuffer(buffer);
+}
+
+void HeapSnapshotBinarySerializer::SerializeStrings() {
+  std::vector<const char*> sorted_strings(strings_.occupancy());
+  for (base::HashMap::Entry* entry = strings_.Start(); entry != nullptr;
+       entry = strings_.Next(entry)) {
+    uintptr_t id = reinterpret_cast<uintptr_t>(entry->value);
+    sorted_strings[id - 1] = reinterpret_cast<const char*>(entry->key);
+  }
+  // Strings are stored as they are, i.e. as UTF-8, which leaves escaping to
+  // the consumer.
+  std::vector<uint8_t> buffer;
+  WriteVarint(&buffer, sorted_strings.size());
+  WriteBuffer(buffer);
+  for (const char* string : sorted_strings) {
+    size_t length = strlen(string);
+    buffer.clear();
+    WriteVarint(&buffer, length);
+    WriteBuffer(buffer);
+    writer_->AddBytes(reinterpret_cast<const uint8_t*>(string), length);
+    if (writer_->aborted()) return;
+  }
+}
+
 }  // namespace v8::internal
@@ -778,10 +778,60 @@ class HeapSnapshotJSONSerializer {
   int next_string_id_;
   OutputStreamWriter* writer_;
 
+  friend class HeapSnapshotBinarySerializer;
   friend class HeapSnapshotJSONSerializerEnumerator;
   friend class HeapSnapshotJSONSerializerIterator;
 };
 
+// Writes a snapshot in the compact binary format described at
+// v8::HeapSnapshot::kBinary. Nodes and edges are encoded as varints in
+// chunks on worker threads, and the chunks are written to the stream in
+// order as they become available, so that only a bounded part of the output
+// is buffered at a time.
+class HeapSnapshotBinarySerializer {
+ public:
+  static constexpr char kMagic[] = {'V', '8', 'H', 'S'};
+  static constexpr uint8_t kVersion = 1;
+
+  explicit HeapSnapshotBinarySerializer(HeapSnapshot* snapshot)
+      : snapshot_(snapshot), strings_(StringsMatch), writer_(nullptr) {}
+  HeapSnapshotBinarySerializer(const HeapSnapshotBinarySerializer&) = delete;
+  HeapSnapshotBinarySerializer& operator=(const HeapSnapshotBinarySerializer&) =
+      delete;
+  void Serialize(v8::OutputStream* stream);
+
+ private:
+  V8_INLINE static bool StringsMatch(void* key1, void* key2) {
+    return strcmp(reinterpret_cast<char*>(key1),
+                  reinterpret_cast<char*>(key2)) == 0;
+  }
+
+  uint32_t GetStringId(const char* s);
+  void AssignStringIds();
+  // Encodes |count| records with |encode| on worker threads and writes them
+  // to the stream in order.
+  template <typename EncodeRecord>
+  void SerializeRecords(size_t count, const EncodeRecord& encode);
+  void SerializeImpl();
+  void SerializeHeader();
+  void SerializeNodes();
+  void SerializeEdges();
+  void SerializeSamples();
+  void SerializeLocations();
+  void SerializeStrings();
+  void WriteBuffer(const std::vector<uint8_t>& buffer);
+
+  HeapSnapshot* snapshot_;
+  base::CustomMatcherHashMap strings_;
+  uint32_t next_string_id_ = 1;
+  // String ids of the node names and of the edge names, indexed like
+  // snapshot_->entries() and snapshot_->children(). Element and hidden edges
+  // store their index instead.
+  std::vector<uint32_t> node_names_;
+  std::vector<uint32_t> edge_names_or_indices_;
+  OutputStreamWriter* writer_;
+};
+
 }  // namespace v8::internal
 
 #endif  // V8_PROFILER_HEAP_SNAPSHOT_GENERATOR_H_
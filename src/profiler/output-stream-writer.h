@@ -72,6 +72,20 @@ class OutputStreamWriter {
       MaybeWriteChunk();
     }
   }
+  // Like AddSubstring, but for arbitrary bytes including '\0'.
+  void AddBytes(const uint8_t* bytes, size_t n) {
+    const uint8_t* end = bytes + n;
+    while (bytes < end) {
+      size_t bytes_chunk_size =
+          std::min(static_cast<size_t>(chunk_size_ - chunk_pos_),
+                   static_cast<size_t>(end - bytes));
+      DCHECK_GT(bytes_chunk_size, 0);
+      MemCopy(chunk_.begin() + chunk_pos_, bytes, bytes_chunk_size);
+      bytes += bytes_chunk_size;
+      chunk_pos_ += static_cast<int>(bytes_chunk_size);
+      MaybeWriteChunk();
+    }
+  }
   void AddNumber(unsigned n) { AddNumberImpl<unsigned>(n, "%u"); }
   void Finalize() {
     if (aborted_) return;
@@ -2,11 +2,20 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+#include "src/codegen/compiler.h"
+#include "src/debug/debug.h"
 #include "src/execution/arguments-inl.h"
 #include "src/execution/isolate-inl.h"
 #include "src/execution/protectors-inl.h"
 #include "src/heap/factory.h"
 #include "src/heap/heap-inl.h"  // For ToBoolean. TODO(jkummerow): Drop.
+#include "src/interpreter/bytecode-array-iterator.h"
 #include "src/objects/allocation-site-inl.h"
 #include "src/objects/elements.h"
 #include "src/objects/js-array-inl.h"
@@ -421,5 +430,139 @@ RUNTIME_FUNCTION(Runtime_ArrayIndexOf) {
   return Smi::FromInt(-1);
 }
 
+namespace {
+
+enum class NumericComparator { kNone, kAscending, kDescending };
+
+// Recognizes comparators whose bytecode is exactly
+//
+//   Ldar a<i>
+//   Sub a<j>, [slot]
+//   Return
+//
+// where a<i> and a<j> are the first two parameters, i.e. (a, b) => a - b
+// (which loads b and subtracts it from a) and (a, b) => b - a. Anything else,
+// including the same expression with additional statements, is left to the
+// generic sort.
+NumericComparator ClassifyComparator(Isolate* isolate,
+                                     Handle<JSFunction> function) {
+  if (!function->shared()->IsUserJavaScript()) return NumericComparator::kNone;
+  // Keep comparator calls observable to the debugger and to coverage.
+  if (isolate->debug()->is_active() ||
+      !isolate->is_best_effort_code_coverage()) {
+    return NumericComparator::kNone;
+  }
+  Handle<SharedFunctionInfo> shared(function->shared(), isolate);
+  IsCompiledScope is_compiled_scope(shared->is_compiled_scope(isolate));
+  if (!is_compiled_scope.is_compiled() &&
+      !Compiler::Compile(isolate, shared, Compiler::CLEAR_EXCEPTION,
+                         &is_compiled_scope)) {
+    return NumericComparator::kNone;
+  }
+  if (!shared->HasBytecodeArray()) return NumericComparator::kNone;
+
+  Handle<BytecodeArray> bytecode(shared->GetBytecodeArray(isolate), isolate);
+  interpreter::BytecodeArrayIterator it(bytecode);
+  auto parameter_index = [&]() {
+    interpreter::Register reg = it.GetRegisterOperand(0);
+    return reg.is_parameter() ? reg.ToParameterIndex() : -1;
+  };
+
+  if (it.done() || it.current_bytecode() != interpreter::Bytecode::kLdar) {
+    return NumericComparator::kNone;
+  }
+  int subtrahend = parameter_index();
+  it.Advance();
+  if (it.done() || it.current_bytecode() != interpreter::Bytecode::kSub) {
+    return NumericComparator::kNone;
+  }
+  int minuend = parameter_index();
+  it.Advance();
+  if (it.done() || it.current_bytecode() != interpreter::Bytecode::kReturn) {
+    return NumericComparator::kNone;
+  }
+  it.Advance();
+  if (!it.done()) return NumericComparator::kNone;
+
+  // Parameter index 0 is the receiver.
+  if (minuend == 1 && subtrahend == 2) return NumericComparator::kAscending;
+  if (minuend == 2 && subtrahend == 1) return NumericComparator::kDescending;
+  return NumericComparator::kNone;
+}
+
+template <typename T>
+void SortNumbers(std::vector<T>* values, NumericComparator comparator) {
+  // Equal Smis are indistinguishable, but the comparator treats -0 and +0 as
+  // equal, so doubles have to keep their relative order.
+  constexpr bool kStable = std::is_floating_point_v<T>;
+  if (comparator == NumericComparator::kAscending) {
+    if constexpr (kStable) {
+      std::stable_sort(values->begin(), values->end(), std::less<T>());
+    } else {
+      std::sort(values->begin(), values->end(), std::less<T>());
+    }
+  } else {
+    if constexpr (kStable) {
+      std::stable_sort(values->begin(), values->end(), std::greater<T>());
+    } else {
+      std::sort(values->begin(), values->end(), std::greater<T>());
+    }
+  }
+}
+
+}  // namespace
+
+// Sorts a packed Smi or double array in place if |comparefn| is one of the
+// comparators recognized by ClassifyComparator. Returns false, without
+// touching the array, if the generic sort has to be used instead. Since the
+// elements are numbers, the comparator has no observable side effects and
+// sorting natively yields the same result as calling it.
+RUNTIME_FUNCTION(Runtime_ArraySortNumeric) {
+  HandleScope scope(isolate);
+  DCHECK_EQ(2, args.length());
+  Handle<JSArray> array = args.at<JSArray>(0);
+  Handle<Object> comparefn = args.at(1);
+  ReadOnlyRoots roots(isolate);
+
+  if (!IsJSFunction(*comparefn)) return roots.false_value();
+  NumericComparator comparator =
+      ClassifyComparator(isolate, Cast<JSFunction>(comparefn));
+  if (comparator == NumericComparator::kNone) return roots.false_value();
+
+  // Compilation does not run JavaScript, but check the array again anyway.
+  ElementsKind kind = array->GetElementsKind();
+  if (kind != PACKED_SMI_ELEMENTS && kind != PACKED_DOUBLE_ELEMENTS) {
+    return roots.false_value();
+  }
+  JSObject::EnsureWritableFastElements(array);
+
+  DisallowGarbageCollection no_gc;
+  int length = Smi::ToInt(array->length());
+  if (kind == PACKED_SMI_ELEMENTS) {
+    Tagged<FixedArray> elements = Cast<FixedArray>(array->elements());
+    std::vector<int> values(length);
+    for (int i = 0; i < length; i++) {
+      values[i] = Smi::ToInt(elements->get(i));
+    }
+    SortNumbers(&values, comparator);
+    for (int i = 0; i < length; i++) {
+      elements->set(i, Smi::FromInt(values[i]));
+    }
+  } else {
+    Tagged<FixedDoubleArray> elements =
+        Cast<FixedDoubleArray>(array->elements());
+    std::vector<double> values(length);
+    for (int i = 0; i < length; i++) {
+      values[i] = elements->get_scalar(i);
+      // With NaNs, a - b is not a consistent comparator, and the result
+      // depends on the exact sequence of comparisons.
+      if (std::isnan(values[i])) return roots.false_value();
+    }
+    SortNumbers(&values, comparator);
+    for (int i = 0; i < length; i++) elements->set(i, values[i]);
+  }
+  return roots.true_value();
+}
+
 }  // namespace internal
 }  // namespace v8
@@ -6,6 +6,7 @@
 #include "src/common/globals.h"
 #include "src/execution/arguments-inl.h"
 #include "src/execution/isolate-inl.h"
+#include "src/heap/pretenuring-handler.h"
 #include "src/objects/allocation-site-scopes-inl.h"
 #include "src/objects/hash-table-inl.h"
 #include "src/objects/heap-number-inl.h"
@@ -555,6 +556,17 @@ MaybeHandle<JSObject> CreateLiteral(Isolate* isolate,
     RETURN_ON_EXCEPTION(isolate, DeepWalk(boilerplate, &creation_context));
     creation_context.ExitScope(site, boilerplate);
 
+    PretenuringHandler* pretenuring_handler =
+        isolate->heap()->pretenuring_handler();
+    if (V8_UNLIKELY(v8_flags.cache_pretenuring_decisions)) {
+      pretenuring_handler->RecordLiteralAllocationSite(*vector, literals_slot,
+                                                       *site);
+    }
+    if (V8_UNLIKELY(pretenuring_handler->HasImportedPretenuringDecisions())) {
+      pretenuring_handler->ApplyImportedPretenuringDecision(
+          *vector, literals_slot, *site);
+    }
+
     vector->SynchronizedSet(literals_slot, *site);
   }
 
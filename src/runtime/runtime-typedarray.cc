@@ -2,14 +2,26 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
+#include <vector>
+
+#include "include/v8-platform.h"
 #include "src/base/atomicops.h"
+#include "src/base/platform/memory.h"
 #include "src/common/message-template.h"
 #include "src/execution/arguments-inl.h"
+#include "src/execution/local-isolate-inl.h"
+#include "src/flags/flags.h"
 #include "src/heap/factory.h"
+#include "src/init/v8.h"
 #include "src/objects/elements.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/objects-inl.h"
 #include "src/runtime/runtime.h"
+#include "src/utils/allocation.h"
+#include "src/utils/memcopy.h"
 
 namespace v8 {
 namespace internal {
@@ -76,23 +88,263 @@ RUNTIME_FUNCTION(Runtime_GrowableSharedArrayBufferByteLength) {
 
 namespace {
 
-template <typename T>
-bool CompareNum(T x, T y) {
-  if (x < y) {
-    return true;
-  } else if (x > y) {
-    return false;
-  } else if (!std::is_integral<T>::value) {
-    double _x = x, _y = y;
-    if (x == 0 && x == y) {
-      /* -0.0 is less than +0.0 */
-      return std::signbit(_x) && !std::signbit(_y);
-    } else if (!std::isnan(_x) && std::isnan(_y)) {
-      /* number is less than NaN */
-      return true;
+// TypedArray.prototype.sort without a comparator orders numerically, with -0
+// before +0 and NaNs at the end. Elements of every type are sorted by mapping
+// their bits to unsigned integer keys whose order is that order, sorting the
+// keys, and mapping them back. For floats, positive numbers get their sign bit
+// set and negative numbers all bits flipped; NaNs are canonicalized first so
+// that they get the largest key.
+//
+// Arrays of more than a few hundred elements are sorted with an LSD radix
+// sort on the keys, which takes a fixed number of branch-free passes over the
+// data instead of std::sort's O(n log n) mispredicted comparisons, and which
+// can split each pass over worker threads (--parallel-typed-array-sort).
+enum class SortKind { kUnsigned, kSigned, kFloat };
+
+template <typename ctype>
+using SortKey = std::conditional_t<
+    sizeof(ctype) == 1, uint8_t,
+    std::conditional_t<sizeof(ctype) == 2, uint16_t,
+                       std::conditional_t<sizeof(ctype) == 4, uint32_t,
+                                          uint64_t>>>;
+
+template <SortKind kind, typename Key>
+V8_INLINE Key ToSortKey(Key bits) {
+  constexpr Key kSignBit = Key{1} << (sizeof(Key) * kBitsPerByte - 1);
+  if constexpr (kind == SortKind::kUnsigned) {
+    return bits;
+  } else if constexpr (kind == SortKind::kSigned) {
+    return bits ^ kSignBit;
+  } else {
+    // Float16, Float32 or Float64.
+    constexpr int kMantissaBits =
+        sizeof(Key) == 2 ? 10 : (sizeof(Key) == 4 ? 23 : 52);
+    constexpr Key kInfinity =
+        static_cast<Key>(~kSignBit & ~((Key{1} << kMantissaBits) - 1));
+    constexpr Key kQuietNaN =
+        static_cast<Key>(kInfinity | (Key{1} << (kMantissaBits - 1)));
+    if ((bits & ~kSignBit) > kInfinity) bits = kQuietNaN;
+    return (bits & kSignBit) ? static_cast<Key>(~bits)
+                             : static_cast<Key>(bits | kSignBit);
+  }
+}
+
+template <SortKind kind, typename Key>
+V8_INLINE Key FromSortKey(Key key) {
+  constexpr Key kSignBit = Key{1} << (sizeof(Key) * kBitsPerByte - 1);
+  if constexpr (kind == SortKind::kUnsigned) {
+    return key;
+  } else if constexpr (kind == SortKind::kSigned) {
+    return key ^ kSignBit;
+  } else {
+    return (key & kSignBit) ? static_cast<Key>(key ^ kSignBit)
+                            : static_cast<Key>(~key);
+  }
+}
+
+constexpr int kRadixBits = 8;
+constexpr size_t kRadixBuckets = size_t{1} << kRadixBits;
+// Shorter arrays are sorted with std::sort.
+constexpr size_t kRadixSortMinLength = 512;
+// With --parallel-typed-array-sort, arrays of at least this length are split
+// into chunks of at least kParallelSortMinChunkLength elements.
+constexpr size_t kParallelSortMinLength = size_t{1} << 20;
+constexpr size_t kParallelSortMinChunkLength = size_t{1} << 18;
+
+template <typename Key>
+V8_INLINE size_t RadixDigit(Key key, int pass) {
+  return static_cast<size_t>(key >> (pass * kRadixBits)) & (kRadixBuckets - 1);
+}
+
+// Sorts |keys| using |scratch| as the other buffer of each pass, and returns
+// whichever of the two holds the result.
+template <typename Key>
+Key* RadixSort(Key* keys, Key* scratch, size_t length) {
+  constexpr int kPasses = sizeof(Key);
+  // The number of keys per digit does not depend on their order, so the
+  // histograms of all passes are computed upfront in a single pass.
+  std::vector<size_t> counts(kPasses * kRadixBuckets);
+  for (size_t i = 0; i < length; i++) {
+    for (int pass = 0; pass < kPasses; pass++) {
+      counts[pass * kRadixBuckets + RadixDigit(keys[i], pass)]++;
+    }
+  }
+  for (int pass = 0; pass < kPasses; pass++) {
+    size_t* offsets = &counts[pass * kRadixBuckets];
+    // Skip passes in which all keys have the same digit, like the high bytes
+    // of small integers.
+    if (offsets[RadixDigit(keys[0], pass)] == length) continue;
+    size_t sum = 0;
+    for (size_t digit = 0; digit < kRadixBuckets; digit++) {
+      size_t count = offsets[digit];
+      offsets[digit] = sum;
+      sum += count;
+    }
+    for (size_t i = 0; i < length; i++) {
+      Key key = keys[i];
+      scratch[offsets[RadixDigit(key, pass)]++] = key;
+    }
+    std::swap(keys, scratch);
+  }
+  return keys;
+}
+
+// Calls |function| for 0 <= item < |num_items| on worker threads and the
+// current thread, and returns once all items are done.
+template <typename Function>
+class ParallelSortJob final : public JobTask {
+ public:
+  ParallelSortJob(size_t num_items, const Function& function)
+      : num_items_(num_items), function_(function) {}
+
+  void Run(JobDelegate* delegate) final {
+    while (!delegate->ShouldYield()) {
+      size_t item = next_item_.fetch_add(1, std::memory_order_relaxed);
+      if (item >= num_items_) return;
+      function_(item);
+    }
+  }
+
+  size_t GetMaxConcurrency(size_t worker_count) const final {
+    size_t next_item = next_item_.load(std::memory_order_relaxed);
+    return next_item >= num_items_ ? 0 : num_items_ - next_item;
+  }
+
+ private:
+  const size_t num_items_;
+  const Function& function_;
+  std::atomic<size_t> next_item_{0};
+};
+
+template <typename Function>
+void RunParallelSortJob(Isolate* isolate, size_t num_items,
+                        const Function& function) {
+  std::unique_ptr<JobHandle> job_handle = V8::GetCurrentPlatform()->CreateJob(
+      TaskPriority::kUserBlocking,
+      std::make_unique<ParallelSortJob<Function>>(num_items, function));
+  // The main thread contributes to the job while parked, so that it does not
+  // hold up safepoints requested by other threads in the meantime.
+  isolate->main_thread_local_isolate()->ExecuteMainThreadWhileParked(
+      [&job_handle]() { job_handle->Join(); });
+}
+
+// Like RadixSort, but each pass is split into |num_chunks| chunks of the
+// input. Every chunk computes its own histogram, and the prefix sums over
+// all chunks' histograms give each chunk its own range of every output
+// bucket, so that the chunks can scatter their keys independently while
+// keeping the sort stable.
+template <typename Key>
+Key* ParallelRadixSort(Isolate* isolate, Key* keys, Key* scratch,
+                       size_t length, size_t num_chunks) {
+  constexpr int kPasses = sizeof(Key);
+  std::vector<size_t> counts(num_chunks * kRadixBuckets);
+  auto chunk_start = [&](size_t chunk) { return length * chunk / num_chunks; };
+  for (int pass = 0; pass < kPasses; pass++) {
+    auto count = [&](size_t chunk) {
+      size_t* chunk_counts = &counts[chunk * kRadixBuckets];
+      std::fill_n(chunk_counts, kRadixBuckets, 0);
+      for (size_t i = chunk_start(chunk); i < chunk_start(chunk + 1); i++) {
+        chunk_counts[RadixDigit(keys[i], pass)]++;
+      }
+    };
+    RunParallelSortJob(isolate, num_chunks, count);
+
+    size_t first_digit_count = 0;
+    for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+      first_digit_count +=
+          counts[chunk * kRadixBuckets + RadixDigit(keys[0], pass)];
+    }
+    if (first_digit_count == length) continue;
+
+    size_t sum = 0;
+    for (size_t digit = 0; digit < kRadixBuckets; digit++) {
+      for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+        size_t& offset = counts[chunk * kRadixBuckets + digit];
+        size_t count = offset;
+        offset = sum;
+        sum += count;
+      }
+    }
+
+    auto scatter = [&](size_t chunk) {
+      size_t* offsets = &counts[chunk * kRadixBuckets];
+      for (size_t i = chunk_start(chunk); i < chunk_start(chunk + 1); i++) {
+        Key key = keys[i];
+        scratch[offsets[RadixDigit(key, pass)]++] = key;
+      }
+    };
+    RunParallelSortJob(isolate, num_chunks, scatter);
+    std::swap(keys, scratch);
+  }
+  return keys;
+}
+
+// Sorts the |length| keys at |data| in place. Worker threads are only used if
+// |allow_parallel| is set, as the main thread is parked while waiting for
+// them.
+template <SortKind kind, typename Key>
+void SortKeys(Isolate* isolate, Key* data, size_t length,
+              bool allow_parallel) {
+  for (size_t i = 0; i < length; i++) data[i] = ToSortKey<kind>(data[i]);
+
+  // The radix sort needs a second buffer of the same size. Sort in place with
+  // std::sort instead if the array is short or the buffer cannot be
+  // allocated.
+  Key* scratch = nullptr;
+  if (length >= kRadixSortMinLength) {
+    scratch = static_cast<Key*>(AllocWithRetry(length * sizeof(Key)));
+  }
+  if (scratch == nullptr) {
+    std::sort(data, data + length);
+  } else {
+    size_t num_chunks = 1;
+    if (allow_parallel && v8_flags.parallel_typed_array_sort &&
+        length >= kParallelSortMinLength) {
+      num_chunks = std::min(
+          length / kParallelSortMinChunkLength,
+          static_cast<size_t>(
+              V8::GetCurrentPlatform()->NumberOfWorkerThreads() + 1));
+    }
+    Key* sorted;
+    if (num_chunks > 1) {
+      sorted = ParallelRadixSort(isolate, data, scratch, length, num_chunks);
+    } else {
+      sorted = RadixSort(data, scratch, length);
     }
+    if (sorted != data) std::copy_n(sorted, length, data);
+    base::Free(scratch);
+  }
+
+  for (size_t i = 0; i < length; i++) data[i] = FromSortKey<kind>(data[i]);
+}
+
+// Sorts the |length| elements at |data|. Elements are sorted in place unless
+// they are in a SharedArrayBuffer, which might be modified concurrently while
+// sorting, or misaligned, which elements of on-heap typed arrays can be with
+// pointer compression. Those are sorted in an off-heap copy.
+template <SortKind kind, typename Key>
+void SortTypedArrayElements(Isolate* isolate, void* data, size_t length,
+                            bool is_shared, bool allow_parallel) {
+  if (!is_shared && IsAligned(reinterpret_cast<Address>(data), alignof(Key))) {
+    SortKeys<kind>(isolate, static_cast<Key*>(data), length, allow_parallel);
+    return;
+  }
+
+  std::vector<Key> keys(length);
+  const size_t bytes = length * sizeof(Key);
+  if (is_shared) {
+    base::Relaxed_Memcpy(reinterpret_cast<base::Atomic8*>(keys.data()),
+                         static_cast<base::Atomic8*>(data), bytes);
+  } else {
+    MemCopy(keys.data(), data, bytes);
+  }
+  SortKeys<kind>(isolate, keys.data(), length, allow_parallel);
+  if (is_shared) {
+    base::Relaxed_Memcpy(static_cast<base::Atomic8*>(data),
+                         reinterpret_cast<base::Atomic8*>(keys.data()), bytes);
+  } else {
+    MemCopy(data, keys.data(), bytes);
   }
-  return false;
 }
 
 }  // namespace
@@ -108,8 +360,7 @@ RUNTIME_FUNCTION(Runtime_TypedArraySortFast) {
 
 #ifdef V8_OS_LINUX
   if (v8_flags.multi_mapped_mock_allocator) {
-    // Sorting is meaningless with the mock allocator, and std::sort
-    // might crash (because aliasing elements violate its assumptions).
+    // Sorting is meaningless with the mock allocator.
     return *array;
   }
 #endif
@@ -117,73 +368,37 @@ RUNTIME_FUNCTION(Runtime_TypedArraySortFast) {
   size_t length = array->GetLength();
   DCHECK_LT(1, length);
 
-  // In case of a SAB, the data is copied into temporary memory, as
-  // std::sort might crash in case the underlying data is concurrently
-  // modified while sorting.
   CHECK(IsJSArrayBuffer(array->buffer()));
   DirectHandle<JSArrayBuffer> buffer(Cast<JSArrayBuffer>(array->buffer()),
                                      isolate);
-  const bool copy_data = buffer->is_shared();
-
-  Handle<ByteArray> array_copy;
-  std::vector<uint8_t> offheap_copy;
-  void* data_copy_ptr = nullptr;
-  if (copy_data) {
-    const size_t bytes = array->GetByteLength();
-    if (bytes <= static_cast<unsigned>(
-                     ByteArray::LengthFor(kMaxRegularHeapObjectSize))) {
-      array_copy = isolate->factory()->NewByteArray(static_cast<int>(bytes));
-      data_copy_ptr = array_copy->begin();
-    } else {
-      // Allocate copy in C++ heap.
-      offheap_copy.resize(bytes);
-      data_copy_ptr = &offheap_copy[0];
-    }
-    base::Relaxed_Memcpy(static_cast<base::Atomic8*>(data_copy_ptr),
-                         static_cast<base::Atomic8*>(array->DataPtr()), bytes);
-  }
+  const bool is_shared = buffer->is_shared();
 
-  DisallowGarbageCollection no_gc;
+  // On-heap elements move with the typed array, so no GC may happen while
+  // they are sorted. There are too few of them to be sorted in parallel,
+  // which parks the main thread. Off-heap elements do not move.
+  const bool is_on_heap = array->is_on_heap();
+  std::optional<DisallowGarbageCollection> no_gc;
+  if (is_on_heap) no_gc.emplace();
 
   switch (array->type()) {
-#define TYPED_ARRAY_SORT(Type, type, TYPE, ctype)                          \
-  case kExternal##Type##Array: {                                           \
-    ctype* data = copy_data ? reinterpret_cast<ctype*>(data_copy_ptr)      \
-                            : static_cast<ctype*>(array->DataPtr());       \
-    if (kExternal##Type##Array == kExternalFloat64Array ||                 \
-        kExternal##Type##Array == kExternalFloat32Array ||                 \
-        kExternal##Type##Array == kExternalFloat16Array) {                 \
-      if (COMPRESS_POINTERS_BOOL && alignof(ctype) > kTaggedSize) {        \
-        /* TODO(ishell, v8:8875): See UnalignedSlot<T> for details. */     \
-        std::sort(UnalignedSlot<ctype>(data),                              \
-                  UnalignedSlot<ctype>(data + length), CompareNum<ctype>); \
-      } else {                                                             \
-        std::sort(data, data + length, CompareNum<ctype>);                 \
-      }                                                                    \
-    } else {                                                               \
-      if (COMPRESS_POINTERS_BOOL && alignof(ctype) > kTaggedSize) {        \
-        /* TODO(ishell, v8:8875): See UnalignedSlot<T> for details. */     \
-        std::sort(UnalignedSlot<ctype>(data),                              \
-                  UnalignedSlot<ctype>(data + length));                    \
-      } else {                                                             \
-        std::sort(data, data + length);                                    \
-      }                                                                    \
-    }                                                                      \
-    break;                                                                 \
+#define TYPED_ARRAY_SORT(Type, type, TYPE, ctype)                             \
+  case kExternal##Type##Array: {                                              \
+    constexpr SortKind kind =                                                 \
+        kExternal##Type##Array == kExternalFloat64Array ||                    \
+                kExternal##Type##Array == kExternalFloat32Array ||            \
+                kExternal##Type##Array == kExternalFloat16Array               \
+            ? SortKind::kFloat                                                \
+            : (std::is_signed_v<ctype> ? SortKind::kSigned                    \
+                                       : SortKind::kUnsigned);                \
+    SortTypedArrayElements<kind, SortKey<ctype>>(                             \
+        isolate, array->DataPtr(), length, is_shared, !is_on_heap);           \
+    break;                                                                    \
   }
 
     TYPED_ARRAYS(TYPED_ARRAY_SORT)
 #undef TYPED_ARRAY_SORT
   }
 
-  if (copy_data) {
-    DCHECK_NOT_NULL(data_copy_ptr);
-    DCHECK_NE(array_copy.is_null(), offheap_copy.empty());
-    const size_t bytes = array->GetByteLength();
-    base::Relaxed_Memcpy(static_cast<base::Atomic8*>(array->DataPtr()),
-                         static_cast<base::Atomic8*>(data_copy_ptr), bytes);
-  }
-
   return *array;
 }
 
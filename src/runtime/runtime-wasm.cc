@@ -17,6 +17,7 @@
 #include "src/numbers/conversions.h"
 #include "src/objects/objects-inl.h"
 #include "src/strings/unicode-inl.h"
+#include "src/strings/unicode-simd.h"
 #include "src/trap-handler/trap-handler.h"
 #include "src/wasm/compilation-environment-inl.h"
 #include "src/wasm/module-compiler.h"
@@ -1661,20 +1662,12 @@ RUNTIME_FUNCTION(Runtime_WasmStringNewSegmentWtf8) {
 }
 
 namespace {
-// TODO(12868): Consider unifying with api.cc:String::Utf8Length.
 template <typename T>
 int MeasureWtf8(base::Vector<const T> wtf16) {
-  int previous = unibrow::Utf16::kNoPreviousCharacter;
-  int length = 0;
   DCHECK(wtf16.size() <= String::kMaxLength);
   static_assert(String::kMaxLength <=
                 (kMaxInt / unibrow::Utf8::kMaxEncodedSize));
-  for (size_t i = 0; i < wtf16.size(); i++) {
-    int current = wtf16[i];
-    length += unibrow::Utf8::Length(current, previous);
-    previous = current;
-  }
-  return length;
+  return static_cast<int>(Utf8Length(wtf16));
 }
 int MeasureWtf8(Isolate* isolate, Handle<String> string) {
   string = String::Flatten(isolate, string);
@@ -1698,7 +1691,6 @@ bool HasUnpairedSurrogate(base::Vector<const uint8_t> wtf16) { return false; }
 bool HasUnpairedSurrogate(base::Vector<const base::uc16> wtf16) {
   return unibrow::Utf16::HasUnpairedSurrogate(wtf16.begin(), wtf16.size());
 }
-// TODO(12868): Consider unifying with api.cc:String::WriteUtf8.
 template <typename T>
 int EncodeWtf8(base::Vector<char> bytes, size_t offset,
                base::Vector<const T> wtf16, unibrow::Utf8Variant variant,
@@ -1729,12 +1721,8 @@ int EncodeWtf8(base::Vector<char> bytes, size_t offset,
   }
 
   char* dst_start = bytes.begin() + offset;
-  char* dst = dst_start;
   int previous = unibrow::Utf16::kNoPreviousCharacter;
-  for (auto code_unit : wtf16) {
-    dst += unibrow::Utf8::Encode(dst, code_unit, previous, replace_invalid);
-    previous = code_unit;
-  }
+  char* dst = EncodeUtf8(wtf16, dst_start, replace_invalid, &previous);
   DCHECK_LE(dst - dst_start, static_cast<ptrdiff_t>(kMaxInt));
   return static_cast<int>(dst - dst_start);
 }
@@ -74,6 +74,10 @@ ScriptCompiler::CachedData* CodeSerializer::Serialize(
   HandleScope scope(isolate);
   CodeSerializer cs(isolate, SerializedCodeData::SourceHash(
                                  source, script->origin_options()));
+  if (v8_flags.cache_pretenuring_decisions) {
+    isolate->heap()->pretenuring_handler()->ExportPretenuringDecisions(
+        *script, &cs.pretenuring_decisions_);
+  }
   DisallowGarbageCollection no_gc;
   cs.reference_map()->AddAttachedReference(*source);
   AlignedCachedData* cached_data = cs.SerializeSharedFunctionInfo(info);
@@ -337,7 +341,8 @@ class StressOffThreadDeserializeThread final : public base::Thread {
 void FinalizeDeserialization(Isolate* isolate,
                              DirectHandle<SharedFunctionInfo> result,
                              const base::ElapsedTimer& timer,
-                             const ScriptDetails& script_details) {
+                             const ScriptDetails& script_details,
+                             const SerializedCodeData& scd) {
   // Devtools can report time in this function as profiler overhead, since none
   // of the following tasks would need to happen normally.
   TRACE_EVENT0(TRACE_DISABLED_BY_DEFAULT("v8.compile"),
@@ -357,6 +362,11 @@ void FinalizeDeserialization(Isolate* isolate,
     SetScriptFieldsFromDetails(isolate, *script, script_details, &no_gc);
   }
 
+  if (v8_flags.cache_pretenuring_decisions) {
+    isolate->heap()->pretenuring_handler()->ImportPretenuringDecisions(
+        *script, scd.PretenuringDecisions());
+  }
+
   bool needs_source_positions = isolate->NeedsSourcePositions();
   if (!log_code_creation && !needs_source_positions) return;
 
@@ -512,7 +522,7 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::Deserialize(
     PrintF("[Deserializing from %d bytes took %0.3f ms]\n", length, ms);
   }
 
-  FinalizeDeserialization(isolate, result, timer, script_details);
+  FinalizeDeserialization(isolate, result, timer, script_details, scd);
 
   return scope.CloseAndEscape(result);
 }
@@ -659,7 +669,7 @@ MaybeHandle<SharedFunctionInfo> CodeSerializer::FinishOffThreadDeserialize(
            length, ms);
   }
 
-  FinalizeDeserialization(isolate, result, timer, script_details);
+  FinalizeDeserialization(isolate, result, timer, script_details, scd);
 
   DCHECK(!background_merge_task ||
          !background_merge_task->HasPendingForegroundWork());
@@ -672,7 +682,15 @@ SerializedCodeData::SerializedCodeData(const std::vector<uint8_t>* payload,
   DisallowGarbageCollection no_gc;
 
   // Calculate sizes.
-  uint32_t size = kHeaderSize + static_cast<uint32_t>(payload->size());
+  const std::vector<uint32_t>& pretenuring_decisions =
+      cs->pretenuring_decisions();
+  // Decisions come in triples. They are padded to keep the size pointer
+  // aligned.
+  DCHECK_EQ(0, pretenuring_decisions.size() % 3);
+  uint32_t pretenuring_decisions_size =
+      PretenuringDecisionsSize(pretenuring_decisions.size());
+  uint32_t size = kHeaderSize + static_cast<uint32_t>(payload->size()) +
+                  pretenuring_decisions_size;
   DCHECK(IsAligned(size, kPointerAlignment));
 
   // Allocate backing store and create result data.
@@ -690,6 +708,8 @@ SerializedCodeData::SerializedCodeData(const std::vector<uint8_t>* payload,
                  Snapshot::ExtractReadOnlySnapshotChecksum(
                      cs->isolate()->snapshot_blob()));
   SetHeaderValue(kPayloadLengthOffset, static_cast<uint32_t>(payload->size()));
+  SetHeaderValue(kPretenuringDecisionsLengthOffset,
+                 static_cast<uint32_t>(pretenuring_decisions.size()));
 
   // Zero out any padding in the header.
   memset(data_ + kUnalignedHeaderSize, 0, kHeaderSize - kUnalignedHeaderSize);
@@ -697,6 +717,14 @@ SerializedCodeData::SerializedCodeData(const std::vector<uint8_t>* payload,
   // Copy serialized data.
   CopyBytes(data_ + kHeaderSize, payload->data(),
             static_cast<size_t>(payload->size()));
+  if (pretenuring_decisions_size > 0) {
+    size_t decisions_bytes = pretenuring_decisions.size() * kUInt32Size;
+    CopyBytes(data_ + kHeaderSize + payload->size(),
+              reinterpret_cast<const uint8_t*>(pretenuring_decisions.data()),
+              decisions_bytes);
+    memset(data_ + kHeaderSize + payload->size() + decisions_bytes, 0,
+           pretenuring_decisions_size - decisions_bytes);
+  }
   uint32_t checksum =
       v8_flags.verify_snapshot_checksum ? Checksum(ChecksummedContent()) : 0;
   SetHeaderValue(kChecksumOffset, checksum);
@@ -747,6 +775,13 @@ SerializedCodeSanityCheckResult SerializedCodeData::SanityCheckWithoutSource(
   if (payload_length > max_payload_length) {
     return SerializedCodeSanityCheckResult::kLengthMismatch;
   }
+  uint32_t pretenuring_decisions_length =
+      GetHeaderValue(kPretenuringDecisionsLengthOffset);
+  if (pretenuring_decisions_length % 3 != 0 ||
+      pretenuring_decisions_length >
+          (max_payload_length - payload_length) / kUInt32Size) {
+    return SerializedCodeSanityCheckResult::kLengthMismatch;
+  }
   if (v8_flags.verify_snapshot_checksum) {
     uint32_t checksum = GetHeaderValue(kChecksumOffset);
     if (Checksum(ChecksummedContent()) != checksum) {
@@ -781,10 +816,21 @@ base::Vector<const uint8_t> SerializedCodeData::Payload() const {
   const uint8_t* payload = data_ + kHeaderSize;
   DCHECK(IsAligned(reinterpret_cast<intptr_t>(payload), kPointerAlignment));
   int length = GetHeaderValue(kPayloadLengthOffset);
-  DCHECK_EQ(data_ + size_, payload + length);
+  DCHECK_EQ(data_ + size_,
+            payload + length +
+                PretenuringDecisionsSize(PretenuringDecisions().size()));
   return base::Vector<const uint8_t>(payload, length);
 }
 
+base::Vector<const uint32_t> SerializedCodeData::PretenuringDecisions() const {
+  const uint8_t* decisions =
+      data_ + kHeaderSize + GetHeaderValue(kPayloadLengthOffset);
+  DCHECK(IsAligned(reinterpret_cast<intptr_t>(decisions), kUInt32Size));
+  int length = GetHeaderValue(kPretenuringDecisionsLengthOffset);
+  return base::Vector<const uint32_t>(
+      reinterpret_cast<const uint32_t*>(decisions), length);
+}
+
 SerializedCodeData::SerializedCodeData(AlignedCachedData* data)
     : SerializedData(const_cast<uint8_t*>(data->data()), data->length()) {}
 
@@ -98,6 +98,10 @@ class CodeSerializer : public Serializer {
 
   uint32_t source_hash() const { return source_hash_; }
 
+  const std::vector<uint32_t>& pretenuring_decisions() const {
+    return pretenuring_decisions_;
+  }
+
  protected:
   CodeSerializer(Isolate* isolate, uint32_t source_hash);
   ~CodeSerializer() override { OutputStatistics("CodeSerializer"); }
@@ -109,6 +113,9 @@ class CodeSerializer : public Serializer {
 
   DISALLOW_GARBAGE_COLLECTION(no_gc_)
   uint32_t source_hash_;
+  // Triples of function literal id, feedback slot and nesting depth of
+  // tenured literal allocation sites, see --cache-pretenuring-decisions.
+  std::vector<uint32_t> pretenuring_decisions_;
 };
 
 // Wrapper around ScriptData to provide code-serializer-specific functionality.
@@ -122,7 +129,10 @@ class SerializedCodeData : public SerializedData {
       kFlagHashOffset + kUInt32Size;
   static const uint32_t kPayloadLengthOffset =
       kReadOnlySnapshotChecksumOffset + kUInt32Size;
-  static const uint32_t kChecksumOffset = kPayloadLengthOffset + kUInt32Size;
+  static const uint32_t kPretenuringDecisionsLengthOffset =
+      kPayloadLengthOffset + kUInt32Size;
+  static const uint32_t kChecksumOffset =
+      kPretenuringDecisionsLengthOffset + kUInt32Size;
   static const uint32_t kUnalignedHeaderSize = kChecksumOffset + kUInt32Size;
   static const uint32_t kHeaderSize = POINTER_SIZE_ALIGN(kUnalignedHeaderSize);
 
@@ -152,6 +162,10 @@ class SerializedCodeData : public SerializedData {
 
   base::Vector<const uint8_t> Payload() const;
 
+  // Triples of function literal id, feedback slot and nesting depth stored
+  // after the payload.
+  base::Vector<const uint32_t> PretenuringDecisions() const;
+
   static uint32_t SourceHash(DirectHandle<String> source,
                              ScriptOriginOptions origin_options);
 
@@ -160,6 +174,11 @@ class SerializedCodeData : public SerializedData {
   SerializedCodeData(const uint8_t* data, int size)
       : SerializedData(const_cast<uint8_t*>(data), size) {}
 
+  // Size in bytes of {length} decisions, padded to pointer alignment.
+  static uint32_t PretenuringDecisionsSize(size_t length) {
+    return static_cast<uint32_t>(POINTER_SIZE_ALIGN(length * kUInt32Size));
+  }
+
   base::Vector<const uint8_t> ChecksummedContent() const {
     return base::Vector<const uint8_t>(data_ + kHeaderSize,
                                        size_ - kHeaderSize);
@@ -18,6 +18,7 @@
 #include "src/common/globals.h"
 #include "src/flags/flags.h"
 #include "src/snapshot/embedded/embedded-file-writer.h"
+#include "src/snapshot/read-only-serializer-deserializer.h"
 #include "src/snapshot/snapshot.h"
 #include "src/snapshot/static-roots-gen.h"
 
@@ -96,9 +97,24 @@ class SnapshotFileWriter {
 
   static void WriteSnapshotFileData(FILE* fp,
                                     v8::base::Vector<const uint8_t> blob) {
-    fprintf(
-        fp,
-        "alignas(kPointerAlignment) static const uint8_t blob_data[] = {\n");
+    if (i::v8_flags.page_aligned_read_only_snapshot) {
+      // Align the blob such that the read-only space can be mapped from the
+      // binary. COFF limits section alignment to 8 KB and MSVC rejects larger
+      // alignas() values. The read-only space is never mapped on Windows, as
+      // OS::RemapPages is not supported there, so pointer alignment suffices.
+      fprintf(fp, "#if defined(V8_OS_WIN)\n");
+      fprintf(
+          fp,
+          "alignas(kPointerAlignment) static const uint8_t blob_data[] = {\n");
+      fprintf(fp, "#else\n");
+      fprintf(fp, "alignas(%zu) static const uint8_t blob_data[] = {\n",
+              i::ro::kMappableSegmentAlignment);
+      fprintf(fp, "#endif\n");
+    } else {
+      fprintf(
+          fp,
+          "alignas(kPointerAlignment) static const uint8_t blob_data[] = {\n");
+    }
     WriteBinaryContentsAsCArray(fp, blob);
     fprintf(fp, "};\n");
     fprintf(fp, "static const int blob_size = %d;\n", blob.length());
@@ -4,6 +4,7 @@
 
 #include "src/snapshot/read-only-deserializer.h"
 
+#include "src/base/platform/platform.h"
 #include "src/handles/handles-inl.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/read-only-heap.h"
@@ -19,8 +20,11 @@ namespace internal {
 
 class ReadOnlyHeapImageDeserializer final {
  public:
-  static void Deserialize(Isolate* isolate, SnapshotByteSource* source) {
-    ReadOnlyHeapImageDeserializer{isolate, source}.DeserializeImpl();
+  // Returns the number of bytes that were mapped rather than copied.
+  static size_t Deserialize(Isolate* isolate, SnapshotByteSource* source) {
+    ReadOnlyHeapImageDeserializer deserializer{isolate, source};
+    deserializer.DeserializeImpl();
+    return deserializer.mapped_bytes_;
   }
 
  private:
@@ -45,6 +49,9 @@ class ReadOnlyHeapImageDeserializer final {
           break;
         case Bytecode::kRelocateSegment:
           UNREACHABLE();  // Handled together with kSegment.
+        case Bytecode::kMappableSegment:
+          DeserializeMappableSegment();
+          break;
         case Bytecode::kReadOnlyRootsTable:
           DeserializeReadOnlyRootsTable();
           break;
@@ -99,6 +106,53 @@ class ReadOnlyHeapImageDeserializer final {
     }
   }
 
+  void DeserializeMappableSegment() {
+    CHECK(V8_STATIC_ROOTS_BOOL);
+    uint32_t page_index = source_->GetUint30();
+    ReadOnlyPageMetadata* page = PageAt(page_index);
+
+    Address start = page->area_start() + source_->GetUint30();
+    int size_in_bytes = source_->GetUint30();
+    CHECK_LE(start + size_in_bytes, page->area_end());
+    source_->Advance(static_cast<int>(source_->GetUint32()));
+
+    const uint8_t* contents = source_->data() + source_->position();
+    if (v8_flags.map_read_only_space_from_snapshot &&
+        TryMapSegment(start, contents, size_in_bytes)) {
+      source_->Advance(size_in_bytes);
+    } else {
+      source_->CopyRaw(reinterpret_cast<void*>(start), size_in_bytes);
+    }
+  }
+
+  // Maps all OS pages fully covered by the segment from the snapshot blob and
+  // copies the partial pages at either end. This only succeeds if the blob is
+  // backed by a file and the contents have the same offset within an OS page
+  // as the segment itself. The mapping is private, so post-processing and
+  // rehashing only duplicate the pages that they write to.
+  bool TryMapSegment(Address start, const uint8_t* contents,
+                     size_t size_in_bytes) {
+    if constexpr (!base::OS::IsRemapPageSupported()) return false;
+    const size_t os_page_size = base::OS::AllocatePageSize();
+    const Address contents_start = reinterpret_cast<Address>(contents);
+    if ((contents_start - start) % os_page_size != 0) return false;
+    const Address end = start + size_in_bytes;
+    const Address mapped_start = RoundUp(start, os_page_size);
+    const Address mapped_end = RoundDown(end, os_page_size);
+    if (mapped_start >= mapped_end) return false;
+    if (!base::OS::RemapPages(
+            contents + (mapped_start - start), mapped_end - mapped_start,
+            reinterpret_cast<void*>(mapped_start),
+            base::OS::MemoryPermission::kReadWrite)) {
+      return false;
+    }
+    MemCopy(reinterpret_cast<void*>(start), contents, mapped_start - start);
+    MemCopy(reinterpret_cast<void*>(mapped_end),
+            contents + (mapped_end - start), end - mapped_end);
+    mapped_bytes_ += mapped_end - mapped_start;
+    return true;
+  }
+
   Address Decode(ro::EncodedTagged encoded) const {
     ReadOnlyPageMetadata* page = PageAt(encoded.page_index);
     return page->OffsetToAddress(encoded.offset * kTaggedSize);
@@ -146,6 +200,7 @@ class ReadOnlyHeapImageDeserializer final {
 
   SnapshotByteSource* const source_;
   Isolate* const isolate_;
+  size_t mapped_bytes_ = 0;
 };
 
 ReadOnlyDeserializer::ReadOnlyDeserializer(Isolate* isolate,
@@ -161,8 +216,10 @@ void ReadOnlyDeserializer::DeserializeIntoIsolate() {
       isolate()->counters()->snapshot_deserialize_rospace());
   HandleScope scope(isolate());
 
-  ReadOnlyHeapImageDeserializer::Deserialize(isolate(), source());
+  const size_t mapped_bytes =
+      ReadOnlyHeapImageDeserializer::Deserialize(isolate(), source());
   ReadOnlyHeap* ro_heap = isolate()->read_only_heap();
+  ro_heap->set_mapped_snapshot_bytes(mapped_bytes);
   ro_heap->read_only_space()->RepairFreeSpacesAfterDeserialization();
   PostProcessNewObjects();
 
@@ -184,6 +241,10 @@ void ReadOnlyDeserializer::DeserializeIntoIsolate() {
     const double ms = timer.Elapsed().InMillisecondsF();
     PrintF("[Deserializing read-only space (%d bytes) took %0.3f ms]\n", bytes,
            ms);
+    if (mapped_bytes > 0) {
+      PrintF("[Mapped %zu bytes of read-only space from the snapshot]\n",
+             mapped_bytes);
+    }
   }
 }
 
@@ -35,6 +35,16 @@ enum Bytecode {
   //   ... relocation byte stream
   kRelocateSegment,
   //
+  // kMappableSegment parameters (static roots only):
+  //   Uint30 page_index
+  //   Uint30 offset
+  //   Uint30 size_in_bytes
+  //   Uint32 padding_in_bytes
+  //   ... padding_in_bytes zero bytes
+  //   ... segment byte stream, at a position congruent to the segment's
+  //       compressed address modulo kMappableSegmentAlignment
+  kMappableSegment,
+  //
   // kReadOnlyRootsTable parameters:
   //   IF_STATIC_ROOTS(... ro roots table slots)
   kReadOnlyRootsTable,
@@ -44,6 +54,12 @@ enum Bytecode {
 static constexpr int kNumberOfBytecodes =
     static_cast<int>(kFinalizeReadOnlySpace) + 1;
 
+// Segments emitted as kMappableSegment are laid out such that, provided the
+// read-only snapshot payload itself starts at a multiple of this alignment,
+// whole OS pages of the segment can be mapped from the snapshot blob. This is
+// the largest OS page size we care about.
+static constexpr size_t kMappableSegmentAlignment = 64 * KB;
+
 // Like std::vector<bool> but with a known underlying encoding.
 class BitSet final {
  public:
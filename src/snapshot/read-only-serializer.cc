@@ -363,6 +363,10 @@ class ReadOnlyHeapImageSerializer {
   }
 
   void EmitSegment(const ReadOnlySegmentForSerialization* segment) {
+    if (V8_STATIC_ROOTS_BOOL && v8_flags.page_aligned_read_only_snapshot) {
+      EmitMappableSegment(segment);
+      return;
+    }
     sink_->Put(Bytecode::kSegment, "segment begin");
     sink_->PutUint30(IndexOf(segment->page), "page index");
     sink_->PutUint30(static_cast<uint32_t>(segment->segment_offset),
@@ -379,6 +383,30 @@ class ReadOnlyHeapImageSerializer {
     }
   }
 
+  void EmitMappableSegment(const ReadOnlySegmentForSerialization* segment) {
+    DCHECK(V8_STATIC_ROOTS_BOOL);
+    sink_->Put(Bytecode::kMappableSegment, "mappable segment begin");
+    sink_->PutUint30(IndexOf(segment->page), "page index");
+    sink_->PutUint30(static_cast<uint32_t>(segment->segment_offset),
+                     "segment start offset");
+    sink_->PutUint30(static_cast<uint32_t>(segment->segment_size),
+                     "segment byte size");
+    // Pad the contents such that their position in the payload matches the
+    // position of the segment within its OS pages. The padding length has a
+    // fixed width so that it can be computed before it is emitted.
+    size_t contents_position = sink_->Position() + kUInt32Size;
+    size_t target =
+        V8HeapCompressionScheme::CompressAny(segment->segment_start);
+    size_t padding =
+        (target - contents_position) % ro::kMappableSegmentAlignment;
+    sink_->PutUint32(static_cast<uint32_t>(padding), "padding byte size");
+    sink_->PutN(static_cast<int>(padding), 0, "padding");
+    DCHECK_EQ(target % ro::kMappableSegmentAlignment,
+              sink_->Position() % ro::kMappableSegmentAlignment);
+    sink_->PutRaw(segment->contents.get(),
+                  static_cast<int>(segment->segment_size), "page");
+  }
+
   void EmitReadOnlyRootsTable() {
     sink_->Put(Bytecode::kReadOnlyRootsTable, "read only roots table");
     if (!V8_STATIC_ROOTS_BOOL) {
@@ -20,6 +20,7 @@
 #include "src/objects/js-regexp-inl.h"
 #include "src/snapshot/context-deserializer.h"
 #include "src/snapshot/context-serializer.h"
+#include "src/snapshot/read-only-serializer-deserializer.h"
 #include "src/snapshot/read-only-serializer.h"
 #include "src/snapshot/shared-heap-serializer.h"
 #include "src/snapshot/snapshot-utils.h"
@@ -77,12 +78,14 @@ class SnapshotImpl : public AllStatic {
   // [3] read-only snapshot checksum
   // [4] (64 bytes) version string
   // [5] offset to readonly
-  // [6] offset to shared heap
-  // [7] offset to context 0
-  // [8] offset to context 1
+  // [6] size of the padding preceding the readonly data
+  // [7] offset to shared heap
+  // [8] offset to context 0
+  // [9] offset to context 1
   // ...
   // ... offset to context N - 1
   // ... startup snapshot data
+  // ... padding
   // ... read-only snapshot data
   // ... shared heap snapshot data
   // ... context 0 snapshot data
@@ -100,8 +103,10 @@ class SnapshotImpl : public AllStatic {
   static const uint32_t kVersionStringLength = 64;
   static const uint32_t kReadOnlyOffsetOffset =
       kVersionStringOffset + kVersionStringLength;
-  static const uint32_t kSharedHeapOffsetOffset =
+  static const uint32_t kReadOnlyPaddingOffset =
       kReadOnlyOffsetOffset + kUInt32Size;
+  static const uint32_t kSharedHeapOffsetOffset =
+      kReadOnlyPaddingOffset + kUInt32Size;
   static const uint32_t kFirstContextOffsetOffset =
       kSharedHeapOffsetOffset + kUInt32Size;
 
@@ -541,6 +546,21 @@ v8::StartupData SnapshotImpl::CreateSnapshotBlob(
       SnapshotImpl::StartupSnapshotOffset(num_contexts);
   uint32_t total_length = startup_snapshot_offset;
   total_length += static_cast<uint32_t>(startup_snapshot->RawData().length());
+  // Let the read-only payload start at a multiple of the alignment its
+  // segments were laid out for, such that they can be mapped from the file.
+  uint32_t read_only_padding = 0;
+#ifndef V8_SNAPSHOT_COMPRESSION
+  if (V8_STATIC_ROOTS_BOOL && v8_flags.page_aligned_read_only_snapshot) {
+    uint32_t read_only_payload_offset =
+        total_length +
+        static_cast<uint32_t>(read_only_snapshot->Payload().begin() -
+                              read_only_snapshot->RawData().begin());
+    read_only_padding = static_cast<uint32_t>(
+        RoundUp(read_only_payload_offset, ro::kMappableSegmentAlignment) -
+        read_only_payload_offset);
+  }
+#endif  // V8_SNAPSHOT_COMPRESSION
+  total_length += read_only_padding;
   total_length += static_cast<uint32_t>(read_only_snapshot->RawData().length());
   total_length +=
       static_cast<uint32_t>(shared_heap_snapshot->RawData().length());
@@ -579,6 +599,10 @@ v8::StartupData SnapshotImpl::CreateSnapshotBlob(
   payload_offset += payload_length;
 
   // Read-only.
+  memset(data + payload_offset, 0, read_only_padding);
+  SnapshotImpl::SetHeaderValue(data, SnapshotImpl::kReadOnlyPaddingOffset,
+                               read_only_padding);
+  payload_offset += read_only_padding;
   SnapshotImpl::SetHeaderValue(data, SnapshotImpl::kReadOnlyOffsetOffset,
                                payload_offset);
   payload_length = read_only_snapshot->RawData().length();
@@ -705,7 +729,8 @@ base::Vector<const uint8_t> SnapshotImpl::ExtractStartupData(
 
   uint32_t num_contexts = ExtractNumContexts(data);
   return ExtractData(data, StartupSnapshotOffset(num_contexts),
-                     GetHeaderValue(data, kReadOnlyOffsetOffset));
+                     GetHeaderValue(data, kReadOnlyOffsetOffset) -
+                         GetHeaderValue(data, kReadOnlyPaddingOffset));
 }
 
 base::Vector<const uint8_t> SnapshotImpl::ExtractReadOnlyData(
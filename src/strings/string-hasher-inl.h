@@ -10,6 +10,8 @@
 // Comment inserted to prevent header reordering.
 #include <type_traits>
 
+#include "src/base/bits.h"
+#include "src/base/memory.h"
 #include "src/objects/name-inl.h"
 #include "src/objects/string-inl.h"
 #include "src/strings/char-predicates-inl.h"
@@ -36,6 +38,93 @@ uint32_t StringHasher::GetHashCore(uint32_t running_hash) {
   return running_hash;
 }
 
+namespace detail {
+
+// Multiplies |a| and |b| and folds the 128-bit product into 64 bits.
+V8_INLINE uint64_t MultiplyAndFold(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+  __uint128_t product = static_cast<__uint128_t>(a) * b;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+  return (a * b) ^ base::bits::UnsignedMulHigh64(a, b);
+#endif
+}
+
+// Reads four characters as a word of four 16-bit lanes.
+template <typename uchar>
+V8_INLINE uint64_t ReadFourCharacters(const uchar* chars) {
+#if defined(V8_TARGET_LITTLE_ENDIAN)
+  if constexpr (sizeof(uchar) == 2) {
+    return base::ReadUnalignedValue<uint64_t>(
+        reinterpret_cast<Address>(chars));
+  } else {
+    // Spread the four bytes out to the low bytes of four 16-bit lanes.
+    uint64_t word =
+        base::ReadUnalignedValue<uint32_t>(reinterpret_cast<Address>(chars));
+    word = (word | (word << 16)) & uint64_t{0x0000FFFF0000FFFF};
+    return (word | (word << 8)) & uint64_t{0x00FF00FF00FF00FF};
+  }
+#else
+  return uint64_t{chars[0]} | (uint64_t{chars[1]} << 16) |
+         (uint64_t{chars[2]} << 32) | (uint64_t{chars[3]} << 48);
+#endif
+}
+
+}  // namespace detail
+
+template <typename uchar>
+uint32_t StringHasher::HashBlocks(const uchar* chars, int length,
+                                  uint64_t seed) {
+  static_assert(sizeof(uchar) <= 2);
+  DCHECK_GE(length, kMinBlockHashLength);
+  DCHECK_LE(length, String::kMaxHashCalcLength);
+  using detail::MultiplyAndFold;
+  using detail::ReadFourCharacters;
+  // Arbitrary odd constants with a balanced number of set bits.
+  constexpr uint64_t kSecret0 = uint64_t{0x2d358dccaa6c78a5};
+  constexpr uint64_t kSecret1 = uint64_t{0x8bb84b93962eacc9};
+  constexpr uint64_t kSecret2 = uint64_t{0x4b33a62ed433d4a3};
+
+  const uchar* const end = chars + length;
+  uint64_t hash = seed ^ MultiplyAndFold(seed ^ kSecret0, kSecret1) ^
+                  static_cast<uint64_t>(length);
+  if (length > 24) {
+    // Three independent lanes of 8 characters each, so that the multiplies
+    // can overlap.
+    uint64_t lane1 = hash;
+    uint64_t lane2 = hash;
+    do {
+      hash = MultiplyAndFold(ReadFourCharacters(chars) ^ kSecret0,
+                             ReadFourCharacters(chars + 4) ^ hash);
+      lane1 = MultiplyAndFold(ReadFourCharacters(chars + 8) ^ kSecret1,
+                              ReadFourCharacters(chars + 12) ^ lane1);
+      lane2 = MultiplyAndFold(ReadFourCharacters(chars + 16) ^ kSecret2,
+                              ReadFourCharacters(chars + 20) ^ lane2);
+      chars += 24;
+    } while (end - chars > 24);
+    hash ^= lane1 ^ lane2;
+  }
+  while (end - chars > 8) {
+    hash = MultiplyAndFold(ReadFourCharacters(chars) ^ kSecret1,
+                           ReadFourCharacters(chars + 4) ^ hash);
+    chars += 8;
+  }
+  // The last 8 characters, which may overlap with characters that have been
+  // hashed already.
+  uint64_t a = ReadFourCharacters(end - 8) ^ kSecret1;
+  uint64_t b = ReadFourCharacters(end - 4) ^ hash;
+  uint64_t result =
+      MultiplyAndFold(a ^ kSecret0 ^ static_cast<uint64_t>(length),
+                      MultiplyAndFold(a, b) ^ kSecret1);
+
+  uint32_t running_hash =
+      static_cast<uint32_t>(result) ^ static_cast<uint32_t>(result >> 32);
+  // Like GetHashCore, make sure that the hash bits are not all zero.
+  if ((running_hash & String::HashBits::kMax) == 0) running_hash = kZeroHash;
+  return String::CreateHashFieldValue(running_hash,
+                                      String::HashFieldType::kHash);
+}
+
 uint32_t StringHasher::GetTrivialHash(int length) {
   DCHECK_GT(length, String::kMaxHashCalcLength);
   // The hash of a large string is simply computed from the length.
@@ -109,6 +198,9 @@ uint32_t StringHasher::HashSequentialString(const char_t* chars_raw, int length,
     if (length > String::kMaxHashCalcLength) {
       return GetTrivialHash(length);
     }
+    if (length >= kMinBlockHashLength) {
+      return HashBlocks(chars, length, seed);
+    }
   }
 
   // Non-index hash.
@@ -35,10 +35,24 @@ class V8_EXPORT_PRIVATE StringHasher final {
   // use 27 instead.
   static const int kZeroHash = 27;
 
+  // Strings of at least this many characters are hashed with HashBlocks
+  // instead of the one-at-a-time hash, as long as they are not longer than
+  // String::kMaxHashCalcLength.
+  static const int kMinBlockHashLength = 32;
+
   // Reusable parts of the hashing algorithm.
   V8_INLINE static uint32_t AddCharacterCore(uint32_t running_hash, uint16_t c);
   V8_INLINE static uint32_t GetHashCore(uint32_t running_hash);
 
+  // Hashes |length| >= kMinBlockHashLength characters four at a time, in
+  // three independent lanes, with a multiply-and-fold mixing step in the
+  // style of wyhash/rapidhash. The characters are zero-extended to 16 bits
+  // first, so that one- and two-byte strings with the same contents get the
+  // same hash.
+  template <typename uchar>
+  V8_INLINE static uint32_t HashBlocks(const uchar* chars, int length,
+                                       uint64_t seed);
+
   static inline uint32_t GetTrivialHash(int length);
 };
 
@@ -5,11 +5,25 @@
 #ifndef V8_STRINGS_STRING_SEARCH_H_
 #define V8_STRINGS_STRING_SEARCH_H_
 
+#include "src/base/bits.h"
 #include "src/base/strings.h"
 #include "src/base/vector.h"
 #include "src/execution/isolate.h"
 #include "src/objects/string.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_STRING_SEARCH_SSE2 1
+#include <emmintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+#define V8_STRING_SEARCH_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(V8_STRING_SEARCH_SSE2) || defined(V8_STRING_SEARCH_NEON)
+#define V8_STRING_SEARCH_SIMD 1
+#endif
+
 namespace v8 {
 namespace internal {
 
@@ -42,6 +56,11 @@ class StringSearchBase {
   // to compensate for the algorithmic overhead compared to simple brute force.
   static const int kBMMinPatternLength = 7;
 
+  // Patterns up to this length are searched by comparing their first and last
+  // characters against a whole vector of subject positions at once. For longer
+  // patterns the skips of Boyer-Moore(-Horspool) pay off.
+  static const int kVectorizedSearchMaxPatternLength = 32;
+
   static inline bool IsOneByteString(base::Vector<const uint8_t> string) {
     return true;
   }
@@ -67,11 +86,17 @@ class StringSearch : private StringSearchBase {
       }
     }
     int pattern_length = pattern_.length();
+    if (pattern_length == 1) {
+      strategy_ = &SingleCharSearch;
+      return;
+    }
+#ifdef V8_STRING_SEARCH_SIMD
+    if (pattern_length <= kVectorizedSearchMaxPatternLength) {
+      strategy_ = &VectorizedSearch;
+      return;
+    }
+#endif  // V8_STRING_SEARCH_SIMD
     if (pattern_length < kBMMinPatternLength) {
-      if (pattern_length == 1) {
-        strategy_ = &SingleCharSearch;
-        return;
-      }
       strategy_ = &LinearSearch;
       return;
     }
@@ -114,6 +139,12 @@ class StringSearch : private StringSearchBase {
                            base::Vector<const SubjectChar> subject,
                            int start_index);
 
+#ifdef V8_STRING_SEARCH_SIMD
+  static int VectorizedSearch(StringSearch<PatternChar, SubjectChar>* search,
+                              base::Vector<const SubjectChar> subject,
+                              int start_index);
+#endif  // V8_STRING_SEARCH_SIMD
+
   static int BoyerMooreHorspoolSearch(
       StringSearch<PatternChar, SubjectChar>* search,
       base::Vector<const SubjectChar> subject, int start_index);
@@ -533,6 +564,132 @@ int StringSearch<PatternChar, SubjectChar>::InitialSearch(
   return -1;
 }
 
+#ifdef V8_STRING_SEARCH_SIMD
+
+//---------------------------------------------------------------------
+// Vectorized search, filtering on the first and last pattern character.
+//---------------------------------------------------------------------
+
+namespace string_search_simd {
+
+constexpr int kBlockSize = 16;
+
+template <typename Char>
+constexpr int kLanes = kBlockSize / sizeof(Char);
+
+#ifdef V8_STRING_SEARCH_SSE2
+// _mm_movemask_epi8 yields one bit per byte.
+template <typename Char>
+constexpr int kBitsPerLane = sizeof(Char);
+#else
+// Narrowing with vshrn (one-byte lanes) resp. vmovn (two-byte lanes) leaves
+// 4 resp. 8 bits per lane.
+template <typename Char>
+constexpr int kBitsPerLane = sizeof(Char) == 1 ? 4 : 8;
+#endif
+
+template <typename Char>
+constexpr uint64_t kLowestBitOfEachLane =
+    ~uint64_t{0} / ((uint64_t{1} << kBitsPerLane<Char>) - 1);
+
+// Returns a mask with the lowest bit of lane i set if subject[i] == first and
+// subject[i + distance] == last, for the kLanes<Char> positions starting at
+// |subject|.
+template <typename Char>
+V8_INLINE uint64_t FirstAndLastCharacterMask(const Char* subject,
+                                             int distance, Char first,
+                                             Char last) {
+#ifdef V8_STRING_SEARCH_SSE2
+  __m128i first_block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(subject));
+  __m128i last_block =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(subject + distance));
+  __m128i matches;
+  if constexpr (sizeof(Char) == 1) {
+    matches = _mm_and_si128(
+        _mm_cmpeq_epi8(first_block, _mm_set1_epi8(static_cast<char>(first))),
+        _mm_cmpeq_epi8(last_block, _mm_set1_epi8(static_cast<char>(last))));
+  } else {
+    matches = _mm_and_si128(
+        _mm_cmpeq_epi16(first_block,
+                        _mm_set1_epi16(static_cast<int16_t>(first))),
+        _mm_cmpeq_epi16(last_block,
+                        _mm_set1_epi16(static_cast<int16_t>(last))));
+  }
+  uint64_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+#else
+  uint8x8_t narrowed;
+  if constexpr (sizeof(Char) == 1) {
+    uint8x16_t matches =
+        vandq_u8(vceqq_u8(vld1q_u8(subject), vdupq_n_u8(first)),
+                 vceqq_u8(vld1q_u8(subject + distance), vdupq_n_u8(last)));
+    narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+  } else {
+    uint16x8_t matches =
+        vandq_u16(vceqq_u16(vld1q_u16(subject), vdupq_n_u16(first)),
+                  vceqq_u16(vld1q_u16(subject + distance), vdupq_n_u16(last)));
+    narrowed = vmovn_u16(matches);
+  }
+  uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+#endif
+  return mask & kLowestBitOfEachLane<Char>;
+}
+
+}  // namespace string_search_simd
+
+// Compares the first and last pattern characters against a block of subject
+// positions at a time, and only looks at the characters in between for the
+// positions where both match. This rules out most positions without loading
+// them more than twice, independent of the pattern length. Like InitialSearch,
+// upgrades to Boyer-Moore-Horspool if the filter lets through so many false
+// positives that comparing them costs more than the positions scanned, which
+// only happens for repetitive subjects and patterns.
+template <typename PatternChar, typename SubjectChar>
+int StringSearch<PatternChar, SubjectChar>::VectorizedSearch(
+    StringSearch<PatternChar, SubjectChar>* search,
+    base::Vector<const SubjectChar> subject, int index) {
+  using string_search_simd::kBitsPerLane;
+  using string_search_simd::kLanes;
+  base::Vector<const PatternChar> pattern = search->pattern_;
+  int pattern_length = pattern.length();
+  DCHECK_GT(pattern_length, 1);
+  // If the pattern has a character that does not fit into SubjectChar, the
+  // constructor has picked FailSearch.
+  const SubjectChar first = static_cast<SubjectChar>(pattern[0]);
+  const SubjectChar last =
+      static_cast<SubjectChar>(pattern[pattern_length - 1]);
+  const int distance = pattern_length - 1;
+  const int n = subject.length() - pattern_length;
+  int badness = -10 - (pattern_length << 2);
+
+  int i = index;
+  // Both loads of a block must stay within the subject.
+  for (; i <= n - (kLanes<SubjectChar> - 1); i += kLanes<SubjectChar>) {
+    uint64_t mask = string_search_simd::FirstAndLastCharacterMask(
+        subject.begin() + i, distance, first, last);
+    while (mask != 0) {
+      int candidate =
+          i + base::bits::CountTrailingZeros(mask) / kBitsPerLane<SubjectChar>;
+      int j = 1;
+      while (j < distance && pattern[j] == subject[candidate + j]) j++;
+      if (j >= distance) return candidate;
+      badness += j;
+      mask &= mask - 1;
+    }
+    badness -= kLanes<SubjectChar>;
+    if (badness > 0 && pattern_length >= kBMMinPatternLength) {
+      search->PopulateBoyerMooreHorspoolTable();
+      search->strategy_ = &BoyerMooreHorspoolSearch;
+      return BoyerMooreHorspoolSearch(search, subject,
+                                      i + kLanes<SubjectChar>);
+    }
+  }
+  // Fewer than a block of positions is left.
+  return LinearSearch(search, subject, i);
+}
+
+#endif  // V8_STRING_SEARCH_SIMD
+
 // Perform a a single stand-alone search.
 // If searching multiple times for the same pattern, a search
 // object should be constructed once and the Search function then called
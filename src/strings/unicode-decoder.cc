@@ -76,9 +76,11 @@ Utf8DecoderBase<Decoder>::Utf8DecoderBase(base::Vector<const uint8_t> data)
                   state == Traits::DfaDecoder::kAccept)) {
       DCHECK_EQ(0u, current);
       DCHECK(!Traits::IsInvalidSurrogatePair(previous, *cursor));
-      previous = *cursor;
-      utf16_length_++;
-      cursor++;
+      // Skip the whole run of ASCII characters.
+      size_t ascii_length = AsciiPrefixLength(cursor, end - cursor);
+      cursor += ascii_length;
+      previous = cursor[-1];
+      utf16_length_ += static_cast<int>(ascii_length);
       continue;
     }
 
@@ -144,8 +146,11 @@ void Utf8DecoderBase<Decoder>::Decode(Char* out,
     if (V8_LIKELY(*cursor <= unibrow::Utf8::kMaxOneByteChar &&
                   state == Traits::DfaDecoder::kAccept)) {
       DCHECK_EQ(0u, current);
-      *(out++) = static_cast<Char>(*cursor);
-      cursor++;
+      // Copy the whole run of ASCII characters.
+      size_t ascii_length = AsciiPrefixLength(cursor, end - cursor);
+      CopyChars(out, cursor, ascii_length);
+      out += ascii_length;
+      cursor += ascii_length;
       continue;
     }
 
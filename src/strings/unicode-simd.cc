@@ -0,0 +1,72 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/unicode-simd.h"
+
+#include "src/strings/unicode-inl.h"
+#include "src/utils/memcopy.h"
+
+namespace v8 {
+namespace internal {
+
+template <typename Char>
+size_t Utf8Length(base::Vector<const Char> chars) {
+  const Char* cursor = chars.begin();
+  const Char* end = chars.end();
+  size_t length = 0;
+  int previous = unibrow::Utf16::kNoPreviousCharacter;
+  while (cursor < end) {
+    if (*cursor <= unibrow::Utf8::kMaxOneByteChar) {
+      size_t ascii_length = AsciiPrefixLength(cursor, end - cursor);
+      length += ascii_length;
+      cursor += ascii_length;
+      previous = unibrow::Utf16::kNoPreviousCharacter;
+      continue;
+    }
+    int c = *cursor++;
+    length += unibrow::Utf8::Length(c, previous);
+    previous = c;
+  }
+  return length;
+}
+
+template <typename Char>
+char* EncodeUtf8(base::Vector<const Char> chars, char* out,
+                 bool replace_invalid, int* previous) {
+  const Char* cursor = chars.begin();
+  const Char* end = chars.end();
+  while (cursor < end) {
+    if (*cursor <= unibrow::Utf8::kMaxOneByteChar) {
+      size_t ascii_length = AsciiPrefixLength(cursor, end - cursor);
+      CopyChars(out, cursor, ascii_length);
+      out += ascii_length;
+      cursor += ascii_length;
+      *previous = cursor[-1];
+      continue;
+    }
+    Char c = *cursor++;
+    if constexpr (sizeof(Char) == 1) {
+      out += unibrow::Utf8::EncodeOneByte(out, c);
+    } else {
+      out += unibrow::Utf8::Encode(out, c, *previous, replace_invalid);
+    }
+    *previous = c;
+  }
+  return out;
+}
+
+template V8_EXPORT_PRIVATE size_t
+Utf8Length(base::Vector<const uint8_t> chars);
+template V8_EXPORT_PRIVATE size_t
+Utf8Length(base::Vector<const base::uc16> chars);
+
+template V8_EXPORT_PRIVATE char* EncodeUtf8(base::Vector<const uint8_t> chars,
+                                            char* out, bool replace_invalid,
+                                            int* previous);
+template V8_EXPORT_PRIVATE char* EncodeUtf8(
+    base::Vector<const base::uc16> chars, char* out, bool replace_invalid,
+    int* previous);
+
+}  // namespace internal
+}  // namespace v8
@@ -0,0 +1,152 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef V8_STRINGS_UNICODE_SIMD_H_
+#define V8_STRINGS_UNICODE_SIMD_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "src/base/bits.h"
+#include "src/base/macros.h"
+#include "src/base/vector.h"
+#include "src/common/globals.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define V8_UNICODE_SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(V8_HOST_ARCH_ARM64)
+#define V8_UNICODE_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+// Vectorized building blocks for converting between UTF-8 and V8's one- and
+// two-byte strings. Text at the embedder boundary is overwhelmingly ASCII, so
+// the helpers below find the extent of ASCII runs 16 bytes at a time (and
+// check 64 bytes per iteration while nothing is found), which lets the
+// decoders and encoders copy such runs in bulk and only fall back to their
+// per code point state machines for the remaining characters.
+
+namespace v8 {
+namespace internal {
+
+namespace unicode_simd_detail {
+
+// Index of the first non-ASCII character in |chars|, which holds at most
+// |length| characters, or |length| if there is none. Word-at-a-time version
+// for hosts without SSE2 or Neon, and for the tails of the vectorized loops.
+template <typename Char>
+V8_INLINE size_t ScalarAsciiPrefixLength(const Char* chars, size_t length) {
+  const Char* start = chars;
+  const Char* limit = chars + length;
+  if (length * sizeof(Char) >= kIntptrSize) {
+    // Check unaligned characters.
+    while (!IsAligned(reinterpret_cast<intptr_t>(chars), kIntptrSize)) {
+      if (*chars > 0x7F) return chars - start;
+      ++chars;
+    }
+    // Check aligned words.
+    const uintptr_t non_ascii_mask =
+        sizeof(Char) == 1 ? kUintptrAllBitsSet / 0xFF * 0x80
+                          : kUintptrAllBitsSet / 0xFFFF * 0xFF80;
+    while (chars + sizeof(uintptr_t) / sizeof(Char) <= limit) {
+      if (*reinterpret_cast<const uintptr_t*>(chars) & non_ascii_mask) break;
+      chars += sizeof(uintptr_t) / sizeof(Char);
+    }
+  }
+  // Check the remaining characters, including the ones of a word that holds
+  // a non-ASCII character.
+  while (chars < limit) {
+    if (*chars > 0x7F) break;
+    ++chars;
+  }
+  return chars - start;
+}
+
+}  // namespace unicode_simd_detail
+
+// Returns the number of leading ASCII characters in |chars|, i.e. the index
+// of the first character > 0x7F, or |length| if all characters are ASCII.
+template <typename Char>
+V8_INLINE size_t AsciiPrefixLength(const Char* chars, size_t length) {
+  static_assert(sizeof(Char) == 1 || sizeof(Char) == 2);
+  constexpr size_t kBlockSize = 16;
+  constexpr size_t kLanes = kBlockSize / sizeof(Char);
+  size_t i = 0;
+#if defined(V8_UNICODE_SIMD_SSE2)
+  auto load = [&](size_t index) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(chars + index));
+  };
+  // Bitmask with sizeof(Char) bits set for every non-ASCII lane.
+  auto non_ascii_mask = [](__m128i v) -> uint32_t {
+    if constexpr (sizeof(Char) == 1) {
+      return _mm_movemask_epi8(v);
+    } else {
+      __m128i high =
+          _mm_and_si128(v, _mm_set1_epi16(static_cast<int16_t>(0xFF80)));
+      return ~_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) &
+             0xFFFF;
+    }
+  };
+  for (; i + 4 * kLanes <= length; i += 4 * kLanes) {
+    __m128i any = _mm_or_si128(_mm_or_si128(load(i), load(i + kLanes)),
+                               _mm_or_si128(load(i + 2 * kLanes),
+                                            load(i + 3 * kLanes)));
+    if (non_ascii_mask(any) != 0) break;
+  }
+  for (; i + kLanes <= length; i += kLanes) {
+    uint32_t mask = non_ascii_mask(load(i));
+    if (mask != 0) {
+      return i + base::bits::CountTrailingZeros(mask) / sizeof(Char);
+    }
+  }
+#elif defined(V8_UNICODE_SIMD_NEON)
+  auto load = [&](size_t index) {
+    return vld1q_u8(reinterpret_cast<const uint8_t*>(chars + index));
+  };
+  auto has_non_ascii = [](uint8x16_t v) {
+    if constexpr (sizeof(Char) == 1) {
+      return vmaxvq_u8(v) > 0x7F;
+    } else {
+      return vmaxvq_u16(vreinterpretq_u16_u8(v)) > 0x7F;
+    }
+  };
+  for (; i + 4 * kLanes <= length; i += 4 * kLanes) {
+    uint8x16_t any = vorrq_u8(vorrq_u8(load(i), load(i + kLanes)),
+                              vorrq_u8(load(i + 2 * kLanes),
+                                       load(i + 3 * kLanes)));
+    if (has_non_ascii(any)) break;
+  }
+  for (; i + kLanes <= length; i += kLanes) {
+    if (has_non_ascii(load(i))) break;
+  }
+#endif
+  return i + unicode_simd_detail::ScalarAsciiPrefixLength(chars + i,
+                                                          length - i);
+}
+
+// Returns the number of bytes needed to encode |chars| as UTF-8. Surrogate
+// pairs take four bytes, lone surrogates three, just like with
+// unibrow::Utf8::Length.
+template <typename Char>
+V8_EXPORT_PRIVATE size_t Utf8Length(base::Vector<const Char> chars);
+
+// Encodes |chars| as UTF-8 into |out|, which must have room for
+// unibrow::Utf8::kMax8BitCodeUnitSize resp. kMax16BitCodeUnitSize bytes per
+// character, and returns the end of the output. Runs of ASCII characters are
+// copied in bulk. |previous| holds the character preceding |chars|, or
+// unibrow::Utf16::kNoPreviousCharacter, and is updated to the last character
+// of |chars|; a trail surrogate at the start of |chars| that completes a pair
+// with it rewrites the three bytes written for the lead surrogate right before
+// |out|, as unibrow::Utf8::Encode does. Lone surrogates are replaced with
+// U+FFFD if |replace_invalid| is set, and encoded as WTF-8 otherwise.
+template <typename Char>
+V8_EXPORT_PRIVATE char* EncodeUtf8(base::Vector<const Char> chars, char* out,
+                                   bool replace_invalid, int* previous);
+
+}  // namespace internal
+}  // namespace v8
+
+#endif  // V8_STRINGS_UNICODE_SIMD_H_
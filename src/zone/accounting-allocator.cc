@@ -4,14 +4,18 @@
 
 #include "src/zone/accounting-allocator.h"
 
+#include <atomic>
 #include <memory>
+#include <optional>
 
 #include "src/base/bounded-page-allocator.h"
 #include "src/base/logging.h"
 #include "src/base/macros.h"
+#include "src/flags/flags.h"
 #include "src/utils/allocation.h"
 #include "src/zone/zone-compression.h"
 #include "src/zone/zone-segment.h"
+#include "src/zone/zone.h"
 
 namespace v8 {
 namespace internal {
@@ -63,6 +67,216 @@ std::unique_ptr<v8::base::BoundedPageAllocator> CreateBoundedAllocator(
   return allocator;
 }
 
+// Caches segments of the sizes that zones commonly use for reuse by other
+// zones, as concurrent compile jobs create and destroy zones at a high rate.
+//
+// Every thread keeps a few segments per size class in its own cache. Surplus
+// segments go to a lock-free global list per size class, so threads don't
+// contend on a lock when they allocate or return segments. Thread caches are
+// never freed, as there is no cheap way to learn about exiting threads.
+// Instead, they are linked into a global list, so that threads that miss in
+// their own cache and the global list can take segments of other threads,
+// including exited ones, and so that ReleaseAll() can free them.
+class SegmentCache final {
+ public:
+  // Returns whether segments of |bytes| are cached. Zones start out with
+  // segments of the minimum size and allocate segments of the maximum size
+  // once they have grown. Segments of other sizes are not cached, as rounding
+  // them up to a cached size would waste memory.
+  static std::optional<size_t> SizeClassFor(size_t bytes) {
+    for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+      if (kSizeClasses[size_class] == bytes) return size_class;
+    }
+    return std::nullopt;
+  }
+
+  // Returns a cached segment of the given size class, if any.
+  static Segment* Get(size_t size_class);
+  // Adds |segment| to the cache. Returns false if the cache is full or does
+  // not cache segments of that size.
+  static bool Put(Segment* segment);
+  // Releases all cached segments, including the ones in thread caches.
+  static void ReleaseAll();
+
+ private:
+  static constexpr size_t kSizeClasses[] = {Zone::kMinimumSegmentSize,
+                                            Zone::kMaximumSegmentSize};
+  static constexpr size_t kNumSizeClasses = arraysize(kSizeClasses);
+  static constexpr size_t kThreadCapacity = 4;
+  static constexpr size_t kGlobalCapacity = 32;
+
+  // Only the owning thread adds segments to its cache, but any thread may
+  // take them, which is why slots are atomic.
+  struct ThreadCache {
+    std::atomic<Segment*> slots[kNumSizeClasses][kThreadCapacity] = {};
+    ThreadCache* next = nullptr;
+  };
+
+  struct GlobalList {
+    std::atomic<Segment*> head{nullptr};
+    // Number of segments in the list, including segments that are temporarily
+    // taken out by Get().
+    std::atomic<size_t> size{0};
+  };
+
+  // Returns the calling thread's cache. It is created on first use.
+  static ThreadCache* thread_cache();
+  static Segment* TakeFromThreadCache(ThreadCache* cache, size_t size_class);
+  static Segment* TakeFromGlobalList(ThreadCache* cache, size_t size_class);
+  static bool PushGlobal(size_t size_class, Segment* segment);
+  // Adds the chain of segments starting at |first| to the global list.
+  static void SpliceGlobal(size_t size_class, Segment* first);
+  static void Free(Segment* segment);
+
+  // Trivially destructible, so that no code runs on thread exit.
+  static thread_local ThreadCache* thread_cache_;
+  static std::atomic<ThreadCache*> thread_caches_;
+  static GlobalList global_lists_[kNumSizeClasses];
+};
+
+thread_local SegmentCache::ThreadCache* SegmentCache::thread_cache_ = nullptr;
+std::atomic<SegmentCache::ThreadCache*> SegmentCache::thread_caches_{nullptr};
+SegmentCache::GlobalList SegmentCache::global_lists_[kNumSizeClasses];
+
+// static
+SegmentCache::ThreadCache* SegmentCache::thread_cache() {
+  if (V8_LIKELY(thread_cache_)) return thread_cache_;
+  ThreadCache* cache = new ThreadCache();
+  // Thread caches are never removed from the list, so pushing them is not
+  // subject to ABA problems.
+  ThreadCache* head = thread_caches_.load(std::memory_order_relaxed);
+  do {
+    cache->next = head;
+  } while (!thread_caches_.compare_exchange_weak(
+      head, cache, std::memory_order_release, std::memory_order_relaxed));
+  thread_cache_ = cache;
+  return cache;
+}
+
+// static
+Segment* SegmentCache::TakeFromThreadCache(ThreadCache* cache,
+                                           size_t size_class) {
+  for (std::atomic<Segment*>& slot : cache->slots[size_class]) {
+    if (!slot.load(std::memory_order_relaxed)) continue;
+    if (Segment* segment = slot.exchange(nullptr, std::memory_order_acquire)) {
+      return segment;
+    }
+  }
+  return nullptr;
+}
+
+// static
+Segment* SegmentCache::TakeFromGlobalList(ThreadCache* cache,
+                                          size_t size_class) {
+  // Popping single segments from a lock-free list is prone to ABA problems.
+  // Take the whole list instead, refill the thread cache from it, and return
+  // the remainder.
+  GlobalList& list = global_lists_[size_class];
+  if (!list.head.load(std::memory_order_relaxed)) return nullptr;
+  Segment* segment = list.head.exchange(nullptr, std::memory_order_acquire);
+  if (!segment) return nullptr;
+  Segment* rest = segment->next();
+  size_t taken = 1;
+  for (std::atomic<Segment*>& slot : cache->slots[size_class]) {
+    if (!rest) break;
+    if (slot.load(std::memory_order_relaxed)) continue;
+    Segment* next = rest->next();
+    slot.store(rest, std::memory_order_release);
+    rest = next;
+    ++taken;
+  }
+  list.size.fetch_sub(taken, std::memory_order_relaxed);
+  if (rest) SpliceGlobal(size_class, rest);
+  return segment;
+}
+
+// static
+Segment* SegmentCache::Get(size_t size_class) {
+  ThreadCache* cache = thread_cache();
+  if (Segment* segment = TakeFromThreadCache(cache, size_class)) {
+    return segment;
+  }
+  if (Segment* segment = TakeFromGlobalList(cache, size_class)) {
+    return segment;
+  }
+  // Segments of exited threads would otherwise only be freed by ReleaseAll().
+  for (ThreadCache* other = thread_caches_.load(std::memory_order_acquire);
+       other; other = other->next) {
+    if (other == cache) continue;
+    if (Segment* segment = TakeFromThreadCache(other, size_class)) {
+      return segment;
+    }
+  }
+  return nullptr;
+}
+
+// static
+bool SegmentCache::Put(Segment* segment) {
+  const std::optional<size_t> size_class = SizeClassFor(segment->total_size());
+  if (!size_class) return false;
+  // Only this thread fills empty slots of its cache, so a slot that is seen
+  // empty stays empty until it is stored to.
+  for (std::atomic<Segment*>& slot : thread_cache()->slots[*size_class]) {
+    if (slot.load(std::memory_order_relaxed)) continue;
+    slot.store(segment, std::memory_order_release);
+    return true;
+  }
+  return PushGlobal(*size_class, segment);
+}
+
+// static
+void SegmentCache::ReleaseAll() {
+  for (ThreadCache* cache = thread_caches_.load(std::memory_order_acquire);
+       cache; cache = cache->next) {
+    for (size_t size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+      while (Segment* segment = TakeFromThreadCache(cache, size_class)) {
+        Free(segment);
+      }
+    }
+  }
+  for (GlobalList& list : global_lists_) {
+    Segment* segment = list.head.exchange(nullptr, std::memory_order_acquire);
+    size_t released = 0;
+    while (segment) {
+      Segment* next = segment->next();
+      Free(segment);
+      segment = next;
+      ++released;
+    }
+    list.size.fetch_sub(released, std::memory_order_relaxed);
+  }
+}
+
+// static
+bool SegmentCache::PushGlobal(size_t size_class, Segment* segment) {
+  GlobalList& list = global_lists_[size_class];
+  if (list.size.fetch_add(1, std::memory_order_relaxed) >= kGlobalCapacity) {
+    list.size.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  segment->set_next(nullptr);
+  SpliceGlobal(size_class, segment);
+  return true;
+}
+
+// static
+void SegmentCache::SpliceGlobal(size_t size_class, Segment* first) {
+  Segment* last = first;
+  while (last->next()) last = last->next();
+  GlobalList& list = global_lists_[size_class];
+  Segment* head = list.head.load(std::memory_order_relaxed);
+  do {
+    last->set_next(head);
+  } while (!list.head.compare_exchange_weak(
+      head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+// static
+void SegmentCache::Free(Segment* segment) {
+  segment->ZapHeader();
+  free(segment);
+}
+
 }  // namespace
 
 AccountingAllocator::AccountingAllocator() {
@@ -86,9 +300,25 @@ Segment* AccountingAllocator::AllocateSegment(size_t bytes,
                            kZonePageSize, PageAllocator::kReadWrite);
 
   } else {
-    auto result = AllocAtLeastWithRetry(bytes);
-    memory = result.ptr;
-    bytes = result.count;
+    memory = nullptr;
+    const std::optional<size_t> size_class =
+        v8_flags.zone_segment_cache ? SegmentCache::SizeClassFor(bytes)
+                                    : std::nullopt;
+    if (size_class) {
+      memory = SegmentCache::Get(*size_class);
+      if (memory) {
+        segment_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        segment_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+    if (memory == nullptr) {
+      auto result = AllocAtLeastWithRetry(bytes);
+      memory = result.ptr;
+      // Keep the exact size of cacheable segments so that they are cached
+      // once returned.
+      if (!size_class) bytes = result.count;
+    }
   }
   if (memory == nullptr) return nullptr;
 
@@ -108,12 +338,19 @@ void AccountingAllocator::ReturnSegment(Segment* segment,
   segment->ZapContents();
   size_t segment_size = segment->total_size();
   current_memory_usage_.fetch_sub(segment_size, std::memory_order_relaxed);
-  segment->ZapHeader();
   if (COMPRESS_ZONES_BOOL && supports_compression) {
+    segment->ZapHeader();
     FreePages(bounded_page_allocator_.get(), segment, segment_size);
-  } else {
-    free(segment);
+    return;
   }
+  if (v8_flags.zone_segment_cache && SegmentCache::Put(segment)) return;
+  segment->ZapHeader();
+  free(segment);
+}
+
+// static
+void AccountingAllocator::ReleaseCachedSegments() {
+  SegmentCache::ReleaseAll();
 }
 
 }  // namespace internal
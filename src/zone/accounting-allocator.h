@@ -34,10 +34,13 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
   // Allocates a new segment. Returns nullptr on failed allocation.
   Segment* AllocateSegment(size_t bytes, bool supports_compression);
 
-  // Return unneeded segments to either insert them into the pool or release
-  // them if the pool is already full or memory pressure is high.
+  // Return unneeded segments to either insert them into the segment cache or
+  // release them if the cache is already full.
   void ReturnSegment(Segment* memory, bool supports_compression);
 
+  // Releases all segments that are cached for reuse by other zones.
+  static void ReleaseCachedSegments();
+
   size_t GetCurrentMemoryUsage() const {
     return current_memory_usage_.load(std::memory_order_relaxed);
   }
@@ -46,6 +49,16 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
     return max_memory_usage_.load(std::memory_order_relaxed);
   }
 
+  // Number of segment allocations that were served from and missed in the
+  // segment cache, respectively.
+  size_t GetSegmentCacheHits() const {
+    return segment_cache_hits_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetSegmentCacheMisses() const {
+    return segment_cache_misses_.load(std::memory_order_relaxed);
+  }
+
   void TraceZoneCreation(const Zone* zone) {
     if (V8_LIKELY(!TracingFlags::is_zone_stats_enabled())) return;
     TraceZoneCreationImpl(zone);
@@ -69,6 +82,8 @@ class V8_EXPORT_PRIVATE AccountingAllocator {
  private:
   std::atomic<size_t> current_memory_usage_{0};
   std::atomic<size_t> max_memory_usage_{0};
+  std::atomic<size_t> segment_cache_hits_{0};
+  std::atomic<size_t> segment_cache_misses_{0};
 
   std::unique_ptr<VirtualMemory> reserved_area_;
   std::unique_ptr<base::BoundedPageAllocator> bounded_page_allocator_;
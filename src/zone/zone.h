@@ -221,6 +221,12 @@ class V8_EXPORT_PRIVATE Zone final {
   bool Contains(void* ptr);
 #endif
 
+  // Never allocate segments smaller than this size in bytes.
+  static const size_t kMinimumSegmentSize = 8 * KB;
+
+  // Never allocate segments larger than this size in bytes.
+  static const size_t kMaximumSegmentSize = 32 * KB;
+
  private:
   void* AsanNew(size_t size);
 
@@ -235,12 +241,6 @@ class V8_EXPORT_PRIVATE Zone final {
   // ASan requires 8-byte alignment. MIPS also requires 8-byte alignment.
   static const size_t kAlignmentInBytes = 8;
 
-  // Never allocate segments smaller than this size in bytes.
-  static const size_t kMinimumSegmentSize = 8 * KB;
-
-  // Never allocate segments larger than this size in bytes.
-  static const size_t kMaximumSegmentSize = 32 * KB;
-
   // The number of bytes allocated in this zone so far.
   std::atomic<size_t> allocation_size_ = {0};
 
@@ -2,12 +2,18 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <memory>
+#include <vector>
+
 #include "include/cppgc/allocation.h"
 #include "include/cppgc/garbage-collected.h"
 #include "include/cppgc/heap-consistency.h"
 #include "src/base/macros.h"
+#include "src/base/platform/mutex.h"
+#include "src/base/platform/platform.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap.h"
+#include "src/heap/cppgc/object-allocator.h"
 #include "test/benchmarks/cpp/cppgc/benchmark_utils.h"
 #include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
 
@@ -50,6 +56,115 @@ BENCHMARK_F(Allocate, Large)(benchmark::State& st) {
   st.SetBytesProcessed(st.iterations() * sizeof(LargeObject));
 }
 
+// Allocation throughput with several mutator threads. Each benchmark iteration
+// allocates kObjectsPerThread tiny objects on every thread. Garbage is
+// collected between iterations.
+constexpr size_t kObjectsPerThread = 100000;
+
+class ThreadLocalAllocatingThread final : public v8::base::Thread {
+ public:
+  explicit ThreadLocalAllocatingThread(ThreadLocalAllocator& allocator)
+      : v8::base::Thread(Options("Allocating thread")), allocator_(allocator) {}
+
+  void Run() final {
+    ThreadLocalAllocator::UnparkedScope unparked_scope(allocator_);
+    for (size_t i = 0; i < kObjectsPerThread; ++i) {
+      TinyObject* result = cppgc::MakeGarbageCollected<TinyObject>(
+          allocator_.GetAllocationHandle());
+      benchmark::DoNotOptimize(result);
+    }
+  }
+
+ private:
+  ThreadLocalAllocator& allocator_;
+};
+
+BENCHMARK_DEFINE_F(Allocate, TinyThreadLocal)(benchmark::State& st) {
+  const size_t num_threads = static_cast<size_t>(st.range(0));
+  std::vector<std::unique_ptr<ThreadLocalAllocator>> allocators;
+  for (size_t i = 0; i < num_threads; ++i) {
+    allocators.push_back(
+        std::make_unique<ThreadLocalAllocator>(*Heap::From(&heap())));
+  }
+  for (auto _ : st) {
+    USE(_);
+    std::vector<std::unique_ptr<ThreadLocalAllocatingThread>> threads;
+    for (auto& allocator : allocators) {
+      threads.push_back(
+          std::make_unique<ThreadLocalAllocatingThread>(*allocator));
+      CHECK(threads.back()->Start());
+    }
+    for (auto& thread : threads) thread->Join();
+    st.PauseTiming();
+    heap().ForceGarbageCollectionSlow("Benchmark", "Allocate",
+                                      cppgc::Heap::StackState::kNoHeapPointers);
+    st.ResumeTiming();
+  }
+  st.SetItemsProcessed(st.iterations() * num_threads * kObjectsPerThread);
+  st.SetBytesProcessed(st.iterations() * num_threads * kObjectsPerThread *
+                       sizeof(TinyObject));
+}
+BENCHMARK_REGISTER_F(Allocate, TinyThreadLocal)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
+// Baseline for TinyThreadLocal: all threads share the heap's allocation handle
+// behind an external lock.
+class LockedAllocatingThread final : public v8::base::Thread {
+ public:
+  LockedAllocatingThread(cppgc::Heap& heap, v8::base::Mutex& mutex)
+      : v8::base::Thread(Options("Allocating thread")),
+        heap_(heap),
+        mutex_(mutex) {}
+
+  void Run() final {
+    for (size_t i = 0; i < kObjectsPerThread; ++i) {
+      v8::base::MutexGuard guard(&mutex_);
+      TinyObject* result =
+          cppgc::MakeGarbageCollected<TinyObject>(heap_.GetAllocationHandle());
+      benchmark::DoNotOptimize(result);
+    }
+  }
+
+ private:
+  cppgc::Heap& heap_;
+  v8::base::Mutex& mutex_;
+};
+
+BENCHMARK_DEFINE_F(Allocate, TinyExternallyLocked)(benchmark::State& st) {
+  const size_t num_threads = static_cast<size_t>(st.range(0));
+  v8::base::Mutex mutex;
+  for (auto _ : st) {
+    USE(_);
+    std::vector<std::unique_ptr<LockedAllocatingThread>> threads;
+    {
+      subtle::NoGarbageCollectionScope no_gc(*Heap::From(&heap()));
+      for (size_t i = 0; i < num_threads; ++i) {
+        threads.push_back(
+            std::make_unique<LockedAllocatingThread>(heap(), mutex));
+        CHECK(threads.back()->Start());
+      }
+      for (auto& thread : threads) thread->Join();
+    }
+    st.PauseTiming();
+    heap().ForceGarbageCollectionSlow("Benchmark", "Allocate",
+                                      cppgc::Heap::StackState::kNoHeapPointers);
+    st.ResumeTiming();
+  }
+  st.SetItemsProcessed(st.iterations() * num_threads * kObjectsPerThread);
+  st.SetBytesProcessed(st.iterations() * num_threads * kObjectsPerThread *
+                       sizeof(TinyObject));
+}
+BENCHMARK_REGISTER_F(Allocate, TinyExternallyLocked)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->UseRealTime();
+
 }  // namespace
 }  // namespace internal
 }  // namespace cppgc
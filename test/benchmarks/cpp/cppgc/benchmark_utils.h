@@ -20,7 +20,12 @@ class BenchmarkWithHeap : public benchmark::Fixture {
 
  protected:
   void SetUp(::benchmark::State& state) override {
-    heap_ = cppgc::Heap::Create(GetPlatform());
+    heap_ = cppgc::Heap::Create(GetPlatform(), GetHeapOptions(state));
+  }
+
+  // Options for the heap that is created for every benchmark run.
+  virtual cppgc::Heap::HeapOptions GetHeapOptions(const ::benchmark::State&) {
+    return cppgc::Heap::HeapOptions::Default();
   }
 
   void TearDown(::benchmark::State& state) override { heap_.reset(); }
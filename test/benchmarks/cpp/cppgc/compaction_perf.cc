@@ -0,0 +1,140 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "include/cppgc/allocation.h"
+#include "include/cppgc/custom-space.h"
+#include "include/cppgc/garbage-collected.h"
+#include "include/cppgc/heap-consistency.h"
+#include "include/cppgc/persistent.h"
+#include "src/base/macros.h"
+#include "src/base/platform/time.h"
+#include "src/heap/cppgc/compactor.h"
+#include "src/heap/cppgc/heap.h"
+#include "src/heap/cppgc/marker.h"
+#include "src/heap/cppgc/sweeper.h"
+#include "test/benchmarks/cpp/cppgc/benchmark_utils.h"
+#include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
+
+namespace cppgc {
+
+class CompactableSpace : public CustomSpace<CompactableSpace> {
+ public:
+  static constexpr size_t kSpaceIndex = 0;
+  static constexpr bool kSupportsCompaction = true;
+};
+
+namespace internal {
+namespace {
+
+class Node final : public GarbageCollected<Node> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(visitor, const_cast<const Node*>(next));
+    visitor->RegisterMovableReference(const_cast<const Node**>(&next));
+  }
+
+  Node* next = nullptr;
+  char payload[128]{};
+};
+
+class Holder final : public GarbageCollected<Holder> {
+ public:
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(visitor, const_cast<const Node*>(head));
+    visitor->RegisterMovableReference(const_cast<const Node**>(&head));
+  }
+
+  Node* head = nullptr;
+};
+
+}  // namespace
+}  // namespace internal
+
+template <>
+struct SpaceTrait<internal::Node> {
+  using Space = CompactableSpace;
+};
+
+namespace internal {
+namespace {
+
+class Compaction : public testing::BenchmarkWithHeap {
+ protected:
+  cppgc::Heap::HeapOptions GetHeapOptions(
+      const benchmark::State& state) final {
+    cppgc::Heap::HeapOptions options;
+    options.custom_spaces.emplace_back(std::make_unique<CompactableSpace>());
+    // Compaction only uses parallel tasks if the heap supports concurrency.
+    options.marking_support =
+        state.range(1) ? cppgc::Heap::MarkingType::kIncrementalAndConcurrent
+                       : cppgc::Heap::MarkingType::kIncremental;
+    return options;
+  }
+};
+
+constexpr size_t kNumNodes = 512 * 1024;
+
+// Measures the atomic pause time spent in compaction of a space spanning
+// several hundred pages in which every other object is dead. The first
+// argument is the pause budget in milliseconds, or 0 for an unlimited budget.
+// The second argument selects whether compaction may use parallel tasks.
+BENCHMARK_DEFINE_F(Compaction, FragmentedSpace)(benchmark::State& st) {
+  Heap& internal_heap = *Heap::From(&heap());
+  Compactor& compactor = internal_heap.compactor();
+  compactor.set_pause_budget(
+      st.range(0) ? v8::base::TimeDelta::FromMilliseconds(st.range(0))
+                  : v8::base::TimeDelta::Max());
+  cppgc::Persistent<Holder> holder =
+      cppgc::MakeGarbageCollected<Holder>(heap().GetAllocationHandle());
+  for (auto _ : st) {
+    USE(_);
+    st.PauseTiming();
+    holder->head = nullptr;
+    internal_heap.CollectGarbage(GCConfig::PreciseAtomicConfig());
+    {
+      // Allocation must not trigger a garbage collection on its own as the
+      // setup below drives the cycle manually.
+      subtle::NoGarbageCollectionScope no_gc(internal_heap);
+      Node* dead_head = nullptr;
+      for (size_t i = 0; i < kNumNodes; ++i) {
+        Node* node =
+            cppgc::MakeGarbageCollected<Node>(heap().GetAllocationHandle());
+        if (i % 2) {
+          node->next = dead_head;
+          dead_head = node;
+        } else {
+          node->next = holder->head;
+          holder->head = node;
+        }
+      }
+      benchmark::DoNotOptimize(dead_head);
+    }
+    compactor.EnableForNextGCForTesting();
+    compactor.InitializeIfShouldCompact(GCConfig::MarkingType::kIncremental,
+                                        StackState::kNoHeapPointers);
+    internal_heap.StartIncrementalGarbageCollection(
+        GCConfig::PreciseIncrementalConfig());
+    internal_heap.marker()->FinishMarking(StackState::kNoHeapPointers);
+    internal_heap.GetMarkerRefForTesting().reset();
+    st.ResumeTiming();
+
+    const SweepingConfig::CompactableSpaceHandling compactable_space_handling =
+        compactor.CompactSpacesIfEnabled();
+
+    st.PauseTiming();
+    internal_heap.sweeper().Start({SweepingConfig::SweepingType::kAtomic,
+                                   compactable_space_handling});
+    internal_heap.sweeper().FinishIfRunning();
+    st.ResumeTiming();
+  }
+}
+BENCHMARK_REGISTER_F(Compaction, FragmentedSpace)
+    ->ArgNames({"budget_ms", "parallel"})
+    ->ArgsProduct({{0, 1, 5}, {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace internal
+}  // namespace cppgc
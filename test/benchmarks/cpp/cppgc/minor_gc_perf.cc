@@ -0,0 +1,252 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#if defined(CPPGC_YOUNG_GENERATION)
+
+#include <vector>
+
+#include "include/cppgc/allocation.h"
+#include "include/cppgc/garbage-collected.h"
+#include "include/cppgc/heap-consistency.h"
+#include "include/cppgc/member.h"
+#include "include/cppgc/persistent.h"
+#include "include/cppgc/visitor.h"
+#include "src/base/macros.h"
+#include "src/heap/cppgc/heap-config.h"
+#include "src/heap/cppgc/heap.h"
+#include "test/benchmarks/cpp/cppgc/benchmark_utils.h"
+#include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
+
+namespace cppgc {
+namespace internal {
+namespace {
+
+// Small DOM-like object model: nodes are linked to their parent and siblings
+// and optionally own out-of-line data, similar to attributes or styles.
+class NodeData final : public GarbageCollected<NodeData> {
+ public:
+  void Trace(Visitor*) const {}
+
+ private:
+  char payload_[48]{};
+};
+
+class Node : public GarbageCollected<Node> {
+ public:
+  virtual ~Node() = default;
+
+  virtual void Trace(Visitor* visitor) const {
+    visitor->Trace(parent_);
+    visitor->Trace(first_child_);
+    visitor->Trace(last_child_);
+    visitor->Trace(previous_sibling_);
+    visitor->Trace(next_sibling_);
+  }
+
+  void AppendChild(Node* child) {
+    child->parent_ = this;
+    child->previous_sibling_ = last_child_;
+    if (last_child_) {
+      last_child_->next_sibling_ = child;
+    } else {
+      first_child_ = child;
+    }
+    last_child_ = child;
+  }
+
+  void RemoveChild(Node* child) {
+    if (child->previous_sibling_) {
+      child->previous_sibling_->next_sibling_ = child->next_sibling_;
+    } else {
+      first_child_ = child->next_sibling_;
+    }
+    if (child->next_sibling_) {
+      child->next_sibling_->previous_sibling_ = child->previous_sibling_;
+    } else {
+      last_child_ = child->previous_sibling_;
+    }
+    child->parent_ = nullptr;
+    child->previous_sibling_ = nullptr;
+    child->next_sibling_ = nullptr;
+  }
+
+  Node* last_child() const { return last_child_; }
+
+ private:
+  Member<Node> parent_;
+  Member<Node> first_child_;
+  Member<Node> last_child_;
+  Member<Node> previous_sibling_;
+  Member<Node> next_sibling_;
+};
+
+class Element final : public Node {
+ public:
+  explicit Element(NodeData* data) : data_(data) {}
+
+  void Trace(Visitor* visitor) const final {
+    Node::Trace(visitor);
+    visitor->Trace(data_);
+  }
+
+ private:
+  Member<NodeData> data_;
+};
+
+class Text final : public Node {
+ private:
+  char text_[32]{};
+};
+
+// Builds a subtree of |num_nodes| nodes below a new root element. Every
+// element has a few children of which every other one is a text node.
+Node* CreateSubtree(AllocationHandle& handle, size_t num_nodes) {
+  constexpr size_t kChildrenPerElement = 4;
+  auto* root = MakeGarbageCollected<Element>(
+      handle, MakeGarbageCollected<NodeData>(handle));
+  std::vector<Node*> elements{root};
+  size_t current = 0;
+  for (size_t i = 1; i < num_nodes; ++i) {
+    if (i % kChildrenPerElement == 0) ++current;
+    Node* child;
+    if (i % 2) {
+      child = MakeGarbageCollected<Text>(handle);
+    } else {
+      child = MakeGarbageCollected<Element>(
+          handle, MakeGarbageCollected<NodeData>(handle));
+      elements.push_back(child);
+    }
+    elements[current % elements.size()]->AppendChild(child);
+  }
+  return root;
+}
+
+class MinorGC : public testing::BenchmarkWithHeap {
+ protected:
+  // Size of the document that is promoted before measuring.
+  static constexpr size_t kNumDocumentNodes = 64 * 1024;
+  // Number of nodes that is inserted into the document per cycle. Most of them
+  // survive the next minor GC.
+  static constexpr size_t kNumInsertedNodes = 4 * 1024;
+  // Number of nodes per cycle that are dropped before the next minor GC.
+  static constexpr size_t kNumTemporaryNodes = 16 * 1024;
+
+  void SetUp(::benchmark::State& state) override {
+    testing::BenchmarkWithHeap::SetUp(state);
+    Heap& internal_heap = *Heap::From(&heap());
+    internal_heap.EnableGenerationalGC();
+    internal_heap.CollectGarbage(GCConfig::PreciseAtomicConfig());
+
+    {
+      // Build a document that is old by the time the benchmark starts. The
+      // document is split into containers that receive the inserted subtrees
+      // to spread old-to-young references over many pages. The containers
+      // keep the document alive through their parent.
+      subtle::NoGarbageCollectionScope no_gc(internal_heap);
+      AllocationHandle& handle = heap().GetAllocationHandle();
+      Node* document = CreateSubtree(handle, kNumDocumentNodes);
+      for (size_t i = 0; i < kNumContainers; ++i) {
+        containers_.emplace_back(MakeGarbageCollected<Element>(
+            handle, MakeGarbageCollected<NodeData>(handle)));
+        document->AppendChild(containers_.back());
+      }
+    }
+    internal_heap.CollectGarbage(GCConfig::MinorPreciseAtomicConfig());
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    containers_.clear();
+    Heap::From(&heap())->Terminate();
+    testing::BenchmarkWithHeap::TearDown(state);
+  }
+
+  // Simulates a mutator phase: inserts a young subtree into the old document,
+  // removing the one inserted by the previous phase, and creates temporary
+  // subtrees that die young. Garbage collections are only triggered
+  // explicitly by the benchmarks.
+  void RunMutator() {
+    subtle::NoGarbageCollectionScope no_gc(*Heap::From(&heap()));
+    AllocationHandle& handle = heap().GetAllocationHandle();
+    Node* container = containers_[next_container_++ % kNumContainers];
+    if (Node* previous = container->last_child()) {
+      container->RemoveChild(previous);
+    }
+    container->AppendChild(CreateSubtree(handle, kNumInsertedNodes));
+    for (size_t i = 0; i < kNumTemporaryNodes; i += kNumInsertedNodes) {
+      benchmark::DoNotOptimize(CreateSubtree(handle, kNumInsertedNodes));
+    }
+  }
+
+  // Nodes that are removed from the document only die in a major GC. Clean up
+  // regularly to keep the size of the old generation stable.
+  void MaybeCollectOldGeneration() {
+    if (next_container_ % kNumContainers) return;
+    Heap::From(&heap())->CollectGarbage(GCConfig::PreciseAtomicConfig());
+  }
+
+ private:
+  static constexpr size_t kNumContainers = 16;
+
+  std::vector<Persistent<Node>> containers_;
+  size_t next_container_ = 0;
+};
+
+// Measures the pause of a minor GC after a mutator phase. The argument selects
+// whether marking is atomic within the pause or runs concurrently to the
+// mutator phase, in which case only finalizing marking is measured.
+BENCHMARK_DEFINE_F(MinorGC, Pause)(benchmark::State& st) {
+  Heap& internal_heap = *Heap::From(&heap());
+  const bool concurrent = st.range(0);
+  for (auto _ : st) {
+    USE(_);
+    st.PauseTiming();
+    MaybeCollectOldGeneration();
+    if (concurrent) {
+      RunMutator();
+      internal_heap.StartIncrementalGarbageCollection(
+          GCConfig::MinorPreciseConcurrentConfig());
+      // Keep the mutator busy while marking proceeds in the background.
+      RunMutator();
+      st.ResumeTiming();
+      internal_heap.FinalizeIncrementalGarbageCollectionIfRunning(
+          GCConfig::MinorPreciseConcurrentConfig());
+    } else {
+      RunMutator();
+      RunMutator();
+      st.ResumeTiming();
+      internal_heap.CollectGarbage(GCConfig::MinorPreciseAtomicConfig());
+    }
+  }
+}
+BENCHMARK_REGISTER_F(MinorGC, Pause)
+    ->ArgNames({"concurrent"})
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Measures mutator throughput including minor GCs. Every iteration consists of
+// a mutator phase followed by a minor GC.
+BENCHMARK_DEFINE_F(MinorGC, Throughput)(benchmark::State& st) {
+  Heap& internal_heap = *Heap::From(&heap());
+  for (auto _ : st) {
+    USE(_);
+    st.PauseTiming();
+    MaybeCollectOldGeneration();
+    st.ResumeTiming();
+    RunMutator();
+    internal_heap.CollectGarbage(GCConfig::MinorPreciseAtomicConfig());
+  }
+  st.SetItemsProcessed(st.iterations() *
+                       (kNumInsertedNodes + kNumTemporaryNodes));
+}
+BENCHMARK_REGISTER_F(MinorGC, Throughput)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace internal
+}  // namespace cppgc
+
+#endif  // defined(CPPGC_YOUNG_GENERATION)
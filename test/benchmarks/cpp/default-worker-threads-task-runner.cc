@@ -0,0 +1,144 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/default-worker-threads-task-runner.h"
+
+#include <atomic>
+#include <memory>
+
+#include "include/v8-platform.h"
+#include "src/base/macros.h"
+#include "src/base/platform/semaphore.h"
+#include "src/base/platform/time.h"
+#include "src/base/sys-info.h"
+#include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
+
+namespace {
+
+using v8::Task;
+using v8::platform::DefaultWorkerThreadsTaskRunner;
+
+double RealTime() {
+  return v8::base::TimeTicks::Now().ToInternalValue() /
+         static_cast<double>(v8::base::Time::kMicrosecondsPerSecond);
+}
+
+// Small amount of work per task, so that the benchmarks measure scheduling.
+void DoWork() {
+  size_t value = 0;
+  for (size_t i = 0; i < 64; ++i) benchmark::DoNotOptimize(value += i);
+}
+
+// Counts finished tasks and signals once all tasks of an iteration are done.
+class Completion {
+ public:
+  explicit Completion(size_t num_tasks) : remaining_(num_tasks) {}
+
+  void Done() {
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      semaphore_.Signal();
+    }
+  }
+
+  void Wait() { semaphore_.Wait(); }
+
+ private:
+  std::atomic<size_t> remaining_;
+  v8::base::Semaphore semaphore_{0};
+};
+
+class LeafTask final : public Task {
+ public:
+  explicit LeafTask(Completion* completion) : completion_(completion) {}
+
+  void Run() override {
+    DoWork();
+    completion_->Done();
+  }
+
+ private:
+  Completion* const completion_;
+};
+
+// Posts two child tasks from the worker thread until |depth| reaches zero,
+// similar to jobs that split their work.
+class ForkTask final : public Task {
+ public:
+  ForkTask(DefaultWorkerThreadsTaskRunner* runner, Completion* completion,
+           int depth)
+      : runner_(runner), completion_(completion), depth_(depth) {}
+
+  void Run() override {
+    if (depth_ > 0) {
+      runner_->PostTask(
+          std::make_unique<ForkTask>(runner_, completion_, depth_ - 1));
+      runner_->PostTask(
+          std::make_unique<ForkTask>(runner_, completion_, depth_ - 1));
+    }
+    DoWork();
+    completion_->Done();
+  }
+
+ private:
+  DefaultWorkerThreadsTaskRunner* const runner_;
+  Completion* const completion_;
+  const int depth_;
+};
+
+// Registers powers of two up to the number of processors as number of worker
+// threads.
+void WorkerThreadArguments(benchmark::internal::Benchmark* benchmark) {
+  const int num_processors = v8::base::SysInfo::NumberOfProcessors();
+  for (int num_threads = 1; num_threads < num_processors; num_threads *= 2) {
+    benchmark->Arg(num_threads);
+  }
+  benchmark->Arg(num_processors);
+}
+
+// Measures throughput of tasks that are posted from a thread outside of the
+// pool.
+void BM_PostFromExternalThread(benchmark::State& state) {
+  static constexpr size_t kNumTasks = 16 * 1024;
+  DefaultWorkerThreadsTaskRunner runner(static_cast<uint32_t>(state.range(0)),
+                                        RealTime);
+  for (auto _ : state) {
+    USE(_);
+    Completion completion(kNumTasks);
+    for (size_t i = 0; i < kNumTasks; ++i) {
+      runner.PostTask(std::make_unique<LeafTask>(&completion));
+    }
+    completion.Wait();
+  }
+  runner.Terminate();
+  state.SetItemsProcessed(state.iterations() * kNumTasks);
+}
+BENCHMARK(BM_PostFromExternalThread)
+    ->Apply(WorkerThreadArguments)
+    ->ArgName("threads")
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// Measures throughput of tasks that are posted from worker threads of the
+// pool.
+void BM_PostFromWorkerThreads(benchmark::State& state) {
+  static constexpr int kDepth = 14;
+  static constexpr size_t kNumTasks = (size_t{1} << (kDepth + 1)) - 1;
+  DefaultWorkerThreadsTaskRunner runner(static_cast<uint32_t>(state.range(0)),
+                                        RealTime);
+  for (auto _ : state) {
+    USE(_);
+    Completion completion(kNumTasks);
+    runner.PostTask(std::make_unique<ForkTask>(&runner, &completion, kDepth));
+    completion.Wait();
+  }
+  runner.Terminate();
+  state.SetItemsProcessed(state.iterations() * kNumTasks);
+}
+BENCHMARK(BM_PostFromWorkerThreads)
+    ->Apply(WorkerThreadArguments)
+    ->ArgName("threads")
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+}  // namespace
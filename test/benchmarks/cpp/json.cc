@@ -0,0 +1,233 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <string>
+
+#include "include/v8-context.h"
+#include "include/v8-json.h"
+#include "include/v8-local-handle.h"
+#include "include/v8-persistent-handle.h"
+#include "include/v8-primitive.h"
+#include "include/v8-profiler.h"
+#include "src/base/logging.h"
+#include "src/base/macros.h"
+#include "test/benchmarks/cpp/benchmark-utils.h"
+#include "third_party/google_benchmark_chrome/src/include/benchmark/benchmark.h"
+
+namespace {
+
+// Number of rows in the generated payloads, i.e. a few hundred KB of JSON.
+constexpr int kRows = 8 * 1024;
+
+// An array of row-shaped objects as commonly returned by APIs.
+std::string MakeRowsPayload(bool pretty) {
+  const char* nl = pretty ? "\n" : "";
+  const char* indent = pretty ? "    " : "";
+  const char* sep = pretty ? ": " : ":";
+  std::string json = "[";
+  for (int i = 0; i < kRows; i++) {
+    if (i > 0) json += ",";
+    json += nl;
+    json += "{";
+    json += nl;
+    json += indent + std::string("\"id\"") + sep + std::to_string(i) + ",";
+    json += nl;
+    json += indent + std::string("\"name\"") + sep + "\"user_" +
+            std::to_string(i) + "\",";
+    json += nl;
+    json += indent + std::string("\"score\"") + sep +
+            std::to_string(i * 1234567) + "." + std::to_string(i % 1000) + ",";
+    json += nl;
+    json += indent + std::string("\"active\"") + sep +
+            (i % 2 ? "true" : "false");
+    json += nl;
+    json += "}";
+  }
+  json += nl;
+  json += "]";
+  return json;
+}
+
+// An array of long strings, exercising the string scanner.
+std::string MakeStringsPayload() {
+  std::string json = "[";
+  for (int i = 0; i < kRows / 8; i++) {
+    if (i > 0) json += ",";
+    json += "\"";
+    for (int j = 0; j < 64; j++) {
+      json += "Lorem ipsum dolor sit amet, consectetur adipiscing elit. ";
+    }
+    // Every string carries one escape to cover the slow path as well.
+    json += "\\n\"";
+  }
+  json += "]";
+  return json;
+}
+
+// An array of numbers with many digits.
+std::string MakeNumbersPayload() {
+  std::string json = "[";
+  for (int i = 0; i < kRows * 4; i++) {
+    if (i > 0) json += ",";
+    json += std::to_string(1234567890123ll + i) + ".0123456789e-7";
+  }
+  json += "]";
+  return json;
+}
+
+class JsonFixture : public v8::benchmarking::BenchmarkWithIsolate {
+ public:
+  void SetUp(::benchmark::State& state) override {
+    auto* isolate = v8_isolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    context_.Reset(isolate, context);
+    context->Enter();
+  }
+
+  void TearDown(::benchmark::State& state) override {
+    auto* isolate = v8_isolate();
+    v8::HandleScope handle_scope(isolate);
+    context_.Get(isolate)->Exit();
+    context_.Reset();
+  }
+
+ protected:
+  v8::Local<v8::Context> context() { return context_.Get(v8_isolate()); }
+
+ private:
+  v8::Global<v8::Context> context_;
+};
+
+class JsonParse : public JsonFixture {
+ protected:
+  void Run(::benchmark::State& state, const std::string& payload,
+           bool two_byte = false) {
+    auto* isolate = v8_isolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = this->context();
+    v8::Local<v8::String> source;
+    if (two_byte) {
+      // Append a non-Latin1 string to force a two-byte source.
+      std::u16string wide(payload.begin(), payload.end() - 1);
+      wide += u",\"\u2603\"]";
+      source = v8::String::NewFromTwoByte(
+                   isolate, reinterpret_cast<const uint16_t*>(wide.data()),
+                   v8::NewStringType::kNormal, static_cast<int>(wide.size()))
+                   .ToLocalChecked();
+    } else {
+      source = v8::String::NewFromUtf8(isolate, payload.data(),
+                                       v8::NewStringType::kNormal,
+                                       static_cast<int>(payload.size()))
+                   .ToLocalChecked();
+    }
+    for (auto _ : state) {
+      USE(_);
+      v8::HandleScope iteration_scope(isolate);
+      v8::Local<v8::Value> result =
+          v8::JSON::Parse(context, source).ToLocalChecked();
+      benchmark::DoNotOptimize(result);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            source->Length() *
+                            (source->IsOneByte() ? 1 : 2));
+  }
+};
+
+// Discards the output, like an embedder that writes to a socket would.
+class NullOutputStream : public v8::OutputStream {
+ public:
+  void EndOfStream() override {}
+  int GetChunkSize() override { return 64 * 1024; }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    benchmark::DoNotOptimize(data);
+    bytes_ += size;
+    return kContinue;
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+// Compares producing UTF-8 through a heap string with writing it to an
+// OutputStream directly.
+class JsonStringify : public JsonFixture {
+ protected:
+  void Run(::benchmark::State& state, const std::string& payload,
+           bool to_stream) {
+    auto* isolate = v8_isolate();
+    v8::HandleScope handle_scope(isolate);
+    v8::Local<v8::Context> context = this->context();
+    v8::Local<v8::String> source =
+        v8::String::NewFromUtf8(isolate, payload.data(),
+                                v8::NewStringType::kNormal,
+                                static_cast<int>(payload.size()))
+            .ToLocalChecked();
+    v8::Local<v8::Value> value =
+        v8::JSON::Parse(context, source).ToLocalChecked();
+    std::string buffer;
+    size_t bytes = 0;
+    for (auto _ : state) {
+      USE(_);
+      v8::HandleScope iteration_scope(isolate);
+      if (to_stream) {
+        NullOutputStream stream;
+        CHECK(v8::JSON::StringifyToStream(context, value, &stream).FromJust());
+        bytes = stream.bytes();
+      } else {
+        v8::Local<v8::String> json =
+            v8::JSON::Stringify(context, value).ToLocalChecked();
+        buffer.resize(json->Utf8Length(isolate));
+        json->WriteUtf8(isolate, buffer.data(), static_cast<int>(buffer.size()),
+                        nullptr, v8::String::NO_NULL_TERMINATION);
+        bytes = buffer.size();
+      }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * bytes);
+  }
+};
+
+}  // namespace
+
+BENCHMARK_F(JsonParse, CompactRows)(benchmark::State& st) {
+  Run(st, MakeRowsPayload(false));
+}
+
+BENCHMARK_F(JsonParse, PrettyRows)(benchmark::State& st) {
+  Run(st, MakeRowsPayload(true));
+}
+
+BENCHMARK_F(JsonParse, PrettyRowsTwoByte)(benchmark::State& st) {
+  Run(st, MakeRowsPayload(true), true);
+}
+
+BENCHMARK_F(JsonParse, LongStrings)(benchmark::State& st) {
+  Run(st, MakeStringsPayload());
+}
+
+BENCHMARK_F(JsonParse, LongStringsTwoByte)(benchmark::State& st) {
+  Run(st, MakeStringsPayload(), true);
+}
+
+BENCHMARK_F(JsonParse, Numbers)(benchmark::State& st) {
+  Run(st, MakeNumbersPayload());
+}
+
+BENCHMARK_F(JsonStringify, RowsToString)(benchmark::State& st) {
+  Run(st, MakeRowsPayload(false), false);
+}
+
+BENCHMARK_F(JsonStringify, RowsToStream)(benchmark::State& st) {
+  Run(st, MakeRowsPayload(false), true);
+}
+
+BENCHMARK_F(JsonStringify, LongStringsToString)(benchmark::State& st) {
+  Run(st, MakeStringsPayload(), false);
+}
+
+BENCHMARK_F(JsonStringify, LongStringsToStream)(benchmark::State& st) {
+  Run(st, MakeStringsPayload(), true);
+}
@@ -432,6 +432,60 @@ HEAP_TEST(CompactionPartiallyAbortedPageWithRememberedSetEntries) {
   heap->RemoveNearHeapLimitCallback(reset_oom, 0u);
 }
 
+HEAP_TEST(CompactionLargeObjects) {
+  if (!v8_flags.compact) return;
+  v8_flags.compact_large_objects = true;
+  ManualGCScope manual_gc_scope;
+  CcTest::InitializeVM();
+  Isolate* isolate = CcTest::i_isolate();
+  Heap* heap = isolate->heap();
+  Factory* factory = isolate->factory();
+  DisableConservativeStackScanningScopeForTesting no_stack_scanning(heap);
+
+  // Large enough to span many OS pages, most of which are remapped.
+  const int kLength = 256 * KB;
+  HandleScope scope(isolate);
+  // Only objects above the range that large pages would occupy if packed
+  // from the lowest one are moved, so keep a page below the hole alive.
+  DirectHandle<FixedArray> floor =
+      factory->NewFixedArray(kLength / 4, AllocationType::kOld);
+  CHECK(heap->lo_space()->Contains(*floor));
+  IndirectHandle<FixedArray> array;
+  {
+    HandleScope inner_scope(isolate);
+    // Leaves a hole below the array that also fits its aligned page.
+    DirectHandle<FixedArray> padding =
+        factory->NewFixedArray(2 * kLength, AllocationType::kOld);
+    CHECK(heap->lo_space()->Contains(*padding));
+    array = inner_scope.CloseAndEscape(
+        factory->NewFixedArray(kLength, AllocationType::kOld));
+  }
+  CHECK(heap->lo_space()->Contains(*array));
+  DirectHandle<FixedArray> young = factory->NewFixedArray(1);
+  for (int i = 0; i < kLength; i++) array->set(i, Smi::FromInt(i));
+  array->set(0, *young);
+  array->set(1, *array);
+  const Address old_address = array->address();
+
+  // The first GC frees the padding, the second one moves the array.
+  heap::InvokeMajorGC(heap);
+  heap::InvokeMajorGC(heap);
+
+  CHECK(heap->lo_space()->Contains(*array));
+#ifdef V8_COMPRESS_POINTERS
+  // The page allocator of the pointer compression cage hands out the best
+  // fitting free region, which is the hole left by the padding.
+  CHECK_LT(array->address(), old_address);
+#else
+  USE(old_address);
+#endif  // V8_COMPRESS_POINTERS
+  CHECK_EQ(*young, array->get(0));
+  CHECK_EQ(*array, array->get(1));
+  for (int i = 2; i < kLength; i++) {
+    CHECK_EQ(Smi::FromInt(i), array->get(i));
+  }
+}
+
 }  // namespace heap
 }  // namespace internal
 }  // namespace v8
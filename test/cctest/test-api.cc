@@ -21040,6 +21040,67 @@ THREADED_TEST(JSONParseArray) {
                      i::PACKED_ELEMENTS);
 }
 
+namespace {
+v8::MaybeLocal<Value> JSONStreamingParse(Local<Context> context,
+                                         const char* input, size_t chunk_size) {
+  v8::JSON::StreamingParser parser(context->GetIsolate());
+  size_t length = strlen(input);
+  for (size_t i = 0; i < length; i += chunk_size) {
+    if (parser.Feed(context, input + i, std::min(chunk_size, length - i))
+            .IsNothing()) {
+      return {};
+    }
+  }
+  return parser.Finish(context);
+}
+}  // namespace
+
+THREADED_TEST(JSONStreamingParser) {
+  LocalContext context;
+  HandleScope scope(context->GetIsolate());
+  const char* inputs[] = {
+      "[]",
+      " [ ] ",
+      "[0, 1.5, \"a,]\\\"b\", {\"x\": [1, {\"y\": \"}\"}]}, null]",
+      "[[1, 2], [], [3, [4]]]",
+      "[\"\xE2\x98\x83\", \"\\u2603\"]",
+      "{\"x\": [1, 2, 3]}",
+      "\"string\"",
+      "42",
+  };
+  for (const char* input : inputs) {
+    Local<Value> expected =
+        v8::JSON::Parse(context.local(), v8_str(input)).ToLocalChecked();
+    for (size_t chunk_size : {1, 2, 3, 7, 1024}) {
+      Local<Value> actual =
+          JSONStreamingParse(context.local(), input, chunk_size)
+              .ToLocalChecked();
+      CHECK(v8::JSON::Stringify(context.local(), actual)
+                .ToLocalChecked()
+                ->StrictEquals(v8::JSON::Stringify(context.local(), expected)
+                                   .ToLocalChecked()));
+    }
+  }
+
+  Local<Value> array =
+      JSONStreamingParse(context.local(), "[1, 2.5, 3]", 2).ToLocalChecked();
+  CHECK_EQ(i::PACKED_DOUBLE_ELEMENTS,
+           i::Cast<i::JSArray>(v8::Utils::OpenDirectHandle(*array))
+               ->GetElementsKind());
+
+  const char* invalid_inputs[] = {"",      "[",     "[1,]", "[,1]",
+                                  "[1,,2]", "[1}",   "[1 2]", "[1] x",
+                                  "{",      "[\"a]", "[{]"};
+  for (const char* input : invalid_inputs) {
+    for (size_t chunk_size : {1, 4, 1024}) {
+      v8::TryCatch try_catch(context->GetIsolate());
+      CHECK(JSONStreamingParse(context.local(), input, chunk_size).IsEmpty());
+      CHECK(try_catch.HasCaught());
+      CHECK(try_catch.Exception()->IsNativeError());
+    }
+  }
+}
+
 THREADED_TEST(JSONStringifyObject) {
   LocalContext context;
   HandleScope scope(context->GetIsolate());
@@ -21068,6 +21129,95 @@ THREADED_TEST(JSONStringifyObjectWithGap) {
   ExpectString("JSON.stringify(obj, null,  '*')", *utf8);
 }
 
+namespace {
+class JSONTestOutputStream : public v8::OutputStream {
+ public:
+  explicit JSONTestOutputStream(int abort_after_chunks = -1)
+      : abort_after_chunks_(abort_after_chunks) {}
+
+  void EndOfStream() override { ended_ = true; }
+  int GetChunkSize() override { return 100; }
+  WriteResult WriteAsciiChunk(char* data, int size) override {
+    CHECK(!ended_);
+    CHECK_GT(size, 0);
+    CHECK_LE(size, GetChunkSize());
+    if (chunks_++ == abort_after_chunks_) return kAbort;
+    output_.append(data, size);
+    return kContinue;
+  }
+
+  const std::string& output() const { return output_; }
+  bool ended() const { return ended_; }
+
+ private:
+  const int abort_after_chunks_;
+  int chunks_ = 0;
+  bool ended_ = false;
+  std::string output_;
+};
+}  // namespace
+
+THREADED_TEST(JSONStringifyToStream) {
+  LocalContext context;
+  v8::Isolate* isolate = context->GetIsolate();
+  HandleScope scope(isolate);
+  const char* sources[] = {
+      "({x: 42, y: [1, 2.5, null, true], z: {'\\\"': '\\n\\u0001'}})",
+      "'\\u00e4\\u00f6\\u00fc'",
+      "'\\u2603\\ud83d\\ude00 \\ud800 \\udc00 x\\ud800'",
+      // Long enough to be written in several parts, with surrogate pairs at
+      // varying offsets relative to the part boundaries.
+      "'\\ud83d\\ude00a\\\"\\u00e4'.repeat(20000)",
+      "Array.from({length: 5000}, (_, i) => ({id: i, name: 'n' + i}))",
+      "Array.from({length: 5000}, (_, i) => '\\u2603'.repeat(i % 7))",
+  };
+  for (const char* source : sources) {
+    Local<Value> value = CompileRun(source);
+    for (Local<String> gap : {Local<String>(), v8_str("  ")}) {
+      v8::String::Utf8Value expected(
+          isolate,
+          v8::JSON::Stringify(context.local(), value, gap).ToLocalChecked());
+      JSONTestOutputStream stream;
+      CHECK(v8::JSON::StringifyToStream(context.local(), value, &stream, gap)
+                .FromJust());
+      CHECK(stream.ended());
+      CHECK_EQ(std::string(*expected, expected.length()), stream.output());
+    }
+  }
+
+  // Values that JSON.stringify maps to undefined produce no output.
+  {
+    JSONTestOutputStream stream;
+    CHECK(!v8::JSON::StringifyToStream(context.local(), CompileRun("(() => 1)"),
+                                       &stream)
+               .FromJust());
+    CHECK(!stream.ended());
+    CHECK(stream.output().empty());
+  }
+
+  // Aborting the stream stops the output.
+  {
+    JSONTestOutputStream stream(2);
+    CHECK(!v8::JSON::StringifyToStream(
+               context.local(), CompileRun("'x'.repeat(100000)"), &stream)
+               .FromJust());
+    CHECK(!stream.ended());
+    CHECK_EQ(size_t{200}, stream.output().size());
+  }
+
+  // Exceptions are propagated.
+  {
+    v8::TryCatch try_catch(isolate);
+    JSONTestOutputStream stream;
+    CHECK(v8::JSON::StringifyToStream(
+              context.local(),
+              CompileRun("var cycle = {}; cycle.self = cycle; cycle"), &stream)
+              .IsNothing());
+    CHECK(try_catch.HasCaught());
+    CHECK(!stream.ended());
+  }
+}
+
 #if V8_OS_POSIX
 class ThreadInterruptTest {
  public:
@@ -31,6 +31,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "include/v8-function.h"
@@ -1252,6 +1254,152 @@ TEST(HeapSnapshotJSONSerializationAborting) {
 
 namespace {
 
+class BinarySnapshotReader {
+ public:
+  explicit BinarySnapshotReader(v8::base::Vector<const char> data)
+      : data_(data) {}
+
+  bool done() const { return position_ == data_.size(); }
+
+  uint8_t ReadByte() {
+    CHECK_LT(position_, data_.size());
+    return static_cast<uint8_t>(data_[position_++]);
+  }
+
+  uint64_t ReadVarint() {
+    uint64_t result = 0;
+    for (int shift = 0;; shift += 7) {
+      uint8_t byte = ReadByte();
+      result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if (byte < 0x80) return result;
+    }
+  }
+
+  std::string ReadString() {
+    size_t length = static_cast<size_t>(ReadVarint());
+    CHECK_LE(position_ + length, data_.size());
+    std::string result(data_.begin() + position_, length);
+    position_ += length;
+    return result;
+  }
+
+ private:
+  v8::base::Vector<const char> data_;
+  size_t position_ = 0;
+};
+
+}  // namespace
+
+TEST(HeapSnapshotBinarySerialization) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  CompileRun(
+      "function A(s) { this.s = s; }\n"
+      "var a = new A('String \\u0101\\u8001');\n"
+      "var b = [a, 1.5];");
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+
+  v8::internal::TestJSONStream stream;
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(1, stream.eos_signaled());
+  v8::base::ScopedVector<char> data(stream.size());
+  stream.WriteTo(data);
+  BinarySnapshotReader reader(data);
+
+  for (char c : {'V', '8', 'H', 'S'}) {
+    CHECK_EQ(static_cast<uint8_t>(c), reader.ReadByte());
+  }
+  CHECK_EQ(1, reader.ReadByte());
+  const int node_count = static_cast<int>(reader.ReadVarint());
+  const uint64_t edge_count = reader.ReadVarint();
+  const uint64_t sample_count = reader.ReadVarint();
+  const uint64_t location_count = reader.ReadVarint();
+  CHECK_EQ(snapshot->GetNodesCount(), node_count);
+
+  std::vector<uint64_t> node_names;
+  uint64_t total_edge_count = 0;
+  uint64_t previous_id = 0;
+  for (int i = 0; i < node_count; i++) {
+    const v8::HeapGraphNode* node = snapshot->GetNode(i);
+    CHECK_EQ(static_cast<uint64_t>(node->GetType()), reader.ReadVarint());
+    node_names.push_back(reader.ReadVarint());
+    uint64_t id_delta = reader.ReadVarint();
+    uint64_t id = previous_id + ((id_delta >> 1) ^ (0 - (id_delta & 1)));
+    CHECK_EQ(node->GetId(), id);
+    previous_id = id;
+    CHECK_EQ(node->GetShallowSize(), reader.ReadVarint());
+    CHECK_EQ(static_cast<uint64_t>(node->GetChildrenCount()),
+             reader.ReadVarint());
+    total_edge_count += node->GetChildrenCount();
+    reader.ReadVarint();  // trace_node_id
+    reader.ReadVarint();  // detachedness
+  }
+  CHECK_EQ(total_edge_count, edge_count);
+
+  std::vector<std::pair<const v8::HeapGraphEdge*, uint64_t>> named_edges;
+  for (int i = 0; i < node_count; i++) {
+    const v8::HeapGraphNode* node = snapshot->GetNode(i);
+    for (int j = 0; j < node->GetChildrenCount(); j++) {
+      const v8::HeapGraphEdge* edge = node->GetChild(j);
+      CHECK_EQ(static_cast<uint64_t>(edge->GetType()), reader.ReadVarint());
+      uint64_t name_or_index = reader.ReadVarint();
+      if (edge->GetType() == v8::HeapGraphEdge::kElement ||
+          edge->GetType() == v8::HeapGraphEdge::kHidden) {
+        CHECK_EQ(static_cast<uint64_t>(
+                     edge->GetName()->Uint32Value(env.local()).FromJust()),
+                 name_or_index);
+      } else {
+        named_edges.emplace_back(edge, name_or_index);
+      }
+      int to_node = static_cast<int>(reader.ReadVarint());
+      CHECK_LT(to_node, node_count);
+      CHECK_EQ(edge->GetToNode()->GetId(), snapshot->GetNode(to_node)->GetId());
+    }
+  }
+
+  for (uint64_t i = 0; i < 2 * sample_count + 4 * location_count; i++) {
+    reader.ReadVarint();
+  }
+
+  std::vector<std::string> strings(reader.ReadVarint());
+  for (std::string& string : strings) string = reader.ReadString();
+  CHECK(reader.done());
+
+  bool found_string = false;
+  for (int i = 0; i < node_count; i++) {
+    CHECK_LE(1, node_names[i]);
+    CHECK_LE(node_names[i], strings.size());
+    const std::string& name = strings[node_names[i] - 1];
+    CHECK_EQ(name, std::string(GetName(snapshot->GetNode(i))));
+    if (name == "String \u0101\u8001") found_string = true;
+  }
+  CHECK(found_string);
+  for (auto [edge, name] : named_edges) {
+    CHECK_LE(1, name);
+    CHECK_LE(name, strings.size());
+    CHECK_EQ(strings[name - 1],
+             std::string(*v8::String::Utf8Value(env->GetIsolate(),
+                                                edge->GetName())));
+  }
+}
+
+TEST(HeapSnapshotBinarySerializationAborting) {
+  LocalContext env;
+  v8::HandleScope scope(env->GetIsolate());
+  v8::HeapProfiler* heap_profiler = env->GetIsolate()->GetHeapProfiler();
+  const v8::HeapSnapshot* snapshot = heap_profiler->TakeHeapSnapshot();
+  CHECK(ValidateSnapshot(snapshot));
+  v8::internal::TestJSONStream stream(5);
+  snapshot->Serialize(&stream, v8::HeapSnapshot::kBinary);
+  CHECK_GT(stream.size(), 0);
+  CHECK_EQ(0, stream.eos_signaled());
+}
+
+namespace {
+
 class TestStatsStream : public v8::OutputStream {
  public:
   TestStatsStream()
@@ -46,11 +46,13 @@
 #include "src/debug/debug-coverage.h"
 #include "src/heap/heap-inl.h"
 #include "src/heap/parked-scope-inl.h"
+#include "src/heap/pretenuring-handler.h"
 #include "src/heap/read-only-heap.h"
 #include "src/heap/read-only-promotion.h"
 #include "src/heap/safepoint.h"
 #include "src/heap/spaces.h"
 #include "src/numbers/hash-seed-inl.h"
+#include "src/objects/feedback-vector-inl.h"
 #include "src/objects/js-array-buffer-inl.h"
 #include "src/objects/js-regexp-inl.h"
 #include "src/objects/objects-inl.h"
@@ -797,6 +799,55 @@ UNINITIALIZED_TEST(CustomSnapshotDataBlob1) {
   FreeCurrentEmbeddedBlob();
 }
 
+UNINITIALIZED_TEST(CustomSnapshotDataBlobMappedReadOnlySpace) {
+  if (!V8_STATIC_ROOTS_BOOL) return;
+  DisableAlwaysOpt();
+  v8_flags.page_aligned_read_only_snapshot = true;
+  v8_flags.map_read_only_space_from_snapshot = true;
+  const char* source = "function f() { return 42; }";
+
+  DisableEmbeddedBlobRefcounting();
+  v8::StartupData data = CreateSnapshotDataBlob(source);
+
+  // Back the blob by a file, as it would be for an external startup blob, so
+  // that the read-only space can be mapped from it.
+  const char* kBlobFileName = "mapped-read-only-space.bin";
+  std::unique_ptr<base::OS::MemoryMappedFile> file(
+      base::OS::MemoryMappedFile::create(kBlobFileName, data.raw_size,
+                                         const_cast<char*>(data.data)));
+  CHECK_NOT_NULL(file);
+  v8::StartupData mapped_data = {static_cast<const char*>(file->memory()),
+                                 data.raw_size};
+
+  v8::Isolate::CreateParams params;
+  params.snapshot_blob = &mapped_data;
+  params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate = TestSerializer::NewIsolate(params);
+  {
+    v8::Isolate::Scope i_scope(isolate);
+    v8::HandleScope h_scope(isolate);
+    v8::Local<v8::Context> context = v8::Context::New(isolate);
+    v8::Context::Scope c_scope(context);
+    v8::Maybe<int32_t> result =
+        CompileRun("f()")->Int32Value(isolate->GetCurrentContext());
+    CHECK_EQ(42, result.FromJust());
+    CHECK(CompileRun("typeof undefined === 'undefined'")->IsTrue());
+    size_t mapped_bytes = reinterpret_cast<Isolate*>(isolate)
+                              ->read_only_heap()
+                              ->mapped_snapshot_bytes();
+    if (base::OS::IsRemapPageSupported()) {
+      CHECK_GT(mapped_bytes, 0);
+    } else {
+      CHECK_EQ(0, mapped_bytes);
+    }
+  }
+  isolate->Dispose();
+  file.reset();
+  remove(kBlobFileName);
+  delete[] data.data;
+  FreeCurrentEmbeddedBlob();
+}
+
 static void UnreachableCallback(const FunctionCallbackInfo<Value>& info) {
   UNREACHABLE();
 }
@@ -3106,6 +3157,91 @@ TEST(CodeSerializerFlagChange) {
   isolate2->Dispose();
 }
 
+static Tagged<AllocationSite> GetLiteralSite(v8::Local<v8::Context> context,
+                                             const char* name) {
+  Tagged<JSFunction> function =
+      Cast<JSFunction>(*v8::Utils::OpenDirectHandle(
+          *context->Global()->Get(context, v8_str(name)).ToLocalChecked()));
+  Tagged<FeedbackVector> vector = function->feedback_vector();
+  FeedbackMetadataIterator iter(vector->metadata());
+  while (iter.HasNext()) {
+    FeedbackSlot slot = iter.Next();
+    if (iter.kind() != FeedbackSlotKind::kLiteral) continue;
+    return Cast<AllocationSite>(vector->Get(slot).GetHeapObjectAssumeStrong());
+  }
+  UNREACHABLE();
+}
+
+TEST(CodeSerializerPretenuringDecisions) {
+  v8_flags.cache_pretenuring_decisions = true;
+  v8_flags.lazy_feedback_allocation = false;
+  FlagList::EnforceFlagImplications();
+  // The literal contains an array, so its site is created on the first call.
+  const char* js_source =
+      "function f() { return {a: 1, b: [1, 2]}; };"
+      "function g() { return {a: 1, b: [1, 2]}; };"
+      "f(); g();";
+
+  v8::ScriptCompiler::CachedData* cache;
+  v8::Isolate::CreateParams create_params;
+  create_params.array_buffer_allocator = CcTest::array_buffer_allocator();
+  v8::Isolate* isolate1 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate1);
+    v8::HandleScope scope(isolate1);
+    v8::Local<v8::Context> context = v8::Context::New(isolate1);
+    v8::Context::Scope context_scope(context);
+
+    v8::ScriptCompiler::Source source(v8_str(js_source),
+                                      v8::ScriptOrigin(v8_str("test")));
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(isolate1, &source)
+            .ToLocalChecked();
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    // Pretend that only the site in f() and the nested array site in g()
+    // were found to be long-lived.
+    GetLiteralSite(context, "f")->set_pretenure_decision(
+        AllocationSite::kTenure);
+    Cast<AllocationSite>(GetLiteralSite(context, "g")->nested_site())
+        ->set_pretenure_decision(AllocationSite::kTenure);
+    cache = ScriptCompiler::CreateCodeCache(script);
+  }
+  isolate1->Dispose();
+
+  v8::Isolate* isolate2 = v8::Isolate::New(create_params);
+  {
+    v8::Isolate::Scope iscope(isolate2);
+    v8::HandleScope scope(isolate2);
+    v8::Local<v8::Context> context = v8::Context::New(isolate2);
+    v8::Context::Scope context_scope(context);
+    PretenuringHandler* pretenuring_handler =
+        reinterpret_cast<Isolate*>(isolate2)->heap()->pretenuring_handler();
+
+    v8::ScriptCompiler::Source source(v8_str(js_source),
+                                      v8::ScriptOrigin(v8_str("test")), cache);
+    v8::Local<v8::UnboundScript> script =
+        v8::ScriptCompiler::CompileUnboundScript(
+            isolate2, &source, v8::ScriptCompiler::kConsumeCodeCache)
+            .ToLocalChecked();
+    CHECK(!cache->rejected);
+    CHECK(pretenuring_handler->HasImportedPretenuringDecisions());
+
+    script->BindToCurrentContext()->Run(context).ToLocalChecked();
+    CHECK_EQ(AllocationType::kOld,
+             GetLiteralSite(context, "f")->GetAllocationType());
+    CHECK_EQ(AllocationType::kYoung,
+             Cast<AllocationSite>(GetLiteralSite(context, "f")->nested_site())
+                 ->GetAllocationType());
+    CHECK_EQ(AllocationType::kYoung,
+             GetLiteralSite(context, "g")->GetAllocationType());
+    CHECK_EQ(AllocationType::kOld,
+             Cast<AllocationSite>(GetLiteralSite(context, "g")->nested_site())
+                 ->GetAllocationType());
+    CHECK(!pretenuring_handler->HasImportedPretenuringDecisions());
+  }
+  isolate2->Dispose();
+}
+
 TEST(CachedDataCompatibilityCheck) {
   {
     v8::Isolate::CreateParams create_params;
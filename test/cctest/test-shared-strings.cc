@@ -2459,6 +2459,151 @@ UNINITIALIZED_TEST(SharedObjectRetainedByClientRememberedSet) {
   thread.Join();
 }
 
+class ClientIsolateThreadForIncrementalClientMarking
+    : public v8::base::Thread {
+ public:
+  // Expects a ManualGCScope to be in scope while `Run()` is executed.
+  ClientIsolateThreadForIncrementalClientMarking(const char* name,
+                                                 MultiClientIsolateTest* test,
+                                                 const ManualGCScope& witness)
+      : v8::base::Thread(base::Thread::Options(name)), test_(test) {}
+
+  void Run() override {
+    client_isolate_ = test_->NewClientIsolate();
+    Isolate* i_client = reinterpret_cast<Isolate*>(client_isolate_);
+    Factory* factory = i_client->factory();
+    Heap* heap = i_client->heap();
+
+    {
+      v8::Isolate::Scope isolate_scope(client_isolate_);
+      HandleScope handle_scope(i_client);
+
+      // The shared string is only referenced from an old object, i.e. through
+      // an OLD_TO_SHARED slot.
+      DirectHandle<FixedArray> old_object =
+          factory->NewFixedArray(1, AllocationType::kOld);
+      {
+        HandleScope inner_scope(i_client);
+        DirectHandle<String> shared_string =
+            factory->NewStringFromAsciiChecked("foo",
+                                               AllocationType::kSharedOld);
+        CHECK(heap->SharedHeapContains(*shared_string));
+        old_object->set(0, *shared_string);
+      }
+      ObjectSlot slot = old_object->RawFieldOfFirstElement();
+      CHECK(RememberedSet<OLD_TO_SHARED>::Contains(
+          MutablePageMetadata::FromHeapObject(*old_object), slot.address()));
+
+      // Inform the main isolate that it can start shared marking.
+      V8::GetCurrentPlatform()
+          ->GetForegroundTaskRunner(test_->main_isolate())
+          ->PostTask(std::make_unique<WakeupTask>(
+              test_->i_main_isolate(), test_->main_isolate_wakeup_counter()));
+
+      // The shared string gets marked by the client marking task, without the
+      // shared heap reaching its atomic pause.
+      Tagged<HeapObject> shared_string = Cast<HeapObject>(old_object->get(0));
+      while (!heap->marking_state()->IsMarked(shared_string)) {
+        v8::platform::PumpMessageLoop(
+            i::V8::GetCurrentPlatform(), client_isolate_,
+            v8::platform::MessageLoopBehavior::kWaitForWork);
+      }
+
+      V8::GetCurrentPlatform()
+          ->GetForegroundTaskRunner(test_->main_isolate())
+          ->PostTask(std::make_unique<WakeupTask>(
+              test_->i_main_isolate(), test_->main_isolate_wakeup_counter()));
+
+      // Wait for the shared GC to finish.
+      while (wakeup_counter_ < 1) {
+        v8::platform::PumpMessageLoop(
+            i::V8::GetCurrentPlatform(), client_isolate_,
+            v8::platform::MessageLoopBehavior::kWaitForWork);
+      }
+
+      Tagged<String> string = Cast<String>(old_object->get(0));
+      CHECK(heap->SharedHeapContains(string));
+      CHECK(string->IsOneByteEqualTo(base::StaticCharVector("foo")));
+    }
+
+    client_isolate_->Dispose();
+
+    V8::GetCurrentPlatform()
+        ->GetForegroundTaskRunner(test_->main_isolate())
+        ->PostTask(std::make_unique<WakeupTask>(
+            test_->i_main_isolate(), test_->main_isolate_wakeup_counter()));
+  }
+
+  v8::Isolate* isolate() const {
+    DCHECK_NOT_NULL(client_isolate_);
+    return client_isolate_;
+  }
+
+  int& wakeup_counter() { return wakeup_counter_; }
+
+ private:
+  MultiClientIsolateTest* test_;
+  v8::Isolate* client_isolate_;
+  int wakeup_counter_ = 0;
+};
+
+UNINITIALIZED_TEST(IncrementalClientMarking) {
+  if (v8_flags.single_generation) return;
+  if (!V8_CAN_CREATE_SHARED_HEAP_BOOL) return;
+  if (!v8_flags.incremental_marking) return;
+
+  v8_flags.shared_string_table = true;
+  v8_flags.incremental_client_marking = true;
+  // Prevent the incremental GC from finalizing in a task.
+  v8_flags.incremental_marking_task = false;
+  ManualGCScope manual_gc_scope;
+
+  MultiClientIsolateTest test;
+
+  Isolate* i_isolate = test.i_main_isolate();
+  Isolate* shared_isolate = i_isolate->shared_space_isolate();
+  Heap* shared_heap = shared_isolate->heap();
+
+  ClientIsolateThreadForIncrementalClientMarking thread("worker", &test,
+                                                        manual_gc_scope);
+  CHECK(thread.Start());
+
+  // Wait for the client isolate to set up its OLD_TO_SHARED slot.
+  while (test.main_isolate_wakeup_counter() < 1) {
+    v8::platform::PumpMessageLoop(
+        i::V8::GetCurrentPlatform(), test.main_isolate(),
+        v8::platform::MessageLoopBehavior::kWaitForWork);
+  }
+
+  shared_heap->StartIncrementalMarking(GCFlag::kNoFlags,
+                                       GarbageCollectionReason::kTesting);
+  CHECK(shared_heap->incremental_marking()->IsMajorMarking());
+
+  // Wait for the client isolate to observe its shared string being marked.
+  while (test.main_isolate_wakeup_counter() < 2) {
+    v8::platform::PumpMessageLoop(
+        i::V8::GetCurrentPlatform(), test.main_isolate(),
+        v8::platform::MessageLoopBehavior::kWaitForWork);
+  }
+
+  heap::InvokeMajorGC(shared_heap);
+
+  // Inform client that shared GC is finished.
+  V8::GetCurrentPlatform()
+      ->GetForegroundTaskRunner(thread.isolate())
+      ->PostTask(std::make_unique<WakeupTask>(
+          reinterpret_cast<Isolate*>(thread.isolate()),
+          thread.wakeup_counter()));
+
+  while (test.main_isolate_wakeup_counter() < 3) {
+    v8::platform::PumpMessageLoop(
+        i::V8::GetCurrentPlatform(), test.main_isolate(),
+        v8::platform::MessageLoopBehavior::kWaitForWork);
+  }
+
+  thread.Join();
+}
+
 class Regress1424955ClientIsolateThread : public v8::base::Thread {
  public:
   Regress1424955ClientIsolateThread(const char* name,
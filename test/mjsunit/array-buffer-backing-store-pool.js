@@ -0,0 +1,54 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --pool-array-buffer-backing-stores --expose-gc
+// Flags: --array-buffer-pool-resident-size=1048576
+
+// Backing stores that are reused from the pool must read as zero, for every
+// size class and also after their pages were discarded.
+const kSizes = [64 * 1024, 65 * 1024, 100 * 1024, 200 * 1024, 511 * 1024,
+                1024 * 1024];
+
+function fillAndDrop() {
+  for (let size of kSizes) {
+    for (let i = 0; i < 4; i++) {
+      const array = new Uint8Array(new ArrayBuffer(size));
+      array.fill(0xab);
+    }
+  }
+}
+
+function checkZero(array) {
+  for (let i = 0; i < array.length; i += 997) assertEquals(0, array[i]);
+  assertEquals(0, array[array.length - 1]);
+}
+
+for (let round = 0; round < 3; round++) {
+  fillAndDrop();
+  gc();
+  gc();
+  for (let size of kSizes) {
+    const array = new Uint8Array(new ArrayBuffer(size));
+    assertEquals(size, array.length);
+    checkZero(array);
+    array.fill(round + 1);
+  }
+}
+
+// Buffers outside of the pooled range are unaffected.
+(() => {
+  const small = new Uint8Array(new ArrayBuffer(1024));
+  const large = new Uint8Array(new ArrayBuffer(2 * 1024 * 1024));
+  checkZero(small);
+  checkZero(large);
+})();
+
+// Pooled buffers can be resized by transferring them.
+(() => {
+  const array = new Uint8Array(new ArrayBuffer(128 * 1024));
+  array.fill(7);
+  const transferred = new Uint8Array(array.buffer.transfer(256 * 1024));
+  assertEquals(7, transferred[128 * 1024 - 1]);
+  assertEquals(0, transferred[128 * 1024]);
+})();
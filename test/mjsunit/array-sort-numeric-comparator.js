@@ -0,0 +1,86 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Sorting packed Smi and double arrays with (a, b) => a - b and (a, b) =>
+// b - a is done natively; the results have to match the generic sort.
+
+function ascending(a, b) { return a - b; }
+function descending(a, b) { return b - a; }
+
+function reference(array, comparefn) {
+  // Holey copies always take the generic path.
+  const copy = [, ...array];
+  copy.shift();
+  return copy.sort(comparefn);
+}
+
+function check(array, comparefn) {
+  const expected = reference(array, comparefn);
+  assertSame(array, array.sort(comparefn));
+  assertEquals(expected.length, array.length);
+  for (let i = 0; i < array.length; i++) assertSame(expected[i], array[i]);
+}
+
+let seed = 42;
+function random() {
+  seed = (seed * 1103515245 + 12345) % 2147483648;
+  return seed / 2147483648;
+}
+
+for (let length of [2, 3, 10, 100, 1000]) {
+  for (let comparefn of [ascending, descending, (a, b) => a - b,
+                         (a, b) => b - a, function(x, y) { return x - y; }]) {
+    const smis = [];
+    for (let i = 0; i < length; i++) {
+      smis.push(Math.floor(random() * 200) - 100);
+    }
+    check(smis, comparefn);
+
+    const doubles = [];
+    for (let i = 0; i < length; i++) doubles.push((random() - 0.5) * 1e3);
+    check(doubles, comparefn);
+  }
+}
+
+// -0 and +0 compare equal and keep their relative order.
+(() => {
+  const array = [0.5, -0, 0, -0, 0, -0.5, 0, -0];
+  array.sort(ascending);
+  assertEquals([-0.5, -0, 0, -0, 0, 0, -0, 0.5], array);
+  assertTrue(Object.is(array[1], -0));
+  assertTrue(Object.is(array[2], 0));
+  assertTrue(Object.is(array[3], -0));
+  assertTrue(Object.is(array[6], -0));
+})();
+
+// Infinities sort like any other number.
+check([Infinity, 1.5, -Infinity, 0.25, -1.5], ascending);
+check([Infinity, 1.5, -Infinity, 0.25, -1.5], descending);
+
+// Arrays with NaN fall back to the generic sort.
+check([3.5, NaN, 1.5, NaN, -2.5, 0.5], ascending);
+check([3.5, NaN, 1.5, NaN, -2.5, 0.5], descending);
+
+// Comparators that merely look similar are called as usual.
+(() => {
+  let calls = 0;
+  const array = [3, 1, 2];
+  array.sort((a, b) => { calls++; return a - b; });
+  assertEquals([1, 2, 3], array);
+  assertTrue(calls > 0);
+
+  check([3, 1, 2, 5, 4], (a, b) => a - b + 0);
+  check([3, 1, 2, 5, 4], (a, b) => a - a);
+  check([3, 1, 2, 5, 4], (a, b, c) => b - c || a - b);
+  check([3, 1, 2, 5, 4], (a, b) => a + b);
+
+  const objects = [{x: 2}, {x: 1}, {x: 3}];
+  objects.sort((a, b) => a.x - b.x);
+  assertEquals([1, 2, 3], objects.map(o => o.x));
+})();
+
+// Other elements kinds use the generic sort with the same comparators.
+check([3, 1, "2", 5, 4], ascending);
+check([3, 1, , 5, 4], descending);
+check([3, {valueOf() { return 0; }}, 2], ascending);
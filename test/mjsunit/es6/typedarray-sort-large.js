@@ -0,0 +1,89 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --js-float16array
+
+// Arrays that are long enough to be radix sorted, compared against sorting
+// with a comparator that implements the default order.
+
+function compareDefault(x, y) {
+  if (x !== x) return y !== y ? 0 : 1;
+  if (y !== y) return -1;
+  if (x < y) return -1;
+  if (x > y) return 1;
+  if (x === 0 && y === 0) {
+    return Object.is(x, -0) ? (Object.is(y, -0) ? 0 : -1)
+                            : (Object.is(y, -0) ? 1 : 0);
+  }
+  return 0;
+}
+
+let seed = 17;
+function random() {
+  seed = (seed * 1103515245 + 12345) % 2147483648;
+  return seed / 2147483648;
+}
+
+function randomFloat() {
+  switch (Math.floor(random() * 10)) {
+    case 0: return NaN;
+    case 1: return -0;
+    case 2: return 0;
+    case 3: return -Infinity;
+    case 4: return Infinity;
+    default: return (random() - 0.5) * Math.pow(2, random() * 40 - 20);
+  }
+}
+
+function randomInteger(bits) {
+  const value = Math.floor(random() * Math.pow(2, bits));
+  return value - Math.pow(2, bits - 1);
+}
+
+function check(constructor, fill, length) {
+  const array = new constructor(length);
+  for (let i = 0; i < length; i++) array[i] = fill(i);
+  const expected = array.slice().sort(compareDefault);
+  assertSame(array, array.sort());
+  for (let i = 0; i < length; i++) assertSame(expected[i], array[i]);
+}
+
+for (let length of [511, 512, 513, 5000]) {
+  for (let constructor of [Float16Array, Float32Array, Float64Array]) {
+    check(constructor, randomFloat, length);
+  }
+  for (let [constructor, bits] of [
+           [Int8Array, 8], [Uint8Array, 8], [Uint8ClampedArray, 8],
+           [Int16Array, 16], [Uint16Array, 16], [Int32Array, 32],
+           [Uint32Array, 32]]) {
+    check(constructor, () => randomInteger(bits), length);
+    // Small values, for which the passes over the high bytes are skipped.
+    check(constructor, () => randomInteger(7), length);
+  }
+  for (let constructor of [BigInt64Array, BigUint64Array]) {
+    check(constructor, () => BigInt(randomInteger(32)) << 31n, length);
+  }
+}
+
+// Sorting in place leaves the elements outside of the view alone.
+(() => {
+  const buffer = new ArrayBuffer(8 * 1002);
+  const outer = new Float64Array(buffer);
+  outer[0] = 3;
+  outer[1001] = -3;
+  const array = new Float64Array(buffer, 8, 1000);
+  for (let i = 0; i < array.length; i++) array[i] = array.length - i;
+  array.sort();
+  for (let i = 0; i < array.length; i++) assertEquals(i + 1, array[i]);
+  assertEquals(3, outer[0]);
+  assertEquals(-3, outer[1001]);
+})();
+
+// SharedArrayBuffers are sorted as well.
+(() => {
+  const array = new Int32Array(new SharedArrayBuffer(4 * 2000));
+  for (let i = 0; i < array.length; i++) array[i] = (i * 7919) % 2000 - 1000;
+  array.sort();
+  for (let i = 0; i < array.length; i++) assertEquals(i - 1000, array[i]);
+})();
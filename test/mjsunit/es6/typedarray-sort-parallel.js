@@ -0,0 +1,35 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --parallel-typed-array-sort
+
+// Large enough to be split into several chunks.
+const kLength = 1 << 21;
+
+(() => {
+  const array = new Float64Array(kLength);
+  for (let i = 0; i < kLength; i++) {
+    array[i] = i % 3 == 0 ? -i : i % 1001 == 0 ? NaN : i % 1003 == 0 ? -0 : i;
+  }
+  array.sort();
+  for (let i = 1; i < kLength; i++) {
+    const previous = array[i - 1];
+    const current = array[i];
+    if (Number.isNaN(current)) continue;
+    assertFalse(Number.isNaN(previous));
+    assertTrue(previous < current ||
+               (previous === current &&
+                !(Object.is(previous, 0) && Object.is(current, -0))));
+  }
+  assertTrue(Number.isNaN(array[kLength - 1]));
+})();
+
+(() => {
+  const array = new Int32Array(kLength);
+  for (let i = 0; i < kLength; i++) {
+    array[i] = (i * 7919) % kLength - kLength / 2;
+  }
+  array.sort();
+  for (let i = 0; i < kLength; i++) assertEquals(i - kLength / 2, array[i]);
+})();
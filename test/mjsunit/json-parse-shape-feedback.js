@@ -0,0 +1,75 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --allow-natives-syntax
+
+// Arrays of objects with the same keys reuse the map of the previous object,
+// including for nested objects.
+(function TestRows() {
+  const rows = JSON.parse(
+      '[{"id":1,"name":"a","pos":{"x":1,"y":2}},' +
+      ' {"id":2,"name":"b","pos":{"x":3,"y":4}},' +
+      ' {"id":3,"name":"c","pos":{"x":5,"y":6}}]');
+  assertEquals(3, rows.length);
+  for (let i = 0; i < rows.length; i++) {
+    assertEquals(i + 1, rows[i].id);
+    assertEquals(2 * i + 1, rows[i].pos.x);
+    assertEquals(2 * i + 2, rows[i].pos.y);
+    assertSame(Object.prototype, Object.getPrototypeOf(rows[i].pos));
+  }
+  assertEquals(['a', 'b', 'c'], rows.map(row => row.name));
+  assertTrue(%HaveSameMap(rows[0], rows[2]));
+  assertTrue(%HaveSameMap(rows[0].pos, rows[2].pos));
+})();
+
+// Keys that only share a prefix with the previous object's keys.
+(function TestPrefixKeys() {
+  assertEquals([{ab: 1}, {a: 2, b: 3}],
+               JSON.parse('[{"ab":1},{"a":2,"b":3}]'));
+  assertEquals([{a: 1}, {ab: 2}], JSON.parse('[{"a":1},{"ab":2}]'));
+  assertEquals([{a: 1, b: 2}, {a: 3}, {a: 4, c: 5}],
+               JSON.parse('[{"a":1,"b":2},{"a":3},{"a":4,"c":5}]'));
+  assertEquals([{a: 1, b: 2}, {b: 3, a: 4}],
+               JSON.parse('[{"a":1,"b":2},{"b":3,"a":4}]'));
+})();
+
+// The previous object's keys may contain characters that must be escaped.
+(function TestEscapedKeys() {
+  const rows = JSON.parse('[{"a\\"b":1},{"a\\"b":2}]');
+  assertEquals([1, 2], rows.map(row => row['a"b']));
+  assertThrows(() => JSON.parse('[{"a\\"b":1},{"a"b":2}]'), SyntaxError);
+  assertThrows(() => JSON.parse('[{"a\\nb":1},{"a\nb":2}]'), SyntaxError);
+})();
+
+// Duplicate and array index keys.
+(function TestDuplicateAndIndexKeys() {
+  assertEquals([{a: 1, 0: 2}, {a: 3, 0: 4}],
+               JSON.parse('[{"a":1,"0":2},{"a":3,"0":4}]'));
+  assertEquals([{a: 1, b: 2}, {a: 4, b: 3}],
+               JSON.parse('[{"a":1,"b":2},{"a":3,"b":3,"a":4}]'));
+  assertEquals([{0: 1}, {0: 2, a: 3}],
+               JSON.parse('[{"0":1},{"0":2,"a":3}]'));
+})();
+
+// Field representations change along the way.
+(function TestRepresentationChanges() {
+  const rows = JSON.parse(
+      '[{"a":1,"b":{"c":1}},{"a":1.5,"b":{"c":"x"}},' +
+      ' {"a":"s","b":{"c":null}},{"a":[],"b":[1]}]');
+  assertEquals([1, 1.5, 's', []], rows.map(row => row.a));
+  assertEquals([1, 'x', null], rows.slice(0, 3).map(row => row.b.c));
+  assertEquals([1], rows[3].b);
+})();
+
+// Objects created by JS code share maps with parsed objects, but parsed
+// objects always get Object.prototype.
+(function TestPrototypes() {
+  class C {}
+  const literal = {p: new C()};
+  const rows = JSON.parse('[{"p":{}},{"p":{}},{"p":{"q":1}}]');
+  for (const row of rows) {
+    assertSame(Object.prototype, Object.getPrototypeOf(row.p));
+  }
+  assertInstanceof(literal.p, C);
+})();
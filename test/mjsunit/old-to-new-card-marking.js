@@ -0,0 +1,44 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --old-to-new-card-marking --expose-gc --verify-heap
+
+// Large arrays in old space record stores of young objects in a card table.
+// The young objects need to survive scavenges and be updated in place.
+
+const kLength = 200000;
+const array = new Array(kLength).fill(0);
+// Move the array to old space.
+gc();
+gc();
+
+function store(index) {
+  array[index] = {index};
+}
+
+for (let round = 0; round < 4; round++) {
+  // Several stores per card, stores to distant cards, and the last element.
+  for (let i = 0; i < 64; i++) store(i);
+  for (let i = 1000; i < kLength; i += 4099) store(i);
+  store(kLength - 1);
+  gc({type: 'minor'});
+  gc({type: 'minor'});
+  for (let i = 0; i < 64; i++) assertEquals(i, array[i].index);
+  for (let i = 1000; i < kLength; i += 4099) assertEquals(i, array[i].index);
+  assertEquals(kLength - 1, array[kLength - 1].index);
+}
+
+// Stores that are overwritten with Smis before the next GC.
+for (let i = 0; i < kLength; i += 997) store(i);
+for (let i = 0; i < kLength; i += 997) array[i] = i;
+gc({type: 'minor'});
+for (let i = 0; i < kLength; i += 997) assertEquals(i, array[i]);
+
+// Trimming the array drops cards beyond its end.
+for (let i = kLength - 100; i < kLength; i++) store(i);
+array.length = kLength - 200;
+gc({type: 'minor'});
+gc();
+assertEquals(kLength - 200, array.length);
+assertEquals(0, array[0]);
@@ -0,0 +1,49 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Flags: --segregate-small-old-objects --expose-gc --verify-heap
+
+// Promotes interleaved objects of many different small sizes, which end up in
+// separate per-size-class allocation areas, and checks they survive intact.
+const kCount = 20000;
+
+function makeObjects() {
+  const objects = [];
+  for (let i = 0; i < kCount; i++) {
+    switch (i % 5) {
+      case 0: objects.push(i + 0.5); break;
+      case 1: objects.push([i]); break;
+      case 2: objects.push({a: i, b: i + 1}); break;
+      case 3: objects.push(new Array(i % 13).fill(i)); break;
+      case 4: objects.push(() => i); break;
+    }
+  }
+  return objects;
+}
+
+function check(objects) {
+  for (let i = 0; i < kCount; i++) {
+    const object = objects[i];
+    switch (i % 5) {
+      case 0: assertEquals(i + 0.5, object); break;
+      case 1: assertEquals([i], object); break;
+      case 2: assertEquals({a: i, b: i + 1}, object); break;
+      case 3: assertEquals(new Array(i % 13).fill(i), object); break;
+      case 4: assertEquals(i, object()); break;
+    }
+  }
+}
+
+const objects = makeObjects();
+gc({type: 'minor'});
+gc({type: 'minor'});
+check(objects);
+// Drop every other object to leave holes in the size class areas.
+for (let i = 0; i < kCount; i += 2) objects[i] = undefined;
+gc();
+const fresh = makeObjects();
+for (let i = 0; i < kCount; i += 2) objects[i] = fresh[i];
+gc();
+gc();
+check(objects);
@@ -0,0 +1,73 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Compares the vectorized substring search against a naive reference, for
+// patterns whose first and last characters occur all over the subject.
+function naiveIndexOf(subject, pattern, from) {
+  outer: for (let i = Math.max(from, 0);
+              i <= subject.length - pattern.length; i++) {
+    for (let j = 0; j < pattern.length; j++) {
+      if (subject[j + i] !== pattern[j]) continue outer;
+    }
+    return i;
+  }
+  return -1;
+}
+
+function naiveCount(subject, pattern) {
+  let count = 0;
+  for (let i = naiveIndexOf(subject, pattern, 0); i != -1;
+       i = naiveIndexOf(subject, pattern, i + pattern.length)) {
+    count++;
+  }
+  return count;
+}
+
+function check(subject, pattern) {
+  for (let from of [0, 1, 15, 16, 17, subject.length >> 1]) {
+    assertEquals(naiveIndexOf(subject, pattern, from),
+                 subject.indexOf(pattern, from));
+  }
+  assertEquals(naiveIndexOf(subject, pattern, 0) != -1,
+               subject.includes(pattern));
+  const count = naiveCount(subject, pattern);
+  assertEquals(count + 1, subject.split(pattern).length);
+  assertEquals(subject.length + count * (1 - pattern.length),
+               subject.replaceAll(pattern, "#").length);
+}
+
+// A pattern at every position around the block boundaries.
+(() => {
+  for (let pattern_length = 2; pattern_length <= 33; pattern_length++) {
+    let pattern = "a";
+    for (let i = 1; i < pattern_length - 1; i++) pattern += "bc"[i % 2];
+    pattern += "a";
+    for (let position = 0; position < 70; position++) {
+      const subject = "a".repeat(position) + pattern + "x".repeat(40);
+      check(subject, pattern);
+      check(subject + "☃", pattern);
+    }
+  }
+})();
+
+// Candidates that match on the first and last character only.
+(() => {
+  const pattern = "ab_______ba";
+  const subject = ("ab____x__ba" + "a").repeat(200) + pattern;
+  check(subject, pattern);
+  check("☃" + subject, pattern);
+  check(subject, "☃" + pattern);
+  check(subject, pattern + "☃");
+})();
+
+// Repetitive subjects, which make the search switch to Boyer-Moore-Horspool.
+(() => {
+  const subject = "a".repeat(5000) + "b" + "a".repeat(100);
+  for (let pattern_length = 2; pattern_length <= 32; pattern_length++) {
+    check(subject, "a".repeat(pattern_length - 1) + "b");
+    check(subject, "a".repeat(pattern_length - 1) + "c");
+    check(subject, "b" + "a".repeat(pattern_length - 1));
+    check(subject + "☃", "a".repeat(pattern_length - 1) + "b");
+  }
+})();
@@ -0,0 +1,77 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/card-table.h"
+
+#include <utility>
+#include <vector>
+
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+std::vector<std::pair<size_t, size_t>> DirtyCards(CardTable* card_table,
+                                                  size_t size) {
+  std::vector<std::pair<size_t, size_t>> cards;
+  card_table->IterateAndClear(size, [&cards](size_t start, size_t end) {
+    cards.emplace_back(start, end);
+  });
+  return cards;
+}
+
+}  // namespace
+
+TEST(CardTable, CardsForSize) {
+  EXPECT_EQ(0u, CardTable::CardsForSize(0));
+  EXPECT_EQ(1u, CardTable::CardsForSize(1));
+  EXPECT_EQ(1u, CardTable::CardsForSize(CardTable::kCardSize));
+  EXPECT_EQ(2u, CardTable::CardsForSize(CardTable::kCardSize + 1));
+}
+
+TEST(CardTable, MarkAndIterate) {
+  const size_t size = 100 * CardTable::kCardSize + kTaggedSize;
+  CardTable* card_table = CardTable::Allocate(size);
+  EXPECT_TRUE(card_table->IsClean(size));
+
+  card_table->Mark(0);
+  card_table->Mark(kTaggedSize);
+  card_table->Mark(17 * CardTable::kCardSize + 3 * kTaggedSize);
+  card_table->Mark(size - kTaggedSize);
+  EXPECT_FALSE(card_table->IsClean(size));
+  EXPECT_TRUE(card_table->IsDirty(CardTable::kCardSize - kTaggedSize));
+  EXPECT_FALSE(card_table->IsDirty(CardTable::kCardSize));
+
+  std::vector<std::pair<size_t, size_t>> expected = {
+      {0, CardTable::kCardSize},
+      {17 * CardTable::kCardSize, 18 * CardTable::kCardSize},
+      {100 * CardTable::kCardSize, 101 * CardTable::kCardSize}};
+  EXPECT_EQ(expected, DirtyCards(card_table, size));
+  // Iterating cleans the cards.
+  EXPECT_TRUE(card_table->IsClean(size));
+  EXPECT_TRUE(DirtyCards(card_table, size).empty());
+
+  CardTable::Delete(card_table);
+}
+
+TEST(CardTable, AllCardsDirty) {
+  const size_t size = 37 * CardTable::kCardSize;
+  CardTable* card_table = CardTable::Allocate(size);
+  for (size_t offset = 0; offset < size; offset += kTaggedSize) {
+    card_table->Mark(offset);
+  }
+  std::vector<std::pair<size_t, size_t>> cards = DirtyCards(card_table, size);
+  ASSERT_EQ(37u, cards.size());
+  for (size_t i = 0; i < cards.size(); i++) {
+    EXPECT_EQ(i * CardTable::kCardSize, cards[i].first);
+    EXPECT_EQ((i + 1) * CardTable::kCardSize, cards[i].second);
+  }
+  EXPECT_TRUE(card_table->IsClean(size));
+  CardTable::Delete(card_table);
+}
+
+}  // namespace internal
+}  // namespace v8
@@ -21,6 +21,9 @@
 #include "src/common/globals.h"
 #include "src/heap/cppgc-js/cpp-heap.h"
 #include "src/heap/cppgc/heap-object-header.h"
+#include "src/heap/incremental-marking.h"
+#include "src/heap/marking-state-inl.h"
+#include "src/heap/minor-mark-sweep.h"
 #include "src/objects/objects-inl.h"
 #include "test/common/flag-utils.h"
 #include "test/unittests/heap/cppgc-js/unified-heap-utils.h"
@@ -240,6 +243,61 @@ TEST_F(YoungUnifiedHeapTest, GenerationalBarrierV8ToCppGCReference) {
   EXPECT_EQ(0u, Wrappable::destructor_callcount);
 }
 
+TEST_F(YoungUnifiedHeapTest, ConcurrentMarkingBarrierV8ToCppGCReference) {
+  if (i::v8_flags.single_generation) return;
+  if (i::v8_flags.stress_incremental_marking) return;
+  if (!i::v8_flags.concurrent_marking) return;
+
+  FlagScope<bool> incremental_marking(&v8_flags.incremental_marking, true);
+  FlagScope<bool> concurrent_minor_ms_marking(
+      &v8_flags.concurrent_minor_ms_marking, true);
+  FlagScope<bool> cppheap_incremental_marking(
+      &v8_flags.cppheap_incremental_marking, true);
+  FlagScope<bool> cppheap_concurrent_marking(
+      &v8_flags.cppheap_concurrent_marking, true);
+  cpp_heap().UpdateGCCapabilitiesFromFlagsForTesting();
+
+  v8::Local<v8::Object> api_object =
+      WrapperHelper::CreateWrapper(context(), nullptr);
+  // With direct locals, api_object may be invalid after a stackless GC.
+  auto handle_api_object = v8::Utils::OpenIndirectHandle(*api_object);
+  EXPECT_TRUE(Heap::InYoungGeneration(*handle_api_object));
+  // Reference the wrapper from old space such that it is found through the
+  // remembered set while marking rather than as a root in the atomic pause.
+  DirectHandle<FixedArray> holder =
+      isolate()->factory()->NewFixedArray(1, AllocationType::kOld);
+  holder->set(0, *handle_api_object);
+
+  Heap* heap = isolate()->heap();
+  ASSERT_TRUE(heap->incremental_marking()->IsStopped());
+  heap->StartIncrementalMarking(GCFlag::kNoFlags,
+                                GarbageCollectionReason::kTesting,
+                                GCCallbackFlags::kNoGCCallbackFlags,
+                                GarbageCollector::MINOR_MARK_SWEEPER);
+  ASSERT_TRUE(heap->incremental_marking()->IsMinorMarking());
+  // The CppHeap marks concurrently alongside MinorMS instead of waiting for
+  // the atomic pause.
+  EXPECT_TRUE(cpp_heap().is_incremental_marking_in_progress());
+  // Visit the young wrapper before the wrappable is attached to it.
+  heap->minor_mark_sweep_collector()->DrainMarkingWorklistForTesting();
+  EXPECT_TRUE(heap->marking_state()->IsMarked(*handle_api_object));
+
+  // The wrapper is not visited again, so the young wrappable is only kept
+  // alive by the marking barrier.
+  auto* wrappable = cppgc::MakeGarbageCollected<Wrappable>(allocation_handle());
+  EXPECT_TRUE(IsHeapObjectYoung(wrappable));
+  WrapperHelper::SetWrappableConnection(
+      v8_isolate(), v8::Utils::ToLocal(handle_api_object), wrappable);
+
+  Wrappable::destructor_callcount = 0;
+  CollectYoungGarbageWithoutEmbedderStack(cppgc::Heap::SweepingType::kAtomic);
+  EXPECT_EQ(0u, Wrappable::destructor_callcount);
+  EXPECT_TRUE(IsHeapObjectOld(wrappable));
+  EXPECT_EQ(wrappable,
+            WrapperHelper::ReadWrappablePointer(
+                v8_isolate(), v8::Utils::ToLocal(handle_api_object)));
+}
+
 TEST_F(YoungUnifiedHeapTest,
        GenerationalBarrierCppGCToV8NoInitializingStoreBarrier) {
   if (i::v8_flags.single_generation) return;
@@ -4,9 +4,18 @@
 
 #include "include/cppgc/allocation.h"
 
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/cppgc/cross-thread-persistent.h"
 #include "include/cppgc/visitor.h"
+#include "src/base/platform/platform.h"
 #include "src/heap/cppgc/globals.h"
 #include "src/heap/cppgc/heap-object-header.h"
+#include "src/heap/cppgc/heap-page.h"
+#include "src/heap/cppgc/heap.h"
+#include "src/heap/cppgc/object-allocator.h"
 #include "test/unittests/heap/cppgc/tests.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -245,5 +254,82 @@ TEST_F(CppgcAllocationTest, AlignToDoubleWordFromAligned) {
   }
 }
 
+namespace {
+
+class ThreadLocalAllocatingThread final : public v8::base::Thread {
+ public:
+  static constexpr size_t kNumObjects = 10000;
+
+  explicit ThreadLocalAllocatingThread(ThreadLocalAllocator& allocator)
+      : v8::base::Thread(Options("Thread-local allocating thread")),
+        allocator_(allocator) {}
+
+  void Run() final {
+    ThreadLocalAllocator::UnparkedScope unparked_scope(allocator_);
+    for (size_t i = 0; i < kNumObjects; ++i) {
+      HeapAllocatedArray* array = MakeGarbageCollected<HeapAllocatedArray>(
+          allocator_.GetAllocationHandle());
+      // Keep the last object alive across safepoints.
+      last_ = array;
+      allocator_.Safepoint();
+      if (last_->at(999) != 999 % 128) corrupted_ = true;
+    }
+  }
+
+  bool corrupted() const { return corrupted_; }
+  HeapAllocatedArray* last() const { return last_.Get(); }
+
+ private:
+  ThreadLocalAllocator& allocator_;
+  subtle::CrossThreadPersistent<HeapAllocatedArray> last_;
+  bool corrupted_ = false;
+};
+
+}  // namespace
+
+TEST_F(CppgcAllocationTest, ThreadLocalAllocatorsAllocateConcurrently) {
+  static constexpr size_t kNumThreads = 4;
+  std::vector<std::unique_ptr<ThreadLocalAllocator>> allocators;
+  std::vector<std::unique_ptr<ThreadLocalAllocatingThread>> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    allocators.push_back(
+        std::make_unique<ThreadLocalAllocator>(*Heap::From(GetHeap())));
+    threads.push_back(
+        std::make_unique<ThreadLocalAllocatingThread>(*allocators.back()));
+  }
+  for (auto& thread : threads) ASSERT_TRUE(thread->Start());
+  // Garbage collections wait for the other threads to reach a safepoint.
+  for (int i = 0; i < 5; ++i) PreciseGC();
+  for (auto& thread : threads) thread->Join();
+  PreciseGC();
+  for (auto& thread : threads) {
+    EXPECT_FALSE(thread->corrupted());
+    ASSERT_NE(nullptr, thread->last());
+    EXPECT_EQ(999 % 128, thread->last()->at(999));
+  }
+  threads.clear();
+  allocators.clear();
+  // The heap's own allocator is unaffected.
+  EXPECT_NE(nullptr, MakeGarbageCollected<GCed>(GetAllocationHandle()));
+}
+
+TEST_F(CppgcAllocationTest, ThreadLocalAllocatorAlignedAndLargeAllocation) {
+  static constexpr size_t kAlignmentMask = kDoubleWord - 1;
+  ThreadLocalAllocator allocator(*Heap::From(GetHeap()));
+  ThreadLocalAllocator::UnparkedScope unparked_scope(allocator);
+  // Allocate the large object first, as large objects that fit into the
+  // current linear allocation buffer are allocated from it.
+  auto* large = MakeGarbageCollected<LargeDoubleWordAligned>(
+      allocator.GetAllocationHandle());
+  EXPECT_TRUE(BasePage::FromPayload(large)->is_large());
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(large) & kAlignmentMask);
+  for (int i = 0; i < 3; ++i) {
+    MakeGarbageCollected<GCed>(allocator.GetAllocationHandle());
+    auto* aligned = MakeGarbageCollected<AlignedCustomPadding<16>>(
+        allocator.GetAllocationHandle());
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(aligned) & kAlignmentMask);
+  }
+}
+
 }  // namespace internal
 }  // namespace cppgc
@@ -4,6 +4,8 @@
 
 #include "src/heap/cppgc/compactor.h"
 
+#include <vector>
+
 #include "include/cppgc/allocation.h"
 #include "include/cppgc/custom-space.h"
 #include "include/cppgc/persistent.h"
@@ -63,6 +65,47 @@ struct CompactableHolder
   CompactableGCed* objects[kNumObjects]{};
 };
 
+struct CompactableGCedWithPayload
+    : public GarbageCollected<CompactableGCedWithPayload> {
+ public:
+  explicit CompactableGCedWithPayload(size_t id) : id(id) {}
+  ~CompactableGCedWithPayload() { ++g_destructor_callcount; }
+  void Trace(Visitor* visitor) const {
+    VisitorBase::TraceRawForTesting(
+        visitor, const_cast<const CompactableGCedWithPayload*>(other));
+    visitor->RegisterMovableReference(
+        const_cast<const CompactableGCedWithPayload**>(&other));
+  }
+  static size_t g_destructor_callcount;
+  CompactableGCedWithPayload* other = nullptr;
+  size_t id;
+  char payload[1024]{};
+};
+// static
+size_t CompactableGCedWithPayload::g_destructor_callcount = 0;
+
+template <size_t kNumObjects>
+struct CompactableHolderWithPayload
+    : public GarbageCollected<CompactableHolderWithPayload<kNumObjects>> {
+ public:
+  explicit CompactableHolderWithPayload(
+      cppgc::AllocationHandle& allocation_handle) {
+    for (size_t i = 0; i < kNumObjects; ++i)
+      objects[i] = MakeGarbageCollected<CompactableGCedWithPayload>(
+          allocation_handle, i);
+  }
+
+  void Trace(Visitor* visitor) const {
+    for (size_t i = 0; i < kNumObjects; ++i) {
+      VisitorBase::TraceRawForTesting(
+          visitor, const_cast<const CompactableGCedWithPayload*>(objects[i]));
+      visitor->RegisterMovableReference(
+          const_cast<const CompactableGCedWithPayload**>(&objects[i]));
+    }
+  }
+  CompactableGCedWithPayload* objects[kNumObjects]{};
+};
+
 class CompactorTest : public testing::TestWithPlatform {
  public:
   CompactorTest() {
@@ -79,10 +122,13 @@ class CompactorTest : public testing::TestWithPlatform {
     EXPECT_TRUE(compactor().IsEnabledForTesting());
   }
 
-  void FinishCompaction() { compactor().CompactSpacesIfEnabled(); }
+  SweepingConfig::CompactableSpaceHandling FinishCompaction() {
+    return compactor().CompactSpacesIfEnabled();
+  }
 
   void StartGC() {
     CompactableGCed::g_destructor_callcount = 0u;
+    CompactableGCedWithPayload::g_destructor_callcount = 0u;
     StartCompaction();
     heap()->StartIncrementalGarbageCollection(
         GCConfig::PreciseIncrementalConfig());
@@ -91,11 +137,11 @@ class CompactorTest : public testing::TestWithPlatform {
   void EndGC() {
     heap()->marker()->FinishMarking(StackState::kNoHeapPointers);
     heap()->GetMarkerRefForTesting().reset();
-    FinishCompaction();
+    const SweepingConfig::CompactableSpaceHandling compactable_space_handling =
+        FinishCompaction();
     // Sweeping also verifies the object start bitmap.
-    const SweepingConfig sweeping_config{
-        SweepingConfig::SweepingType::kAtomic,
-        SweepingConfig::CompactableSpaceHandling::kIgnore};
+    const SweepingConfig sweeping_config{SweepingConfig::SweepingType::kAtomic,
+                                         compactable_space_handling};
     heap()->sweeper().Start(sweeping_config);
     heap()->sweeper().FinishIfRunning();
   }
@@ -119,6 +165,11 @@ struct SpaceTrait<internal::CompactableGCed> {
   using Space = CompactableCustomSpace;
 };
 
+template <>
+struct SpaceTrait<internal::CompactableGCedWithPayload> {
+  using Space = CompactableCustomSpace;
+};
+
 namespace internal {
 
 TEST_F(CompactorTest, NothingToCompact) {
@@ -245,6 +296,66 @@ TEST_F(CompactorTest, InteriorSlotToNextObject) {
   EXPECT_EQ(references[1], holder->objects[1]->other);
 }
 
+TEST_F(CompactorTest, ZeroPauseBudgetSkipsPagesWithLiveObjects) {
+  static constexpr int kNumObjects = 10;
+  compactor().set_pause_budget(v8::base::TimeDelta());
+  Persistent<CompactableHolder<kNumObjects>> holder =
+      MakeGarbageCollected<CompactableHolder<kNumObjects>>(
+          GetAllocationHandle(), GetAllocationHandle());
+  CompactableGCed* references[kNumObjects] = {nullptr};
+  for (int i = 0; i < kNumObjects; ++i) {
+    references[i] = holder->objects[i];
+  }
+  StartGC();
+  for (int i = 0; i < kNumObjects; i += 2) {
+    holder->objects[i] = nullptr;
+  }
+  EndGC();
+  // Dead objects were reclaimed by the sweeper.
+  EXPECT_EQ(5u, CompactableGCed::g_destructor_callcount);
+  // Remaining objects were not moved.
+  for (int i = 1; i < kNumObjects; i += 2) {
+    EXPECT_EQ(holder->objects[i], references[i]);
+  }
+}
+
+TEST_F(CompactorTest, CompactManyPagesInParallel) {
+  // Spans enough pages to be split up across several compaction tasks.
+  static constexpr size_t kNumObjects = 4096;
+  compactor().set_pause_budget(v8::base::TimeDelta::Max());
+  Persistent<CompactableHolderWithPayload<kNumObjects>> holder =
+      MakeGarbageCollected<CompactableHolderWithPayload<kNumObjects>>(
+          GetAllocationHandle(), GetAllocationHandle());
+  // Objects with odd ids are only referenced through interior slots of
+  // objects on other pages.
+  for (size_t i = 0; i < kNumObjects; i += 2) {
+    holder->objects[i]->other =
+        holder->objects[(i + kNumObjects / 2 + 1) % kNumObjects];
+  }
+  for (size_t i = 1; i < kNumObjects; i += 2) {
+    holder->objects[i] = nullptr;
+  }
+  std::vector<CompactableGCedWithPayload*> references(
+      std::begin(holder->objects), std::end(holder->objects));
+  StartGC();
+  for (size_t i = 2; i < kNumObjects; i += 4) {
+    holder->objects[i] = nullptr;
+  }
+  EndGC();
+  EXPECT_EQ(kNumObjects / 2,
+            CompactableGCedWithPayload::g_destructor_callcount);
+  size_t moved_objects = 0;
+  for (size_t i = 0; i < kNumObjects; i += 4) {
+    ASSERT_NE(nullptr, holder->objects[i]);
+    EXPECT_EQ(i, holder->objects[i]->id);
+    ASSERT_NE(nullptr, holder->objects[i]->other);
+    EXPECT_EQ((i + kNumObjects / 2 + 1) % kNumObjects,
+              holder->objects[i]->other->id);
+    if (holder->objects[i] != references[i]) ++moved_objects;
+  }
+  EXPECT_LT(0u, moved_objects);
+}
+
 TEST_F(CompactorTest, OnStackSlotShouldBeFiltered) {
   StartGC();
   const CompactableGCed* compactable_object =
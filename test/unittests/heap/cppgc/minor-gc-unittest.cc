@@ -324,6 +324,32 @@ TYPED_TEST(MinorGCTestForType, StickyBits) {
   EXPECT_EQ(0u, TestFixture::DestructedObjects());
 }
 
+TYPED_TEST(MinorGCTestForType, ConcurrentMinorCollection) {
+  using Type = typename TestFixture::Type;
+
+  Persistent<Type> old =
+      MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  TestFixture::CollectMinor();
+  ASSERT_TRUE(IsHeapObjectOld(old.Get()));
+
+  // Young object that is only reachable through the remembered set.
+  old->next = MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  MakeGarbageCollected<Type>(this->GetAllocationHandle());
+
+  Heap* heap = Heap::From(this->GetHeap());
+  heap->StartIncrementalGarbageCollection(
+      GCConfig::MinorPreciseConcurrentConfig());
+  ASSERT_TRUE(heap->marker());
+  // Young object that is only reachable through a write during marking.
+  old->next->next = MakeGarbageCollected<Type>(this->GetAllocationHandle());
+  heap->FinalizeIncrementalGarbageCollectionIfRunning(
+      GCConfig::MinorPreciseConcurrentConfig());
+
+  EXPECT_EQ(1u, TestFixture::DestructedObjects());
+  EXPECT_TRUE(IsHeapObjectOld(old->next.Get()));
+  EXPECT_TRUE(IsHeapObjectOld(old->next->next.Get()));
+}
+
 TYPED_TEST(MinorGCTestForType, OldObjectIsNotVisited) {
   using Type = typename TestFixture::Type;
 
@@ -605,4 +605,70 @@ TEST_F(GCTracerTest, RecordScavengerHistograms) {
   GcHistogram::CleanUp();
 }
 
+TEST_F(GCTracerTest, PauseHistogramBuckets) {
+  using PauseHistograms = GCTracer::PauseHistograms;
+  for (int64_t value = 0; value < 8; value++) {
+    EXPECT_EQ(static_cast<size_t>(value), PauseHistograms::BucketIndex(value));
+  }
+  for (size_t index = 0; index < PauseHistograms::kBucketCount; index++) {
+    const int64_t lower_bound = PauseHistograms::BucketLowerBound(index);
+    EXPECT_EQ(index, PauseHistograms::BucketIndex(lower_bound));
+    if (index > 0) {
+      EXPECT_EQ(index - 1, PauseHistograms::BucketIndex(lower_bound - 1));
+      // Buckets are within 12.5% of the values counted in them.
+      EXPECT_LE(PauseHistograms::BucketLowerBound(index) -
+                    PauseHistograms::BucketLowerBound(index - 1),
+                std::max<int64_t>(1, lower_bound / 8));
+    }
+  }
+  EXPECT_EQ(PauseHistograms::kBucketCount - 1,
+            PauseHistograms::BucketIndex(std::numeric_limits<int64_t>::max()));
+}
+
+TEST_F(GCTracerTest, GCStatisticsPauseHistograms) {
+  if (v8_flags.stress_incremental_marking) return;
+  GCTracer* tracer = i_isolate()->heap()->tracer();
+  tracer->ResetForTesting();
+
+  const base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 1; i <= 100; i++) {
+    StartTracing(tracer, GarbageCollector::SCAVENGER,
+                 StartTracingMode::kAtomic, start);
+    StopTracing(tracer, GarbageCollector::SCAVENGER,
+                start + base::TimeDelta::FromMicroseconds(i * 100));
+  }
+  StartTracing(tracer, GarbageCollector::MARK_COMPACTOR,
+               StartTracingMode::kAtomic, start);
+  tracer->AddScopeSample(GCTracer::Scope::MC_MARK,
+                         base::TimeDelta::FromMilliseconds(3));
+  StopTracing(tracer, GarbageCollector::MARK_COMPACTOR,
+              start + base::TimeDelta::FromMilliseconds(5));
+
+  GCStatisticsSnapshot snapshot;
+  isolate()->GetGCStatistics(&snapshot);
+  const GCPauseHistogram& scavenges =
+      snapshot.histogram(GCStatisticsSnapshot::Phase::kScavenge);
+  EXPECT_EQ(100u, scavenges.count());
+  EXPECT_EQ(505000, scavenges.total_microseconds());
+  EXPECT_EQ(10000, scavenges.max_microseconds());
+  const int64_t p99 = scavenges.PercentileMicroseconds(99);
+  EXPECT_GE(p99, 9900);
+  EXPECT_LE(p99, 9900 + 9900 / 8);
+  EXPECT_EQ(10000, scavenges.PercentileMicroseconds(100));
+  const int64_t p50 = scavenges.PercentileMicroseconds(50);
+  EXPECT_GE(p50, 5000);
+  EXPECT_LE(p50, 5000 + 5000 / 8);
+
+  const GCPauseHistogram& mark_compacts =
+      snapshot.histogram(GCStatisticsSnapshot::Phase::kMarkCompact);
+  EXPECT_EQ(1u, mark_compacts.count());
+  EXPECT_EQ(5000, mark_compacts.max_microseconds());
+  const GCPauseHistogram& marking =
+      snapshot.histogram(GCStatisticsSnapshot::Phase::kMark);
+  EXPECT_EQ(1u, marking.count());
+  EXPECT_EQ(3000, marking.total_microseconds());
+  EXPECT_EQ(0u, snapshot.histogram(GCStatisticsSnapshot::Phase::kMinorMarkSweep)
+                    .count());
+}
+
 }  // namespace v8::internal
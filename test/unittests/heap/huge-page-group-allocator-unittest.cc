@@ -0,0 +1,125 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/heap/huge-page-group-allocator.h"
+
+#include <vector>
+
+#include "src/utils/allocation.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+using HugePageGroupAllocatorTest = ::testing::Test;
+
+void* AllocatePage(HugePageGroupAllocator* allocator) {
+  return allocator->AllocatePages(nullptr, HugePageGroupAllocator::kPageSize,
+                                  HugePageGroupAllocator::kPageSize,
+                                  PageAllocator::kReadWrite);
+}
+
+}  // namespace
+
+TEST_F(HugePageGroupAllocatorTest, PagesShareAGroup) {
+  HugePageGroupAllocator allocator(GetPlatformPageAllocator(), false);
+  std::vector<void*> pages;
+  for (size_t i = 0; i < HugePageGroupAllocator::kPagesPerGroup; i++) {
+    void* page = AllocatePage(&allocator);
+    ASSERT_NE(nullptr, page);
+    EXPECT_TRUE(IsAligned(reinterpret_cast<Address>(page),
+                          HugePageGroupAllocator::kPageSize));
+    // The page is usable right away.
+    *reinterpret_cast<volatile int*>(page) = 42;
+    pages.push_back(page);
+  }
+  EXPECT_EQ(1u, allocator.NumberOfGroups());
+  EXPECT_EQ(0u, allocator.NumberOfFreePages());
+  Address group = RoundDown(reinterpret_cast<Address>(pages[0]),
+                            HugePageGroupAllocator::kGroupSize);
+  for (void* page : pages) {
+    EXPECT_EQ(group, RoundDown(reinterpret_cast<Address>(page),
+                               HugePageGroupAllocator::kGroupSize));
+  }
+
+  // A full group makes the next page start a new one.
+  void* page = AllocatePage(&allocator);
+  ASSERT_NE(nullptr, page);
+  EXPECT_EQ(2u, allocator.NumberOfGroups());
+  EXPECT_EQ(HugePageGroupAllocator::kPagesPerGroup - 1,
+            allocator.NumberOfFreePages());
+  EXPECT_TRUE(allocator.FreePages(page, HugePageGroupAllocator::kPageSize));
+  EXPECT_EQ(1u, allocator.NumberOfGroups());
+
+  for (void* page : pages) {
+    EXPECT_TRUE(allocator.FreePages(page, HugePageGroupAllocator::kPageSize));
+  }
+  EXPECT_EQ(0u, allocator.NumberOfGroups());
+}
+
+TEST_F(HugePageGroupAllocatorTest, FreedPagesAreReused) {
+  HugePageGroupAllocator allocator(GetPlatformPageAllocator(), false);
+  void* first = AllocatePage(&allocator);
+  void* second = AllocatePage(&allocator);
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_TRUE(allocator.FreePages(first, HugePageGroupAllocator::kPageSize));
+  // Freed pages stay in their group and are handed out again.
+  EXPECT_EQ(1u, allocator.NumberOfGroups());
+  EXPECT_EQ(first, AllocatePage(&allocator));
+  // Discarding keeps the huge page intact.
+  EXPECT_TRUE(allocator.DiscardSystemPages(second,
+                                           HugePageGroupAllocator::kPageSize));
+  EXPECT_EQ(1u, allocator.NumberOfGroups());
+  EXPECT_TRUE(allocator.FreePages(first, HugePageGroupAllocator::kPageSize));
+  EXPECT_TRUE(allocator.FreePages(second, HugePageGroupAllocator::kPageSize));
+  EXPECT_EQ(0u, allocator.NumberOfGroups());
+}
+
+TEST_F(HugePageGroupAllocatorTest, OtherRequestsAreForwarded) {
+  HugePageGroupAllocator allocator(GetPlatformPageAllocator(), false);
+  // Large pages and pages with other permissions bypass the groups.
+  const size_t large_size = 2 * HugePageGroupAllocator::kPageSize;
+  void* large = allocator.AllocatePages(nullptr, large_size,
+                                        HugePageGroupAllocator::kPageSize,
+                                        PageAllocator::kReadWrite);
+  ASSERT_NE(nullptr, large);
+  void* no_access = allocator.AllocatePages(
+      nullptr, HugePageGroupAllocator::kPageSize,
+      HugePageGroupAllocator::kPageSize, PageAllocator::kNoAccess);
+  ASSERT_NE(nullptr, no_access);
+  EXPECT_EQ(0u, allocator.NumberOfGroups());
+  EXPECT_TRUE(allocator.FreePages(large, large_size));
+  EXPECT_TRUE(
+      allocator.FreePages(no_access, HugePageGroupAllocator::kPageSize));
+}
+
+TEST_F(HugePageGroupAllocatorTest, GroupPagesCannotBeShrunk) {
+  HugePageGroupAllocator allocator(GetPlatformPageAllocator(), false);
+  void* page = AllocatePage(&allocator);
+  ASSERT_NE(nullptr, page);
+  // Shrinking would return the tail of the page to the underlying allocator
+  // while the group still owns it.
+  EXPECT_DEATH_IF_SUPPORTED(
+      allocator.ReleasePages(page, HugePageGroupAllocator::kPageSize,
+                             HugePageGroupAllocator::kPageSize / 2),
+      "");
+  EXPECT_TRUE(allocator.FreePages(page, HugePageGroupAllocator::kPageSize));
+}
+
+TEST_F(HugePageGroupAllocatorTest, ExplicitHugePagesFallBack) {
+  // Works whether or not hugetlbfs pages are configured on the host.
+  HugePageGroupAllocator allocator(GetPlatformPageAllocator(), true);
+  void* page = AllocatePage(&allocator);
+  ASSERT_NE(nullptr, page);
+  *reinterpret_cast<volatile int*>(page) = 42;
+  EXPECT_EQ(1u, allocator.NumberOfGroups());
+  EXPECT_TRUE(allocator.FreePages(page, HugePageGroupAllocator::kPageSize));
+  EXPECT_EQ(0u, allocator.NumberOfGroups());
+}
+
+}  // namespace internal
+}  // namespace v8
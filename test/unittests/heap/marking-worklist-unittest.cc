@@ -143,5 +143,65 @@ TEST_F(MarkingWorklistTest, ContextWorklistCrossTask) {
   holder.ReleaseContextWorklists();
 }
 
+TEST_F(MarkingWorklistTest, PrefetchQueueKeepsAllObjects) {
+  MarkingWorklists holder;
+  MarkingWorklists::Local worklists(&holder);
+  Tagged<HeapObject> objects[3];
+  for (int i = 0; i < 3; i++) {
+    objects[i] = Cast<HeapObject>(
+        i_isolate()
+            ->roots_table()
+            .slot(static_cast<RootIndex>(
+                static_cast<int>(RootIndex::kFirstStrongRoot) + i))
+            .load(i_isolate()));
+    worklists.Push(objects[i]);
+  }
+  auto pop = [&worklists](Tagged<HeapObject>* object) {
+    return worklists.Pop(object);
+  };
+  MarkingPrefetchQueue queue(2);
+  Tagged<HeapObject> popped_object;
+  // The worklist is LIFO, the queue hands out objects in the order it popped
+  // them.
+  EXPECT_TRUE(queue.Pop(&popped_object, pop));
+  EXPECT_EQ(objects[2], popped_object);
+  EXPECT_FALSE(queue.IsEmpty());
+  // Flushing returns the queued object to the worklist.
+  queue.Flush([&worklists](Tagged<HeapObject> object) {
+    worklists.Push(object);
+  });
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_TRUE(queue.Pop(&popped_object, pop));
+  EXPECT_EQ(objects[1], popped_object);
+  EXPECT_TRUE(queue.Pop(&popped_object, pop));
+  EXPECT_EQ(objects[0], popped_object);
+  EXPECT_FALSE(queue.Pop(&popped_object, pop));
+  EXPECT_TRUE(worklists.IsEmpty());
+  EXPECT_EQ(3u, queue.prefetched_objects());
+}
+
+TEST_F(MarkingWorklistTest, PrefetchQueueDisabled) {
+  MarkingWorklists holder;
+  MarkingWorklists::Local worklists(&holder);
+  Tagged<HeapObject> pushed_object =
+      Cast<HeapObject>(i_isolate()
+                           ->roots_table()
+                           .slot(RootIndex::kFirstStrongRoot)
+                           .load(i_isolate()));
+  worklists.Push(pushed_object);
+  worklists.Push(pushed_object);
+  MarkingPrefetchQueue queue(0);
+  Tagged<HeapObject> popped_object;
+  EXPECT_TRUE(queue.Pop(&popped_object, [&worklists](Tagged<HeapObject>* o) {
+    return worklists.Pop(o);
+  }));
+  EXPECT_EQ(popped_object, pushed_object);
+  // Without prefetching nothing is popped ahead.
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_FALSE(worklists.IsEmpty());
+  EXPECT_EQ(0u, queue.prefetched_objects());
+  EXPECT_TRUE(worklists.Pop(&popped_object));
+}
+
 }  // namespace internal
 }  // namespace v8
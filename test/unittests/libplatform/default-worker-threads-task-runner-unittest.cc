@@ -5,6 +5,7 @@
 #include "src/libplatform/default-worker-threads-task-runner.h"
 
 #include <algorithm>
+#include <functional>
 #include <vector>
 
 #include "include/v8-platform.h"
@@ -268,6 +269,124 @@ TEST(DefaultWorkerThreadsTaskRunnerUnittest, PostAfterTerminate) {
   ASSERT_EQ(1, order[0]);
 }
 
+TEST(DefaultWorkerThreadsTaskRunnerUnittest, PostTaskOrderFromWorkerThread) {
+  DefaultWorkerThreadsTaskRunner runner(1, RealTime);
+
+  std::vector<int> order;
+  base::Semaphore semaphore(0);
+
+  // Tasks posted by a worker thread are run in order as well.
+  runner.PostTask(std::make_unique<TestTask>([&] {
+    for (int i = 0; i < 3; ++i) {
+      runner.PostTask(std::make_unique<TestTask>([&order, i] {
+        order.push_back(i);
+      }));
+    }
+    runner.PostTask(std::make_unique<TestTask>([&] { semaphore.Signal(); }));
+  }));
+
+  semaphore.Wait();
+
+  runner.Terminate();
+  ASSERT_EQ(3UL, order.size());
+  ASSERT_EQ(0, order[0]);
+  ASSERT_EQ(1, order[1]);
+  ASSERT_EQ(2, order[2]);
+}
+
+TEST(DefaultWorkerThreadsTaskRunnerUnittest, PostTaskFromWorkerThreads) {
+  DefaultWorkerThreadsTaskRunner runner(4, RealTime);
+
+  // Every task posts two more tasks until the tree is complete, which spreads
+  // the tasks over the workers through stealing. More tasks than fit into the
+  // queue of a worker are posted in total.
+  static constexpr int kDepth = 12;
+  static constexpr int kNumTasks = (1 << (kDepth + 1)) - 1;
+  std::atomic_int count{0};
+  base::Semaphore semaphore(0);
+
+  std::function<void(int)> post_task = [&](int depth) {
+    runner.PostTask(std::make_unique<TestTask>([&, depth] {
+      if (depth < kDepth) {
+        post_task(depth + 1);
+        post_task(depth + 1);
+      }
+      if (++count == kNumTasks) semaphore.Signal();
+    }));
+  };
+  post_task(0);
+
+  semaphore.Wait();
+
+  runner.Terminate();
+  ASSERT_EQ(kNumTasks, count);
+}
+
+TEST(DefaultWorkerThreadsTaskRunnerUnittest, PostTaskFromExternalThreads) {
+  DefaultWorkerThreadsTaskRunner runner(4, RealTime);
+
+  // Tasks posted from outside of the pool are spread over the queues of the
+  // workers. More tasks than fit into these queues are posted in total.
+  static constexpr int kNumThreads = 4;
+  static constexpr int kNumTasksPerThread = 2048;
+  static constexpr int kNumTasks = kNumThreads * kNumTasksPerThread;
+  std::atomic_int count{0};
+  base::Semaphore semaphore(0);
+
+  class PostingThread final : public base::Thread {
+   public:
+    explicit PostingThread(std::function<void()> post)
+        : Thread(Options("PostingThread")), post_(std::move(post)) {}
+
+    void Run() override { post_(); }
+
+   private:
+    std::function<void()> post_;
+  };
+
+  std::vector<std::unique_ptr<PostingThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<PostingThread>([&] {
+      for (int j = 0; j < kNumTasksPerThread; ++j) {
+        runner.PostTask(std::make_unique<TestTask>([&] {
+          if (++count == kNumTasks) semaphore.Signal();
+        }));
+      }
+    }));
+    ASSERT_TRUE(threads.back()->Start());
+  }
+  for (auto& thread : threads) {
+    thread->Join();
+  }
+
+  semaphore.Wait();
+
+  runner.Terminate();
+  ASSERT_EQ(kNumTasks, count);
+}
+
+TEST(DefaultWorkerThreadsTaskRunnerUnittest, TerminateRunsPostedTasks) {
+  DefaultWorkerThreadsTaskRunner runner(2, RealTime);
+
+  std::atomic_int count{0};
+  base::Semaphore started(0);
+  base::Semaphore proceed(0);
+
+  // Tasks that a worker thread posted before termination are still run.
+  runner.PostTask(std::make_unique<TestTask>([&] {
+    for (int i = 0; i < 10; ++i) {
+      runner.PostTask(std::make_unique<TestTask>([&] { count++; }));
+    }
+    started.Signal();
+    proceed.Wait();
+  }));
+
+  started.Wait();
+  proceed.Signal();
+  runner.Terminate();
+  ASSERT_EQ(10, count);
+}
+
 TEST(DefaultWorkerThreadsTaskRunnerUnittest, NoIdleTasks) {
   DefaultWorkerThreadsTaskRunner runner(1, FakeClock::time);
 
@@ -0,0 +1,259 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/libplatform/work-stealing-queue.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "include/v8-platform.h"
+#include "src/base/platform/platform.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace platform {
+namespace work_stealing_queue_unittest {
+
+namespace {
+
+class IndexTask final : public Task {
+ public:
+  explicit IndexTask(size_t index) : index_(index) {}
+
+  void Run() override {}
+
+  size_t index() const { return index_; }
+
+ private:
+  const size_t index_;
+};
+
+size_t IndexOf(const std::unique_ptr<Task>& task) {
+  return static_cast<IndexTask*>(task.get())->index();
+}
+
+template <typename Queue>
+class StealingThread final : public base::Thread {
+ public:
+  StealingThread(Queue* queue, std::vector<int>* runs,
+                 const std::atomic<bool>* done)
+      : Thread(Options("libplatform StealingThread")),
+        queue_(queue),
+        runs_(runs),
+        done_(done) {}
+
+  void Run() override {
+    for (;;) {
+      // Check for |done_| before stealing so that no task is left behind.
+      const bool done = done_->load(std::memory_order_acquire);
+      std::unique_ptr<Task> task = queue_->Steal();
+      if (task) {
+        (*runs_)[IndexOf(task)]++;
+      } else if (done) {
+        return;
+      }
+    }
+  }
+
+ private:
+  Queue* queue_;
+  std::vector<int>* runs_;
+  const std::atomic<bool>* done_;
+};
+
+}  // namespace
+
+TEST(WorkStealingQueueTest, StealInPushOrder) {
+  WorkStealingQueue queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(nullptr, queue.Steal());
+  for (size_t i = 0; i < 3; ++i) {
+    queue.Push(std::make_unique<IndexTask>(i));
+  }
+  EXPECT_FALSE(queue.IsEmpty());
+  for (size_t i = 0; i < 3; ++i) {
+    std::unique_ptr<Task> task = queue.Steal();
+    ASSERT_NE(nullptr, task);
+    EXPECT_EQ(i, IndexOf(task));
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(nullptr, queue.Steal());
+}
+
+TEST(WorkStealingQueueTest, Full) {
+  WorkStealingQueue queue;
+  for (size_t i = 0; i < WorkStealingQueue::kCapacity; ++i) {
+    EXPECT_FALSE(queue.IsFull());
+    queue.Push(std::make_unique<IndexTask>(i));
+  }
+  EXPECT_TRUE(queue.IsFull());
+  // Stealing frees up a slot, which is reused in order.
+  EXPECT_EQ(0u, IndexOf(queue.Steal()));
+  EXPECT_FALSE(queue.IsFull());
+  queue.Push(std::make_unique<IndexTask>(WorkStealingQueue::kCapacity));
+  for (size_t i = 1; i <= WorkStealingQueue::kCapacity; ++i) {
+    EXPECT_EQ(i, IndexOf(queue.Steal()));
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(WorkStealingQueueTest, ConcurrentSteal) {
+  static constexpr size_t kNumThreads = 4;
+  static constexpr size_t kNumTasks = 64 * 1024;
+  WorkStealingQueue queue;
+  std::atomic<bool> done{false};
+  std::vector<std::vector<int>> runs(kNumThreads + 1,
+                                     std::vector<int>(kNumTasks, 0));
+  std::vector<std::unique_ptr<StealingThread<WorkStealingQueue>>> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::make_unique<StealingThread<WorkStealingQueue>>(
+        &queue, &runs[i], &done));
+    ASSERT_TRUE(threads.back()->Start());
+  }
+  // The owner pushes all tasks and takes some of them itself whenever the
+  // queue is full.
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    while (queue.IsFull()) {
+      if (std::unique_ptr<Task> task = queue.Steal()) {
+        runs[kNumThreads][IndexOf(task)]++;
+      }
+    }
+    queue.Push(std::make_unique<IndexTask>(i));
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread->Join();
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+  // Every task was taken exactly once.
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    int total = 0;
+    for (const std::vector<int>& thread_runs : runs) total += thread_runs[i];
+    EXPECT_EQ(1, total);
+  }
+}
+
+TEST(SharedWorkStealingQueueTest, StealInPushOrder) {
+  SharedWorkStealingQueue queue;
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(nullptr, queue.Steal());
+  for (size_t i = 0; i < 3; ++i) {
+    std::unique_ptr<Task> task = std::make_unique<IndexTask>(i);
+    EXPECT_TRUE(queue.TryPush(task));
+    EXPECT_EQ(nullptr, task);
+  }
+  EXPECT_FALSE(queue.IsEmpty());
+  for (size_t i = 0; i < 3; ++i) {
+    std::unique_ptr<Task> task = queue.Steal();
+    ASSERT_NE(nullptr, task);
+    EXPECT_EQ(i, IndexOf(task));
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+  EXPECT_EQ(nullptr, queue.Steal());
+}
+
+TEST(SharedWorkStealingQueueTest, Full) {
+  SharedWorkStealingQueue queue;
+  for (size_t i = 0; i < SharedWorkStealingQueue::kCapacity; ++i) {
+    std::unique_ptr<Task> task = std::make_unique<IndexTask>(i);
+    EXPECT_TRUE(queue.TryPush(task));
+  }
+  // A task that doesn't fit is left with the caller.
+  std::unique_ptr<Task> task =
+      std::make_unique<IndexTask>(SharedWorkStealingQueue::kCapacity);
+  EXPECT_FALSE(queue.TryPush(task));
+  ASSERT_NE(nullptr, task);
+  // Stealing frees up a slot, which is reused in order.
+  EXPECT_EQ(0u, IndexOf(queue.Steal()));
+  EXPECT_TRUE(queue.TryPush(task));
+  for (size_t i = 1; i <= SharedWorkStealingQueue::kCapacity; ++i) {
+    EXPECT_EQ(i, IndexOf(queue.Steal()));
+  }
+  EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(SharedWorkStealingQueueTest, DeletesRemainingTasks) {
+  SharedWorkStealingQueue queue;
+  std::unique_ptr<Task> task = std::make_unique<IndexTask>(0);
+  EXPECT_TRUE(queue.TryPush(task));
+  // Destroying the queue must not leak the task, which LSan checks.
+}
+
+namespace {
+
+class PushingThread final : public base::Thread {
+ public:
+  PushingThread(SharedWorkStealingQueue* queue, size_t first, size_t count,
+                std::vector<int>* runs)
+      : Thread(Options("libplatform PushingThread")),
+        queue_(queue),
+        first_(first),
+        count_(count),
+        runs_(runs) {}
+
+  void Run() override {
+    for (size_t i = first_; i < first_ + count_; ++i) {
+      std::unique_ptr<Task> task = std::make_unique<IndexTask>(i);
+      // Take a task whenever the queue is full so that pushing progresses.
+      while (!queue_->TryPush(task)) {
+        if (std::unique_ptr<Task> stolen = queue_->Steal()) {
+          (*runs_)[IndexOf(stolen)]++;
+        }
+      }
+    }
+  }
+
+ private:
+  SharedWorkStealingQueue* queue_;
+  const size_t first_;
+  const size_t count_;
+  std::vector<int>* runs_;
+};
+
+}  // namespace
+
+TEST(SharedWorkStealingQueueTest, ConcurrentPushAndSteal) {
+  static constexpr size_t kNumThreads = 4;
+  static constexpr size_t kNumTasksPerThread = 16 * 1024;
+  static constexpr size_t kNumTasks = kNumThreads * kNumTasksPerThread;
+  SharedWorkStealingQueue queue;
+  std::vector<std::vector<int>> runs(2 * kNumThreads + 1,
+                                     std::vector<int>(kNumTasks, 0));
+  std::vector<std::unique_ptr<PushingThread>> pushing_threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    pushing_threads.push_back(std::make_unique<PushingThread>(
+        &queue, i * kNumTasksPerThread, kNumTasksPerThread, &runs[i]));
+    ASSERT_TRUE(pushing_threads.back()->Start());
+  }
+  std::atomic<bool> done{false};
+  std::vector<std::unique_ptr<StealingThread<SharedWorkStealingQueue>>>
+      stealing_threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    stealing_threads.push_back(
+        std::make_unique<StealingThread<SharedWorkStealingQueue>>(
+            &queue, &runs[kNumThreads + i], &done));
+    ASSERT_TRUE(stealing_threads.back()->Start());
+  }
+  for (auto& thread : pushing_threads) {
+    thread->Join();
+  }
+  done.store(true, std::memory_order_release);
+  for (auto& thread : stealing_threads) {
+    thread->Join();
+  }
+  while (std::unique_ptr<Task> task = queue.Steal()) {
+    runs[2 * kNumThreads][IndexOf(task)]++;
+  }
+  // Every task was taken exactly once.
+  for (size_t i = 0; i < kNumTasks; ++i) {
+    int total = 0;
+    for (const std::vector<int>& thread_runs : runs) total += thread_runs[i];
+    EXPECT_EQ(1, total);
+  }
+}
+
+}  // namespace work_stealing_queue_unittest
+}  // namespace platform
+}  // namespace v8
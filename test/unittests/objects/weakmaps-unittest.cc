@@ -31,9 +31,11 @@
 #include "src/handles/global-handles-inl.h"
 #include "src/heap/factory.h"
 #include "src/heap/heap-inl.h"
+#include "src/heap/mutable-page-metadata.h"
 #include "src/objects/hash-table-inl.h"
 #include "src/objects/js-collection-inl.h"
 #include "src/objects/objects-inl.h"
+#include "test/common/flag-utils.h"
 #include "test/unittests/heap/heap-utils.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -250,6 +252,55 @@ TEST_F(WeakMapsTest, WeakMapScavenge) {
       Cast<EphemeronHashTable>(weakmap->table()), *object));
 }
 
+TEST_F(WeakMapsTest, LargeWeakMapWithOldToNewCardMarking) {
+  if (i::v8_flags.single_generation) return;
+  if (i::v8_flags.stress_incremental_marking) return;
+  FlagScope<bool> card_marking(&v8_flags.old_to_new_card_marking, true);
+  Isolate* isolate = i_isolate();
+  ManualGCScope manual_gc_scope(isolate);
+  Factory* factory = isolate->factory();
+  Heap* heap = isolate->heap();
+  HandleScope scope(isolate);
+
+  // Large plain arrays record their old-to-new slots in a card table.
+  DirectHandle<FixedArray> array = factory->NewFixedArray(
+      FixedArray::kMaxRegularLength + 1, AllocationType::kOld);
+  CHECK(heap->lo_space()->Contains(*array));
+  CHECK_NOT_NULL(
+      Heap::OldToNewCardTableFor(MutablePageMetadata::FromHeapObject(*array)));
+
+  // Large ephemeron tables must not, as dirty cards would turn their keys into
+  // strong OLD_TO_NEW slots.
+  DirectHandle<JSWeakMap> weakmap = factory->NewJSWeakMap();
+  DirectHandle<EphemeronHashTable> table = EphemeronHashTable::New(
+      isolate, FixedArray::kMaxRegularLength, AllocationType::kOld);
+  CHECK(heap->lo_space()->Contains(*table));
+  CHECK_NULL(
+      Heap::OldToNewCardTableFor(MutablePageMetadata::FromHeapObject(*table)));
+  weakmap->set_table(*table);
+
+  {
+    HandleScope inner_scope(isolate);
+    DirectHandle<Map> map = factory->NewContextfulMapForCurrentContext(
+        JS_OBJECT_TYPE, JSObject::kHeaderSize);
+    Handle<JSObject> object = factory->NewJSObjectFromMap(map);
+    CHECK(ObjectInYoungGeneration(*object));
+    Handle<JSObject> value = factory->NewJSObjectFromMap(map);
+    int32_t object_hash = Object::GetOrCreateHash(*object, isolate).value();
+    JSWeakCollection::Set(weakmap, object, value, object_hash);
+  }
+  CHECK_EQ(*table, weakmap->table());
+  CHECK_EQ(1, table->NumberOfElements());
+
+  if (v8_flags.minor_ms) return;
+  // The young key is only reachable through the weak map and dies.
+  {
+    DisableConservativeStackScanningScopeForTesting no_stack_scanning(heap);
+    InvokeAtomicMinorGC();
+  }
+  CHECK_EQ(0, Cast<EphemeronHashTable>(weakmap->table())->NumberOfElements());
+}
+
 // Test that weak map values on an evacuation candidate which are not reachable
 // by other paths are correctly recorded in the slots buffer.
 TEST_F(WeakMapsTest, Regress2060a) {
@@ -0,0 +1,81 @@
+// Copyright 2024 the V8 project authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "src/strings/string-hasher.h"
+
+#include <string>
+
+#include "src/objects/string.h"
+#include "src/strings/string-hasher-inl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace v8 {
+namespace internal {
+
+namespace {
+
+constexpr uint64_t kSeed = 0x1234567890abcdef;
+
+std::string MakeString(int length) {
+  std::string result;
+  for (int i = 0; i < length; i++) result += static_cast<char>('a' + i % 26);
+  return result;
+}
+
+uint32_t HashOneByte(const std::string& string, uint64_t seed = kSeed) {
+  return StringHasher::HashSequentialString(
+      string.data(), static_cast<int>(string.size()), seed);
+}
+
+uint32_t HashTwoByte(const std::string& string, uint64_t seed = kSeed) {
+  // Widen through uint8_t as char may be signed.
+  std::u16string two_byte;
+  for (char c : string) {
+    two_byte.push_back(static_cast<char16_t>(static_cast<uint8_t>(c)));
+  }
+  return StringHasher::HashSequentialString(
+      reinterpret_cast<const uint16_t*>(two_byte.data()),
+      static_cast<int>(two_byte.size()), seed);
+}
+
+}  // namespace
+
+TEST(StringHasherTest, OneAndTwoByteStringsHashTheSame) {
+  for (int length = 0; length < 4 * StringHasher::kMinBlockHashLength;
+       length++) {
+    std::string string = MakeString(length);
+    EXPECT_EQ(HashOneByte(string), HashTwoByte(string)) << length;
+  }
+  // Latin1 characters above 0x7F.
+  std::string latin1(100, '\xE4');
+  EXPECT_EQ(HashOneByte(latin1), HashTwoByte(latin1));
+}
+
+TEST(StringHasherTest, BlockHashDependsOnAllCharactersAndSeed) {
+  for (int length : {StringHasher::kMinBlockHashLength, 33, 47, 48, 49, 100}) {
+    std::string string = MakeString(length);
+    uint32_t hash = HashOneByte(string);
+    EXPECT_TRUE(String::IsHash(hash));
+    EXPECT_NE(0u, Name::HashBits::decode(hash));
+    EXPECT_NE(hash, HashOneByte(string, kSeed + 1));
+    for (int i = 0; i < length; i++) {
+      std::string changed = string;
+      changed[i] = '0';
+      EXPECT_NE(hash, HashOneByte(changed)) << length << " " << i;
+    }
+  }
+}
+
+TEST(StringHasherTest, IndexAndLongStringHashes) {
+  EXPECT_EQ(StringHasher::MakeArrayIndexHash(12345, 5),
+            HashOneByte("12345"));
+  EXPECT_EQ(StringHasher::MakeArrayIndexHash(12345, 5),
+            HashTwoByte("12345"));
+  std::string long_string = MakeString(String::kMaxHashCalcLength + 1);
+  EXPECT_EQ(StringHasher::GetTrivialHash(String::kMaxHashCalcLength + 1),
+            HashOneByte(long_string));
+}
+
+}  // namespace internal
+}  // namespace v8
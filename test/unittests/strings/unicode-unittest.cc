@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -10,6 +11,7 @@
 #include "src/base/vector.h"
 #include "src/strings/unicode-decoder.h"
 #include "src/strings/unicode-inl.h"
+#include "src/strings/unicode-simd.h"
 #include "test/unittests/heap/heap-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -495,6 +497,161 @@ TEST(UnicodeTest, IncrementalUTF8DecodingVsNonIncrementalUtf8Decoding) {
   }
 }
 
+TEST(UnicodeTest, AsciiPrefixLength) {
+  // Cover the word and block loops as well as their tails, at all alignments.
+  constexpr size_t kMaxLength = 200;
+  std::vector<uint8_t> one_byte(kMaxLength + 8, 'a');
+  std::vector<uint16_t> two_byte(kMaxLength + 8, 'a');
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 0; length <= kMaxLength; length++) {
+      const uint8_t* one_byte_chars = one_byte.data() + offset;
+      const uint16_t* two_byte_chars = two_byte.data() + offset;
+      CHECK_EQ(length, AsciiPrefixLength(one_byte_chars, length));
+      CHECK_EQ(length, AsciiPrefixLength(two_byte_chars, length));
+      for (size_t position = 0; position < length; position++) {
+        one_byte[offset + position] = 0x80;
+        two_byte[offset + position] = 0x100;
+        CHECK_EQ(position, AsciiPrefixLength(one_byte_chars, length));
+        CHECK_EQ(position, AsciiPrefixLength(two_byte_chars, length));
+        one_byte[offset + position] = 0xFF;
+        two_byte[offset + position] = 0x80;
+        CHECK_EQ(position, AsciiPrefixLength(one_byte_chars, length));
+        CHECK_EQ(position, AsciiPrefixLength(two_byte_chars, length));
+        one_byte[offset + position] = 0x7F;
+        two_byte[offset + position] = 0x7F;
+        CHECK_EQ(length, AsciiPrefixLength(one_byte_chars, length));
+        CHECK_EQ(length, AsciiPrefixLength(two_byte_chars, length));
+        one_byte[offset + position] = 'a';
+        two_byte[offset + position] = 'a';
+      }
+    }
+  }
+}
+
+TEST(UnicodeTest, Utf8DecodingWithAsciiRuns) {
+  // Long ASCII runs are copied in bulk, make sure that the characters around
+  // them are still decoded properly, including invalid sequences.
+  std::vector<std::vector<uint8_t>> fragments = {
+      {0xC3, 0xA9},              // U+00E9
+      {0xE2, 0x98, 0x83},        // U+2603
+      {0xF0, 0x9F, 0x98, 0x8D},  // U+1F60D
+      {0xE2, 0x98},              // Truncated sequence.
+      {0xFF},                    // Invalid byte.
+  };
+  for (const std::vector<uint8_t>& fragment : fragments) {
+    for (size_t run : {1, 15, 16, 17, 63, 64, 65, 100}) {
+      std::vector<uint8_t> bytes;
+      for (int i = 0; i < 3; i++) {
+        bytes.insert(bytes.end(), run, 'x');
+        bytes.insert(bytes.end(), fragment.begin(), fragment.end());
+      }
+
+      std::vector<unibrow::uchar> output_normal;
+      DecodeNormally(bytes, &output_normal);
+      std::vector<unibrow::uchar> output_utf16;
+      DecodeUtf16(bytes, &output_utf16);
+      CHECK_EQ(output_normal.size(), output_utf16.size());
+      for (size_t i = 0; i < output_normal.size(); ++i) {
+        CHECK_EQ(output_normal[i], output_utf16[i]);
+      }
+
+      auto utf8_data = base::Vector<const uint8_t>::cast(base::VectorOf(bytes));
+      Utf8Decoder decoder(utf8_data);
+      CHECK_EQ(std::all_of(output_normal.begin(), output_normal.end(),
+                           [](unibrow::uchar c) { return c <= 0xFF; }),
+               decoder.is_one_byte());
+      if (decoder.is_one_byte()) {
+        std::vector<uint8_t> latin1(decoder.utf16_length());
+        decoder.Decode(latin1.data(), utf8_data);
+        CHECK_EQ(output_normal.size(), latin1.size());
+        for (size_t i = 0; i < latin1.size(); ++i) {
+          CHECK_EQ(output_normal[i], latin1[i]);
+        }
+      }
+    }
+  }
+}
+
+TEST(UnicodeTest, EncodeUtf8) {
+  // Mix ASCII runs of various lengths with Latin1 characters, BMP characters,
+  // surrogate pairs and lone surrogates.
+  std::vector<uint16_t> two_byte;
+  const std::vector<uint16_t> kSpecial[] = {
+      {0xE9}, {0x2603}, {0xD83D, 0xDE0D}, {0xDE0D}, {0xD83D}, {0xD83D, 0xD83D}};
+  for (size_t i = 0; i < 40; i++) {
+    two_byte.insert(two_byte.end(), (i * 7) % 41,
+                    static_cast<uint16_t>('a' + i % 26));
+    const std::vector<uint16_t>& special = kSpecial[i % arraysize(kSpecial)];
+    two_byte.insert(two_byte.end(), special.begin(), special.end());
+  }
+
+  for (bool replace_invalid : {false, true}) {
+    std::string expected;
+    int previous = unibrow::Utf16::kNoPreviousCharacter;
+    char buffer[unibrow::Utf8::kMaxEncodedSize];
+    for (uint16_t c : two_byte) {
+      if (unibrow::Utf16::IsSurrogatePair(previous, c)) {
+        // Undo the encoding of the lead surrogate and encode the pair.
+        expected.resize(expected.size() -
+                        unibrow::Utf8::kSizeOfUnmatchedSurrogate);
+        size_t size = unibrow::Utf8::Encode(
+            buffer, unibrow::Utf16::CombineSurrogatePair(previous, c),
+            unibrow::Utf16::kNoPreviousCharacter, replace_invalid);
+        expected.append(buffer, size);
+      } else {
+        size_t size = unibrow::Utf8::Encode(
+            buffer, c, unibrow::Utf16::kNoPreviousCharacter, replace_invalid);
+        expected.append(buffer, size);
+      }
+      previous = c;
+    }
+
+    base::Vector<const uint16_t> chars = base::VectorOf(two_byte);
+    CHECK_EQ(expected.size(), Utf8Length(chars));
+    std::string actual(unibrow::Utf8::kMax16BitCodeUnitSize * chars.size(),
+                       '\0');
+    previous = unibrow::Utf16::kNoPreviousCharacter;
+    char* end = EncodeUtf8(chars, actual.data(), replace_invalid, &previous);
+    actual.resize(end - actual.data());
+    CHECK_EQ(expected, actual);
+    CHECK_EQ(static_cast<int>(two_byte.back()), previous);
+
+    // Encoding in two halves that split a surrogate pair gives the same
+    // result.
+    size_t split = 0;
+    while (!unibrow::Utf16::IsLeadSurrogate(two_byte[split])) split++;
+    split++;
+    std::string split_actual(actual.size() + unibrow::Utf8::kMaxEncodedSize,
+                             '\0');
+    previous = unibrow::Utf16::kNoPreviousCharacter;
+    end = EncodeUtf8(chars.SubVector(0, split), split_actual.data(),
+                     replace_invalid, &previous);
+    end = EncodeUtf8(chars.SubVector(split, chars.size()), end,
+                     replace_invalid, &previous);
+    split_actual.resize(end - split_actual.data());
+    CHECK_EQ(expected, split_actual);
+  }
+
+  std::vector<uint8_t> one_byte;
+  for (size_t i = 0; i < 40; i++) {
+    one_byte.insert(one_byte.end(), (i * 7) % 41,
+                    static_cast<uint8_t>('a' + i % 26));
+    one_byte.push_back(static_cast<uint8_t>(0x80 + i));
+  }
+  std::string expected;
+  for (uint8_t c : one_byte) {
+    char buffer[unibrow::Utf8::kMax8BitCodeUnitSize];
+    expected.append(buffer, unibrow::Utf8::EncodeOneByte(buffer, c));
+  }
+  base::Vector<const uint8_t> chars = base::VectorOf(one_byte);
+  CHECK_EQ(expected.size(), Utf8Length(chars));
+  std::string actual(unibrow::Utf8::kMax8BitCodeUnitSize * chars.size(), '\0');
+  int previous = unibrow::Utf16::kNoPreviousCharacter;
+  char* end = EncodeUtf8(chars, actual.data(), false, &previous);
+  actual.resize(end - actual.data());
+  CHECK_EQ(expected, actual);
+}
+
 class UnicodeWithGCTest : public TestWithHeapInternals {};
 
 #define GC_INSIDE_NEW_STRING_FROM_UTF8_SUB_STRING(NAME, STRING)               \
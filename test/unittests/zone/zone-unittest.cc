@@ -4,7 +4,9 @@
 
 #include "src/zone/zone.h"
 
+#include "src/base/platform/platform.h"
 #include "src/zone/accounting-allocator.h"
+#include "test/common/flag-utils.h"
 #include "test/unittests/test-utils.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
@@ -25,5 +27,95 @@ TEST_F(ZoneTest, 8ByteAlignment) {
   }
 }
 
+TEST_F(ZoneTest, SegmentCacheReusesSegments) {
+  FlagScope<bool> segment_cache(&v8_flags.zone_segment_cache, true);
+  AccountingAllocator::ReleaseCachedSegments();
+  AccountingAllocator allocator;
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+  }
+  EXPECT_EQ(0u, allocator.GetSegmentCacheHits());
+  EXPECT_EQ(1u, allocator.GetSegmentCacheMisses());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+    EXPECT_LT(0u, allocator.GetCurrentMemoryUsage());
+  }
+  EXPECT_EQ(1u, allocator.GetSegmentCacheHits());
+  EXPECT_EQ(1u, allocator.GetSegmentCacheMisses());
+  EXPECT_EQ(0u, allocator.GetCurrentMemoryUsage());
+}
+
+TEST_F(ZoneTest, SegmentCacheReleasesSegments) {
+  FlagScope<bool> segment_cache(&v8_flags.zone_segment_cache, true);
+  AccountingAllocator::ReleaseCachedSegments();
+  AccountingAllocator allocator;
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+  }
+  AccountingAllocator::ReleaseCachedSegments();
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+  }
+  EXPECT_EQ(0u, allocator.GetSegmentCacheHits());
+  EXPECT_EQ(2u, allocator.GetSegmentCacheMisses());
+}
+
+TEST_F(ZoneTest, SegmentCacheDoesNotRoundUpSegments) {
+  FlagScope<bool> segment_cache(&v8_flags.zone_segment_cache, true);
+  AccountingAllocator::ReleaseCachedSegments();
+  AccountingAllocator allocator;
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+    // The second segment is larger than the minimum segment size but smaller
+    // than the maximum segment size and is not served from the cache.
+    zone.Allocate<ZoneTestTag>(4 * KB);
+    zone.Allocate<ZoneTestTag>(4 * KB);
+    EXPECT_LT(allocator.GetCurrentMemoryUsage(), 40 * KB);
+  }
+  EXPECT_EQ(0u, allocator.GetSegmentCacheHits());
+  EXPECT_EQ(1u, allocator.GetSegmentCacheMisses());
+}
+
+namespace {
+
+class ZoneThread final : public base::Thread {
+ public:
+  explicit ZoneThread(AccountingAllocator* allocator)
+      : base::Thread(base::Thread::Options("ZoneThread")),
+        allocator_(allocator) {}
+
+  void Run() override {
+    Zone zone(allocator_, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+  }
+
+ private:
+  AccountingAllocator* const allocator_;
+};
+
+}  // namespace
+
+TEST_F(ZoneTest, SegmentCacheSharesSegmentsBetweenThreads) {
+  FlagScope<bool> segment_cache(&v8_flags.zone_segment_cache, true);
+  AccountingAllocator::ReleaseCachedSegments();
+  AccountingAllocator allocator;
+  ZoneThread thread(&allocator);
+  ASSERT_TRUE(thread.Start());
+  thread.Join();
+  EXPECT_EQ(1u, allocator.GetSegmentCacheMisses());
+  {
+    Zone zone(&allocator, ZONE_NAME);
+    zone.Allocate<ZoneTestTag>(16);
+  }
+  EXPECT_EQ(1u, allocator.GetSegmentCacheHits());
+  EXPECT_EQ(1u, allocator.GetSegmentCacheMisses());
+}
+
 }  // namespace internal
 }  // namespace v8
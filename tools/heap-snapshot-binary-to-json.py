@@ -0,0 +1,154 @@
+#!/usr/bin/python3
+# Copyright 2024 the V8 project authors. All rights reserved.
+# Use of this source code is governed by a BSD-style license that can be
+# found in the LICENSE file.
+"""Converts a heap snapshot in the binary format (v8::HeapSnapshot::kBinary,
+or --heap-snapshot-binary) to the JSON format that DevTools loads.
+
+The input is read and the output is written as a stream, so that the
+conversion of large snapshots does not need much memory.
+
+Usage: python3 heap-snapshot-binary-to-json.py in.heapsnapshot.bin \\
+           [out.heapsnapshot]
+"""
+
+import json
+import sys
+
+MAGIC = b'V8HS'
+VERSION = 1
+NODE_FIELD_COUNT = 7
+
+# Keep in sync with HeapSnapshotJSONSerializer::SerializeSnapshot.
+META = {
+    'node_fields': [
+        'type', 'name', 'id', 'self_size', 'edge_count', 'trace_node_id',
+        'detachedness'
+    ],
+    'node_types': [[
+        'hidden', 'array', 'string', 'object', 'code', 'closure', 'regexp',
+        'number', 'native', 'synthetic', 'concatenated string',
+        'sliced string', 'symbol', 'bigint', 'object shape'
+    ], 'string', 'number', 'number', 'number', 'number', 'number'],
+    'edge_fields': ['type', 'name_or_index', 'to_node'],
+    'edge_types': [[
+        'context', 'element', 'property', 'internal', 'hidden', 'shortcut',
+        'weak'
+    ], 'string_or_number', 'node'],
+    'trace_function_info_fields': [
+        'function_id', 'name', 'script_name', 'script_id', 'line', 'column'
+    ],
+    'trace_node_fields': [
+        'id', 'function_info_index', 'count', 'size', 'children'
+    ],
+    'sample_fields': ['timestamp_us', 'last_assigned_id'],
+    'location_fields': ['object_index', 'script_id', 'line', 'column']
+}
+
+
+class Reader:
+
+  def __init__(self, f):
+    self.f = f
+
+  def read_bytes(self, length):
+    data = self.f.read(length)
+    if len(data) != length:
+      raise ValueError('Unexpected end of input')
+    return data
+
+  def read_varint(self):
+    result = 0
+    shift = 0
+    while True:
+      byte = self.read_bytes(1)[0]
+      result |= (byte & 0x7F) << shift
+      if byte < 0x80:
+        return result
+      shift += 7
+
+
+def zigzag_decode(value):
+  return (value >> 1) ^ -(value & 1)
+
+
+def write_array(out, count, read_record):
+  for i in range(count):
+    if i > 0:
+      out.write(',')
+    out.write(','.join(str(field) for field in read_record()))
+    out.write('\n')
+
+
+def convert(reader, out):
+  if reader.read_bytes(len(MAGIC)) != MAGIC:
+    raise ValueError('Not a binary heap snapshot')
+  version = reader.read_bytes(1)[0]
+  if version != VERSION:
+    raise ValueError('Unsupported version %d' % version)
+  node_count = reader.read_varint()
+  edge_count = reader.read_varint()
+  sample_count = reader.read_varint()
+  location_count = reader.read_varint()
+
+  out.write('{"snapshot":{"meta":')
+  out.write(json.dumps(META, separators=(',', ':')))
+  out.write(',"node_count":%d,"edge_count":%d,"trace_function_count":0},\n' %
+            (node_count, edge_count))
+
+  previous_id = 0
+
+  def read_node():
+    nonlocal previous_id
+    node_type = reader.read_varint()
+    name = reader.read_varint()
+    previous_id += zigzag_decode(reader.read_varint())
+    return [node_type, name, previous_id] + [
+        reader.read_varint() for _ in range(NODE_FIELD_COUNT - 3)
+    ]
+
+  def read_edge():
+    edge_type = reader.read_varint()
+    name_or_index = reader.read_varint()
+    return [edge_type, name_or_index, reader.read_varint() * NODE_FIELD_COUNT]
+
+  def read_sample():
+    return [reader.read_varint(), reader.read_varint()]
+
+  def read_location():
+    node = reader.read_varint()
+    return [node * NODE_FIELD_COUNT] + [reader.read_varint() for _ in range(3)]
+
+  out.write('"nodes":[')
+  write_array(out, node_count, read_node)
+  out.write('],\n"edges":[')
+  write_array(out, edge_count, read_edge)
+  # Allocation traces are not part of the binary format.
+  out.write('],\n"trace_function_infos":[],\n"trace_tree":[],\n"samples":[')
+  write_array(out, sample_count, read_sample)
+  out.write('],\n"locations":[')
+  write_array(out, location_count, read_location)
+  out.write('],\n"strings":["<dummy>"')
+  for _ in range(reader.read_varint()):
+    string = reader.read_bytes(reader.read_varint())
+    out.write(',\n')
+    out.write(json.dumps(string.decode('utf-8', errors='replace')))
+  out.write(']}')
+
+
+def main():
+  if len(sys.argv) not in (2, 3):
+    print('Usage: python3 heap-snapshot-binary-to-json.py '
+          'in.heapsnapshot.bin [out.heapsnapshot]')
+    exit(1)
+
+  with open(sys.argv[1], 'rb') as f:
+    if len(sys.argv) == 3:
+      with open(sys.argv[2], 'w') as out:
+        convert(Reader(f), out)
+    else:
+      convert(Reader(f), sys.stdout)
+
+
+if __name__ == '__main__':
+  main()